@@ -15,6 +15,9 @@
 #ifdef VTUNE_PROFILING
 #include "Base/VTuneChakraProfile.h"
 #endif
+#ifdef PERF_JIT_PROFILING
+#include "Base/PerfChakraProfile.h"
+#endif
 
 #ifdef __APPLE__
 // dummy usage of JSRT to force export JSRT on dylib
@@ -111,6 +114,9 @@ static void DetachProcess()
     // other dlls.
     JsrtRuntime::Uninitialize();
 
+    // All thread contexts are gone; return the arena page segments they left in the cache
+    PageSegmentCache::Instance.ReleaseAll();
+
     // thread-bound entrypoint should be able to get cleanup correctly, however tlsentry
     // for current thread might be left behind if this thread was initialized.
     ThreadContextTLSEntry::CleanupThread();
@@ -175,6 +181,9 @@ EXTERN_C BOOL WINAPI DllMain(HINSTANCE hmod, DWORD dwReason, PVOID pvReserved)
 #ifdef VTUNE_PROFILING
         VTuneChakraProfile::UnRegister();
 #endif
+#ifdef PERF_JIT_PROFILING
+        PerfChakraProfile::UnRegister();
+#endif
 
         // don't do anything if we are in forceful shutdown
         // try to clean up handles in graceful shutdown
@@ -5,6 +5,7 @@
 #include "stdafx.h"
 #include "catch.hpp"
 #include <process.h>
+#include <string>
 
 #pragma warning(disable:4100) // unreferenced formal parameter
 #pragma warning(disable:6387) // suppressing preFAST which raises warning for passing null to the JsRT APIs
@@ -1613,4 +1614,468 @@ namespace JsRTApiTest
     {
         JsRTApiTest::RunWithAttributes(JsRTApiTest::ScriptTerminationTest);
     }
+
+    void CompactHeapTest(JsRuntimeAttributes attributes, JsRuntimeHandle runtime)
+    {
+        CHECK(JsCompactHeap(JS_INVALID_RUNTIME_HANDLE) == JsErrorInvalidArgument);
+
+        // Leave most of the objects as garbage, so that their pages are sparsely used
+        JsValueRef result = JS_INVALID_REFERENCE;
+        REQUIRE(JsRunScript(
+            _u("var survivors = [];")
+            _u("for (var i = 0; i < 100000; i++) {")
+            _u("    var o = { value: i };")
+            _u("    if (i % 100 == 0) survivors.push(o);")
+            _u("}"), JS_SOURCE_CONTEXT_NONE, _u(""), &result) == JsNoError);
+
+        size_t usageBefore = 0;
+        REQUIRE(JsGetRuntimeMemoryUsage(runtime, &usageBefore) == JsNoError);
+        REQUIRE(JsCompactHeap(runtime) == JsNoError);
+        REQUIRE(JsCompactHeap(runtime) == JsNoError);
+
+        size_t usageAfter = 0;
+        REQUIRE(JsGetRuntimeMemoryUsage(runtime, &usageAfter) == JsNoError);
+        CHECK(usageAfter <= usageBefore);
+
+        // Objects aren't moved, the survivors are intact and new objects are allocated among them
+        int sum = 0;
+        REQUIRE(JsRunScript(
+            _u("for (var i = 0; i < 1000; i++) survivors.push({ value: 0 });")
+            _u("survivors.reduce(function (sum, o) { return sum + o.value; }, 0)"), JS_SOURCE_CONTEXT_NONE, _u(""), &result) == JsNoError);
+        REQUIRE(JsNumberToInt(result, &sum) == JsNoError);
+        CHECK(sum == 49950000);
+
+        // Collecting doesn't run script, it is allowed while execution is disabled
+        if (attributes & JsRuntimeAttributeAllowScriptInterrupt)
+        {
+            REQUIRE(JsDisableRuntimeExecution(runtime) == JsNoError);
+            CHECK(JsCompactHeap(runtime) == JsNoError);
+            REQUIRE(JsEnableRuntimeExecution(runtime) == JsNoError);
+        }
+    }
+
+    TEST_CASE("ApiTest_CompactHeapTest", "[ApiTest]")
+    {
+        JsRTApiTest::RunWithAttributes(JsRTApiTest::CompactHeapTest);
+    }
+
+    void ContextAllocatedBytesTest(JsRuntimeAttributes attributes, JsRuntimeHandle runtime)
+    {
+        JsContextRef context = JS_INVALID_REFERENCE;
+        REQUIRE(JsGetCurrentContext(&context) == JsNoError);
+
+        size_t allocatedBytes = 0;
+        size_t arenaBytes = 0;
+        CHECK(JsGetContextAllocatedBytes(JS_INVALID_REFERENCE, &allocatedBytes, &arenaBytes) == JsErrorInvalidArgument);
+        CHECK(JsGetContextAllocatedBytes(context, nullptr, &arenaBytes) == JsErrorNullArgument);
+        CHECK(JsGetContextAllocatedBytes(context, &allocatedBytes, nullptr) == JsErrorNullArgument);
+        CHECK(JsGetContextAllocatedBytes(GetUndefined(), &allocatedBytes, &arenaBytes) == JsErrorInvalidArgument);
+
+        JsContextRef otherContext = JS_INVALID_REFERENCE;
+        REQUIRE(JsCreateContext(runtime, &otherContext) == JsNoError);
+
+        size_t allocatedBytesBefore = 0;
+        size_t otherAllocatedBytesBefore = 0;
+        REQUIRE(JsGetContextAllocatedBytes(context, &allocatedBytesBefore, &arenaBytes) == JsNoError);
+        REQUIRE(JsGetContextAllocatedBytes(otherContext, &otherAllocatedBytesBefore, &arenaBytes) == JsNoError);
+        CHECK(arenaBytes > 0);
+
+        // Enough allocations to fill several heap blocks, all charged to the current context
+        JsValueRef result = JS_INVALID_REFERENCE;
+        REQUIRE(JsRunScript(_u("var a = []; for (var i = 0; i < 100000; i++) a.push({ value: i });"), JS_SOURCE_CONTEXT_NONE, _u(""), &result) == JsNoError);
+
+        size_t otherAllocatedBytes = 0;
+        REQUIRE(JsGetContextAllocatedBytes(context, &allocatedBytes, &arenaBytes) == JsNoError);
+        REQUIRE(JsGetContextAllocatedBytes(otherContext, &otherAllocatedBytes, &arenaBytes) == JsNoError);
+        CHECK(allocatedBytes >= allocatedBytesBefore + 100000 * sizeof(void *));
+        CHECK(otherAllocatedBytes == otherAllocatedBytesBefore);
+
+        // It is an allocation counter, a collection doesn't take the freed objects away
+        REQUIRE(JsRunScript(_u("a = null;"), JS_SOURCE_CONTEXT_NONE, _u(""), &result) == JsNoError);
+        REQUIRE(JsCollectGarbage(runtime) == JsNoError);
+        size_t allocatedBytesAfterCollection = 0;
+        REQUIRE(JsGetContextAllocatedBytes(context, &allocatedBytesAfterCollection, &arenaBytes) == JsNoError);
+        CHECK(allocatedBytesAfterCollection >= allocatedBytes);
+
+        // Reading the counters doesn't run script, it is allowed while execution is disabled
+        if (attributes & JsRuntimeAttributeAllowScriptInterrupt)
+        {
+            REQUIRE(JsDisableRuntimeExecution(runtime) == JsNoError);
+            CHECK(JsGetContextAllocatedBytes(context, &allocatedBytes, &arenaBytes) == JsNoError);
+            REQUIRE(JsEnableRuntimeExecution(runtime) == JsNoError);
+        }
+    }
+
+    TEST_CASE("ApiTest_ContextAllocatedBytesTest", "[ApiTest]")
+    {
+        JsRTApiTest::RunWithAttributes(JsRTApiTest::ContextAllocatedBytesTest);
+    }
+
+    void RuntimeGCStatisticsTest(JsRuntimeAttributes attributes, JsRuntimeHandle runtime)
+    {
+        JsGCStatistics statistics;
+        CHECK(JsGetRuntimeGCStatistics(JS_INVALID_RUNTIME_HANDLE, &statistics) == JsErrorInvalidArgument);
+        CHECK(JsGetRuntimeGCStatistics(runtime, nullptr) == JsErrorNullArgument);
+
+        JsGCStatistics statisticsBefore;
+        REQUIRE(JsGetRuntimeGCStatistics(runtime, &statisticsBefore) == JsNoError);
+
+        JsValueRef result = JS_INVALID_REFERENCE;
+        REQUIRE(JsRunScript(_u("var a = []; for (var i = 0; i < 100000; i++) a.push({ value: i }); a = null;"), JS_SOURCE_CONTEXT_NONE, _u(""), &result) == JsNoError);
+        REQUIRE(JsCollectGarbage(runtime) == JsNoError);
+        REQUIRE(JsGetRuntimeGCStatistics(runtime, &statistics) == JsNoError);
+
+        CHECK(statistics.collectionCount > statisticsBefore.collectionCount);
+        CHECK(statistics.pauseCount > statisticsBefore.pauseCount);
+        CHECK(statistics.pauseTime >= statisticsBefore.pauseTime);
+        CHECK(statistics.maxPauseTime <= statistics.pauseTime);
+        CHECK(statistics.allocatedBytes > statisticsBefore.allocatedBytes);
+        CHECK(statistics.peakHeapSize >= statistics.heapSizeBeforeLastCollection);
+        CHECK(statistics.heapSizeAfterLastCollection <= statistics.heapSizeBeforeLastCollection);
+
+        unsigned int histogramCount = 0;
+        for (int i = 0; i < _countof(statistics.pauseHistogram); i++)
+        {
+            histogramCount += statistics.pauseHistogram[i];
+        }
+        CHECK(histogramCount == statistics.pauseCount);
+
+        // Reading the statistics doesn't run script, it is allowed while execution is disabled
+        if (attributes & JsRuntimeAttributeAllowScriptInterrupt)
+        {
+            REQUIRE(JsDisableRuntimeExecution(runtime) == JsNoError);
+            CHECK(JsGetRuntimeGCStatistics(runtime, &statistics) == JsNoError);
+            REQUIRE(JsEnableRuntimeExecution(runtime) == JsNoError);
+        }
+    }
+
+    TEST_CASE("ApiTest_RuntimeGCStatisticsTest", "[ApiTest]")
+    {
+        JsRTApiTest::RunWithAttributes(JsRTApiTest::RuntimeGCStatisticsTest);
+    }
+
+    void IdleWithDeadlineTest(JsRuntimeAttributes attributes, JsRuntimeHandle runtime)
+    {
+        JsContextRef context = JS_INVALID_REFERENCE;
+        REQUIRE(JsGetCurrentContext(&context) == JsNoError);
+
+        bool workPending = true;
+        REQUIRE(JsSetCurrentContext(nullptr) == JsNoError);
+        CHECK(JsIdleWithDeadline(10, &workPending) == JsErrorNoCurrentContext);
+        REQUIRE(JsSetCurrentContext(context) == JsNoError);
+
+        // workPending is optional
+        CHECK(JsIdleWithDeadline(0, nullptr) == JsNoError);
+
+        JsValueRef result = JS_INVALID_REFERENCE;
+        REQUIRE(JsRunScript(_u("var a = []; for (var i = 0; i < 200000; i++) a.push({ value: i }); a = null;"), JS_SOURCE_CONTEXT_NONE, _u(""), &result) == JsNoError);
+
+        // Each call makes progress, so the collection finishes within a bounded number of calls
+        int callCount = 0;
+        do
+        {
+            REQUIRE(JsIdleWithDeadline(100, &workPending) == JsNoError);
+        } while (workPending && ++callCount < 100);
+        CHECK(!workPending);
+
+        if (attributes & JsRuntimeAttributeDisableBackgroundWork)
+        {
+            // Nothing is collected in the background, so there is never work left for a later call
+            REQUIRE(JsIdleWithDeadline(100, &workPending) == JsNoError);
+            CHECK(!workPending);
+        }
+
+        // Script still runs normally after the idle time
+        int value = 0;
+        REQUIRE(JsRunScript(_u("[1, 2, 3].reduce(function (sum, x) { return sum + x; }, 0)"), JS_SOURCE_CONTEXT_NONE, _u(""), &result) == JsNoError);
+        REQUIRE(JsNumberToInt(result, &value) == JsNoError);
+        CHECK(value == 6);
+
+        if (attributes & JsRuntimeAttributeAllowScriptInterrupt)
+        {
+            REQUIRE(JsDisableRuntimeExecution(runtime) == JsNoError);
+            CHECK(JsIdleWithDeadline(10, &workPending) == JsErrorInDisabledState);
+            REQUIRE(JsEnableRuntimeExecution(runtime) == JsNoError);
+        }
+    }
+
+    TEST_CASE("ApiTest_IdleWithDeadlineTest", "[ApiTest]")
+    {
+        JsRTApiTest::RunWithAttributes(JsRTApiTest::IdleWithDeadlineTest);
+    }
+
+    void CHAKRA_CALLBACK HeapSnapshotWriteCallback(const char *chunk, size_t length, void *callbackState)
+    {
+        std::string * snapshot = (std::string *)callbackState;
+        snapshot->append(chunk, length);
+    }
+
+    void WriteHeapSnapshotTest(JsRuntimeAttributes attributes, JsRuntimeHandle runtime)
+    {
+        std::string snapshot;
+        CHECK(JsWriteHeapSnapshot(JS_INVALID_RUNTIME_HANDLE, HeapSnapshotWriteCallback, &snapshot) == JsErrorInvalidArgument);
+        CHECK(JsWriteHeapSnapshot(runtime, nullptr, &snapshot) == JsErrorNullArgument);
+        CHECK(snapshot.empty());
+
+        JsValueRef result = JS_INVALID_REFERENCE;
+        REQUIRE(JsRunScript(_u("var retained = { name: 'heapSnapshotMarker' };"), JS_SOURCE_CONTEXT_NONE, _u(""), &result) == JsNoError);
+        REQUIRE(JsWriteHeapSnapshot(runtime, HeapSnapshotWriteCallback, &snapshot) == JsNoError);
+
+        // A complete JSON document with the contents of the strings
+        REQUIRE(!snapshot.empty());
+        CHECK(snapshot.front() == '{');
+        CHECK(snapshot.find_last_not_of(" \r\n") == snapshot.find_last_of('}'));
+        CHECK(snapshot.find("\"snapshot\"") != std::string::npos);
+        CHECK(snapshot.find("\"nodes\"") != std::string::npos);
+        CHECK(snapshot.find("\"edges\"") != std::string::npos);
+        CHECK(snapshot.find("heapSnapshotMarker") != std::string::npos);
+
+        // Collection is enabled again afterwards
+        REQUIRE(JsCollectGarbage(runtime) == JsNoError);
+
+        // Writing the snapshot doesn't run script, it is allowed while execution is disabled
+        if (attributes & JsRuntimeAttributeAllowScriptInterrupt)
+        {
+            std::string disabledSnapshot;
+            REQUIRE(JsDisableRuntimeExecution(runtime) == JsNoError);
+            CHECK(JsWriteHeapSnapshot(runtime, HeapSnapshotWriteCallback, &disabledSnapshot) == JsNoError);
+            CHECK(!disabledSnapshot.empty());
+            REQUIRE(JsEnableRuntimeExecution(runtime) == JsNoError);
+        }
+    }
+
+    TEST_CASE("ApiTest_WriteHeapSnapshotTest", "[ApiTest]")
+    {
+        JsRTApiTest::RunWithAttributes(JsRTApiTest::WriteHeapSnapshotTest);
+    }
+
+    struct FinalizeCounts
+    {
+        volatile LONG count;
+        volatile LONG offThreadCount;
+        DWORD threadId;
+
+        void Reset()
+        {
+            count = 0;
+            offThreadCount = 0;
+            threadId = GetCurrentThreadId();
+        }
+    };
+
+    // Static, the callbacks of the objects still alive are called when the runtime is disposed
+    static FinalizeCounts threadSafeFinalizeCounts;
+    static FinalizeCounts inThreadFinalizeCounts;
+    static const int finalizeObjectCount = 100;
+
+    void CHAKRA_CALLBACK CountingFinalizeCallback(void *data)
+    {
+        FinalizeCounts * counts = (FinalizeCounts *)data;
+        InterlockedIncrement(&counts->count);
+        if (GetCurrentThreadId() != counts->threadId)
+        {
+            InterlockedIncrement(&counts->offThreadCount);
+        }
+    }
+
+    void CreateFinalizedObjects(FinalizeCounts * counts, JsFinalizeCallbackFlags flags)
+    {
+        for (int i = 0; i < finalizeObjectCount; i++)
+        {
+            JsValueRef object = JS_INVALID_REFERENCE;
+            REQUIRE(JsCreateExternalObjectWithFinalizeFlags(counts, CountingFinalizeCallback, flags, &object) == JsNoError);
+        }
+    }
+
+    void ExternalObjectFinalizeFlagsTest(JsRuntimeAttributes attributes, JsRuntimeHandle runtime)
+    {
+        JsContextRef context = JS_INVALID_REFERENCE;
+        REQUIRE(JsGetCurrentContext(&context) == JsNoError);
+
+        JsValueRef object = JS_INVALID_REFERENCE;
+        CHECK(JsCreateExternalObjectWithFinalizeFlags(nullptr, nullptr, JsFinalizeCallbackFlagNone, nullptr) == JsErrorNullArgument);
+        CHECK(JsCreateExternalObjectWithFinalizeFlags(nullptr, nullptr, (JsFinalizeCallbackFlags)0x2, &object) == JsErrorInvalidArgument);
+
+        REQUIRE(JsSetCurrentContext(nullptr) == JsNoError);
+        CHECK(JsCreateExternalObjectWithFinalizeFlags(nullptr, nullptr, JsFinalizeCallbackFlagThreadSafe, &object) == JsErrorNoCurrentContext);
+        REQUIRE(JsSetCurrentContext(context) == JsNoError);
+
+        if (attributes & JsRuntimeAttributeAllowScriptInterrupt)
+        {
+            REQUIRE(JsDisableRuntimeExecution(runtime) == JsNoError);
+            CHECK(JsCreateExternalObjectWithFinalizeFlags(nullptr, nullptr, JsFinalizeCallbackFlagThreadSafe, &object) == JsErrorInDisabledState);
+            REQUIRE(JsEnableRuntimeExecution(runtime) == JsNoError);
+        }
+
+        // Without JsRuntimeAttributeEnableBackgroundFinalization, thread-safe callbacks are called by the collection too
+        threadSafeFinalizeCounts.Reset();
+        CreateFinalizedObjects(&threadSafeFinalizeCounts, JsFinalizeCallbackFlagThreadSafe);
+        REQUIRE(JsCollectGarbage(runtime) == JsNoError);
+        CHECK(threadSafeFinalizeCounts.count > 0);
+        CHECK(threadSafeFinalizeCounts.offThreadCount == 0);
+    }
+
+    TEST_CASE("ApiTest_ExternalObjectFinalizeFlagsTest", "[ApiTest]")
+    {
+        JsRTApiTest::RunWithAttributes(JsRTApiTest::ExternalObjectFinalizeFlagsTest);
+    }
+
+    TEST_CASE("ApiTest_BackgroundFinalizationTest", "[ApiTest]")
+    {
+        JsRuntimeHandle runtime = JS_INVALID_RUNTIME_HANDLE;
+        REQUIRE(TestSetup(JsRuntimeAttributeEnableBackgroundFinalization, &runtime));
+
+        threadSafeFinalizeCounts.Reset();
+        inThreadFinalizeCounts.Reset();
+        CreateFinalizedObjects(&threadSafeFinalizeCounts, JsFinalizeCallbackFlagThreadSafe);
+        CreateFinalizedObjects(&inThreadFinalizeCounts, JsFinalizeCallbackFlagNone);
+        REQUIRE(JsCollectGarbage(runtime) == JsNoError);
+
+        // The thread-safe callbacks are called by a helper thread after the collection
+        for (int i = 0; i < 100 && threadSafeFinalizeCounts.count == 0; i++)
+        {
+            Sleep(50);
+        }
+        CHECK(threadSafeFinalizeCounts.offThreadCount > 0);
+        CHECK(inThreadFinalizeCounts.count > 0);
+        CHECK(inThreadFinalizeCounts.offThreadCount == 0);
+
+        // Disposing the runtime calls the callbacks that are left
+        TestCleanup(runtime);
+        CHECK(threadSafeFinalizeCounts.count == finalizeObjectCount);
+        CHECK(inThreadFinalizeCounts.count == finalizeObjectCount);
+        CHECK(inThreadFinalizeCounts.offThreadCount == 0);
+    }
+
+    int CountProfileCacheFiles(const std::string &directory, bool deleteFiles)
+    {
+        int fileCount = 0;
+        WIN32_FIND_DATAA findData;
+        HANDLE findHandle = FindFirstFileA((directory + "\\*").c_str(), &findData);
+        if (findHandle == INVALID_HANDLE_VALUE)
+        {
+            return 0;
+        }
+
+        do
+        {
+            if ((findData.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY) == 0)
+            {
+                fileCount++;
+                if (deleteFiles)
+                {
+                    DeleteFileA((directory + "\\" + findData.cFileName).c_str());
+                }
+            }
+        } while (FindNextFileA(findHandle, &findData));
+
+        FindClose(findHandle);
+        return fileCount;
+    }
+
+    void RunProfileCacheScript(JsRuntimeAttributes attributes, JsRuntimeHandle *runtime)
+    {
+        REQUIRE(TestSetup(attributes, runtime));
+
+        JsValueRef result = JS_INVALID_REFERENCE;
+        int sum = 0;
+        REQUIRE(JsRunScript(
+            _u("function increment(x) { return x + 1; }")
+            _u("var sum = 0;")
+            _u("for (var i = 0; i < 1000; i++) sum = increment(sum);")
+            _u("sum"), JS_SOURCE_CONTEXT_NONE, _u(""), &result) == JsNoError);
+        REQUIRE(JsNumberToInt(result, &sum) == JsNoError);
+        CHECK(sum == 1000);
+    }
+
+    // The cache is enabled for the rest of the process, so this test uses a directory of its own
+    TEST_CASE("ApiTest_DynamicProfileCacheDirectoryTest", "[ApiTest]")
+    {
+        CHECK(JsSetDynamicProfileCacheDirectory(nullptr) == JsErrorNullArgument);
+        CHECK(JsSetDynamicProfileCacheDirectory("") == JsErrorInvalidArgument);
+
+        char tempPath[MAX_PATH];
+        REQUIRE(GetTempPathA(MAX_PATH, tempPath) != 0);
+        std::string directory = std::string(tempPath) + "ChakraCoreNativeTestsProfileCache";
+        CountProfileCacheFiles(directory, true);
+
+        REQUIRE(JsSetDynamicProfileCacheDirectory(directory.c_str()) == JsNoError);
+        CHECK(JsSetDynamicProfileCacheDirectory(directory.c_str()) == JsNoError);
+        CHECK(JsSetDynamicProfileCacheDirectory((directory + "Other").c_str()) == JsErrorInvalidArgument);
+
+        // The profile is written when the context is released, which doesn't need script to run
+        JsRuntimeHandle runtime = JS_INVALID_RUNTIME_HANDLE;
+        RunProfileCacheScript(JsRuntimeAttributeAllowScriptInterrupt, &runtime);
+        JsValueRef result = JS_INVALID_REFERENCE;
+        REQUIRE(JsDisableRuntimeExecution(runtime) == JsNoError);
+        CHECK(JsRunScript(_u("sum"), JS_SOURCE_CONTEXT_NONE, _u(""), &result) == JsErrorInDisabledState);
+        TestCleanup(runtime);
+        CHECK(CountProfileCacheFiles(directory, false) > 0);
+
+        // The same source runs with the profile loaded from the cache
+        runtime = JS_INVALID_RUNTIME_HANDLE;
+        RunProfileCacheScript(JsRuntimeAttributeNone, &runtime);
+        TestCleanup(runtime);
+
+        CountProfileCacheFiles(directory, true);
+    }
+
+    int RunHotFunction(JsContextRef context, int iterationCount)
+    {
+        REQUIRE(JsSetCurrentContext(context) == JsNoError);
+
+        wchar_t script[256];
+        swprintf_s(script, _u("(function () { function square(x) { return x * x; } var sum = 0; for (var i = 0; i < %d; i++) sum = (sum + square(i)) | 0; return sum; })()"), iterationCount);
+
+        JsValueRef result = JS_INVALID_REFERENCE;
+        int sum = 0;
+        REQUIRE(JsRunScript(script, JS_SOURCE_CONTEXT_NONE, _u(""), &result) == JsNoError);
+        REQUIRE(JsNumberToInt(result, &sum) == JsNoError);
+        return sum;
+    }
+
+    TEST_CASE("ApiTest_ShareBackgroundNativeCodeGenerationTest", "[ApiTest]")
+    {
+        const JsRuntimeAttributes attributes = (JsRuntimeAttributes)(JsRuntimeAttributeShareBackgroundNativeCodeGeneration | JsRuntimeAttributeAllowScriptInterrupt);
+        JsRuntimeHandle runtime = JS_INVALID_RUNTIME_HANDLE;
+        CHECK(JsCreateRuntime(attributes, nullptr, nullptr) == JsErrorNullArgument);
+
+        // Has no effect together with JsRuntimeAttributeDisableBackgroundWork
+        REQUIRE(JsCreateRuntime((JsRuntimeAttributes)(attributes | JsRuntimeAttributeDisableBackgroundWork), nullptr, &runtime) == JsNoError);
+        REQUIRE(JsDisposeRuntime(runtime) == JsNoError);
+
+        JsRuntimeHandle runtimes[2];
+        JsContextRef contexts[2];
+        for (int i = 0; i < _countof(runtimes); i++)
+        {
+            REQUIRE(JsCreateRuntime(attributes, nullptr, &runtimes[i]) == JsNoError);
+            REQUIRE(JsCreateContext(runtimes[i], &contexts[i]) == JsNoError);
+        }
+
+        // The sum of i * i below 10000, 333283335000, wrapped to int32
+        const int expectedSum = -1724114088;
+
+        // Both runtimes queue their hot functions to the same JIT threads
+        for (int i = 0; i < 10; i++)
+        {
+            CHECK(RunHotFunction(contexts[0], 10000) == expectedSum);
+            CHECK(RunHotFunction(contexts[1], 10000) == expectedSum);
+        }
+
+        // Execution of one runtime is disabled, the other one keeps running on the shared threads
+        REQUIRE(JsSetCurrentContext(nullptr) == JsNoError);
+        REQUIRE(JsDisableRuntimeExecution(runtimes[0]) == JsNoError);
+        REQUIRE(JsSetCurrentContext(contexts[0]) == JsNoError);
+        JsValueRef result = JS_INVALID_REFERENCE;
+        CHECK(JsRunScript(_u("1"), JS_SOURCE_CONTEXT_NONE, _u(""), &result) == JsErrorInDisabledState);
+        CHECK(RunHotFunction(contexts[1], 10000) == expectedSum);
+
+        // The shared threads outlive the runtimes that used them
+        REQUIRE(JsSetCurrentContext(nullptr) == JsNoError);
+        REQUIRE(JsDisposeRuntime(runtimes[0]) == JsNoError);
+        CHECK(RunHotFunction(contexts[1], 10000) == expectedSum);
+
+        REQUIRE(JsSetCurrentContext(nullptr) == JsNoError);
+        REQUIRE(JsDisposeRuntime(runtimes[1]) == JsNoError);
+    }
 }
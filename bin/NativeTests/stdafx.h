@@ -39,6 +39,7 @@ if (!(exp)) \
 #define Assert(exp)             AssertMsg(exp, #exp)
 #define _JSRT_
 #include "chakracommon.h"
+#include "ChakraCore.h"
 #include "Core/CommonTypedefs.h"
 
 #include <FileLoadHelpers.h>
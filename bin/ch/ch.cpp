@@ -420,7 +420,7 @@ static HRESULT CreateRuntime(JsRuntimeHandle *runtime)
     // (See posix man malloc and OOM)
 
     size_t memoryLimit;
-    if (PlatformAgnostic::SystemInfo::GetTotalRam(&memoryLimit))
+    if (PlatformAgnostic::SystemInfo::GetMemoryLimit(&memoryLimit))
     {
         IfJsErrorFailLog(ChakraRTInterface::JsSetRuntimeMemoryLimit(*runtime, memoryLimit));
     }
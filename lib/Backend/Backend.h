@@ -180,6 +180,8 @@ enum IRDumpFlags
 #include "InliningHeuristics.h"
 #include "InliningDecider.h"
 #include "Inline.h"
+#include "LoopUnswitch.h"
+#include "LoopUnroll.h"
 #include "NativeCodeGenerator.h"
 #include "Region.h"
 #include "BailOut.h"
@@ -3973,7 +3973,7 @@ BackwardPass::UpdateArrayBailOutKind(IR::Instr *const instr)
     Assert(instr->HasBailOutInfo());
 
     if ((instr->m_opcode != Js::OpCode::StElemI_A && instr->m_opcode != Js::OpCode::StElemI_A_Strict &&
-        instr->m_opcode != Js::OpCode::Memcopy && instr->m_opcode != Js::OpCode::Memset) ||
+        instr->m_opcode != Js::OpCode::Memcopy && instr->m_opcode != Js::OpCode::Memset && instr->m_opcode != Js::OpCode::Memvector) ||
         !instr->GetDst()->IsIndirOpnd())
     {
         return;
@@ -77,6 +77,17 @@ bool CodeGenWorkItem::ShouldSpeculativelyJitBasedOnProfile() const
 {
     Js::FunctionBody* functionBody = this->GetFunctionBody();
 
+    // A function that reached full JIT in a previous run (per a profile loaded from persistent storage or
+    // the in-memory cache) is worth JITting regardless of its shape. Its code is still specialized from the
+    // profile and guarded as usual, so a profile that no longer holds falls back through bailout.
+    if(functionBody->GetSourceContextInfo()->sourceDynamicProfileManager != nullptr &&
+        functionBody->HasDynamicProfileInfo() &&
+        functionBody->GetAnyDynamicProfileInfo()->HasReachedFullJit())
+    {
+        functionBody->SetIsSpeculativeJitCandidate();
+        return true;
+    }
+
     uint loopPercentage = (functionBody->GetByteCodeInLoopCount()*100) / (functionBody->GetByteCodeCount() + 1);
     uint straightLineSize = functionBody->GetByteCodeCount() - functionBody->GetByteCodeInLoopCount();
 
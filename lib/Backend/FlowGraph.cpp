@@ -787,6 +787,12 @@ Loop::MemSetCandidate* Loop::MemOpCandidate::AsMemSet()
     return (Loop::MemSetCandidate*)this;
 }
 
+Loop::MemVectorCandidate* Loop::MemOpCandidate::AsMemVector()
+{
+    Assert(this->IsMemVector());
+    return (Loop::MemVectorCandidate*)this;
+}
+
 void
 Loop::EnsureMemOpVariablesInitialized()
 {
@@ -2849,6 +2855,15 @@ Loop::CanDoFieldHoist()
     return CanDoFieldCopyProp();
 }
 
+// Whether the profile justifies the code size of an optimization that duplicates the loop body
+// (unswitching, unrolling). Uses the MemOp trip count threshold; a loop that never reached it in the
+// interpreter, or never ran at all, isn't worth it.
+bool
+Loop::IsWorthDuplicating(Js::LoopFlags loopFlags)
+{
+    return loopFlags.memopMinCountReached;
+}
+
 bool
 Loop::CanHoistInvariants()
 {
@@ -598,6 +598,7 @@ public:
                                          // For example, in the lowerer, it'll be set to true when we process the loopTop for a certain loop
     struct MemCopyCandidate;
     struct MemSetCandidate;
+    struct MemVectorCandidate;
     struct MemOpCandidate
     {
         SymID base;
@@ -607,12 +608,15 @@ public:
         enum MemOpType
         {
             MEMSET,
-            MEMCOPY
+            MEMCOPY,
+            MEMVECTOR
         } type;
         bool IsMemSet() const { return type == MEMSET; }
         bool IsMemCopy() const { return type == MEMCOPY; }
+        bool IsMemVector() const { return type == MEMVECTOR; }
         struct Loop::MemCopyCandidate* AsMemCopy();
         struct Loop::MemSetCandidate* AsMemSet();
+        struct Loop::MemVectorCandidate* AsMemVector();
         MemOpCandidate(MemOpType type) :
             type(type)
         {
@@ -635,6 +639,23 @@ public:
         MemCopyCandidate() : MemOpCandidate(MemOpCandidate::MEMCOPY) {}
     };
 
+    // Element-wise arithmetic on typed arrays, c[i] = a[i] op b[i] where either source can be an invariant
+    struct MemVectorCandidate : public MemOpCandidate
+    {
+        struct Operand
+        {
+            SymID ldBase;                   // InvalidSymID if the operand is not loaded from an array
+            StackSym* transferSym;
+            StackSym* srcSym;
+            BailoutConstantValue constant;
+        };
+
+        Js::OpCode opcode;
+        StackSym* resultSym;
+        Operand operands[2];
+        MemVectorCandidate() : MemOpCandidate(MemOpCandidate::MEMVECTOR), resultSym(nullptr) {}
+    };
+
 #define FOREACH_MEMOP_CANDIDATES_EDITING(data, loop, iterator) FOREACH_SLISTCOUNTED_ENTRY_EDITING(Loop::MemOpCandidate*, data, loop->memOpInfo->candidates, iterator)
 #define NEXT_MEMOP_CANDIDATE_EDITING NEXT_SLISTCOUNTED_ENTRY_EDITING
 #define FOREACH_MEMOP_CANDIDATES(data, loop) FOREACH_SLISTCOUNTED_ENTRY(Loop::MemOpCandidate*, data, loop->memOpInfo->candidates)
@@ -735,6 +756,7 @@ public:
     void                SetImplicitCallFlags(Js::ImplicitCallFlags flags);
     Js::LoopFlags GetLoopFlags() const { return loopFlags; }
     void SetLoopFlags(Js::LoopFlags val) { loopFlags = val; }
+    static bool         IsWorthDuplicating(Js::LoopFlags loopFlags);
     bool                CanHoistInvariants();
     bool                CanDoFieldCopyProp();
     bool                CanDoFieldHoist();
@@ -770,6 +792,12 @@ struct MemCopyEmitData : public MemOpEmitData
     IR::Instr* ldElemInstr;
 };
 
+struct MemVectorEmitData : public MemOpEmitData
+{
+    IR::Instr* arithInstr;
+    IR::Instr* ldElemInstrs[2];
+};
+
 #define FOREACH_BLOCK_IN_FUNC(block, func)\
     FOREACH_BLOCK(block, func->m_fg)
 #define NEXT_BLOCK_IN_FUNC\
@@ -389,6 +389,13 @@ Func::TryCodegen()
         IRtoJSObjectBuilder::DumpIRtoGlobalObject(this, Js::IRBuilderPhase);
 #endif /* IR_VIEWER */
 
+        BEGIN_CODEGEN_PHASE(this, Js::LoopUnswitchPhase);
+
+        LoopUnswitch loopUnswitch(this);
+        loopUnswitch.Optimize();
+
+        END_CODEGEN_PHASE(this, Js::LoopUnswitchPhase);
+
         BEGIN_CODEGEN_PHASE(this, Js::InlinePhase);
 
         InliningHeuristics heuristics(GetWorkItem()->GetJITTimeInfo(), this->IsLoopBody());
@@ -428,6 +435,13 @@ Func::TryCodegen()
         IRtoJSObjectBuilder::DumpIRtoGlobalObject(this, Js::GlobOptPhase);
 #endif /* IR_VIEWER */
 
+        BEGIN_CODEGEN_PHASE(this, Js::LoopUnrollPhase);
+
+        LoopUnroll loopUnroll(this);
+        loopUnroll.Optimize();
+
+        END_CODEGEN_PHASE(this, Js::LoopUnrollPhase);
+
         ThrowIfScriptClosed();
 
         // Lowering
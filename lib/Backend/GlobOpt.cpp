@@ -312,6 +312,7 @@ GlobOpt::Optimize()
         this->ForwardPass();
     }
     this->BackwardPass(Js::DeadStorePhase);
+    this->ScalarReplacementPass();
     this->TailDupPass();
 }
 
@@ -965,6 +966,430 @@ GlobOpt::TryTailDup(IR::BranchInstr *tailBranch)
     return true;
 }
 
+//
+// Scalar replacement of non-escaping objects
+//
+// An object created by NewScObjectLiteral or NewScObjectSimple whose only uses are field loads and stores
+// in the block that allocates it never escapes. Once the dead-store pass has computed what each bailout
+// needs to restore, such an object can be removed if no bailout refers to it: every stored value that is
+// loaded back is copied to a new sym, the loads read that sym, and the allocation, the stores and the
+// type checks on the object go away. The type checks can't fail, the object's type is the one the
+// allocation gave it, so their own bailouts don't keep the object alive.
+//
+// Objects that are live at a bailout point are left materialized rather than rematerialized by the
+// bailout, as are objects that flow into any other instruction, cross a block boundary or have a field
+// read that isn't known to be an own property stored in the same block.
+//
+struct ScalarReplacementObject
+{
+    typedef JsUtil::BaseDictionary<Js::PropertyId, IR::Instr *, JitArenaAllocator> FieldStoreMap;
+
+    IR::Instr * allocInstr;
+    BasicBlock * block;
+    FieldStoreMap * fieldStores;            // Last store of each field, while walking the allocating block
+    bool isRejected;
+};
+
+struct ScalarReplacementSym
+{
+    ScalarReplacementObject * object;
+    IR::Instr * defInstr;
+    bool isDefined;
+};
+
+typedef JsUtil::BaseDictionary<SymID, ScalarReplacementSym, JitArenaAllocator> ScalarReplacementSymMap;
+typedef JsUtil::BaseDictionary<IR::Instr *, StackSym *, JitArenaAllocator> ScalarReplacementCopySymMap;
+
+static bool
+IsScalarReplacementFieldLoad(IR::Instr *instr)
+{
+    return instr->m_opcode == Js::OpCode::LdFld;
+}
+
+static bool
+IsScalarReplacementFieldStore(IR::Instr *instr)
+{
+    return instr->m_opcode == Js::OpCode::InitFld
+        || instr->m_opcode == Js::OpCode::StFld
+        || instr->m_opcode == Js::OpCode::StFldStrict;
+}
+
+static bool
+IsScalarReplacementTypeCheck(IR::Instr *instr)
+{
+    return instr->m_opcode == Js::OpCode::CheckObjType;
+}
+
+static ScalarReplacementSym *
+FindScalarReplacementSym(ScalarReplacementSymMap *symMap, StackSym *sym)
+{
+    ScalarReplacementSym *replacementSym = nullptr;
+    if (sym == nullptr || !symMap->TryGetReference(sym->m_id, &replacementSym))
+    {
+        return nullptr;
+    }
+    return replacementSym;
+}
+
+// Returns the object whose field the instruction loads, stores or type checks, if it is a candidate
+static ScalarReplacementObject *
+GetScalarReplacementFieldObject(ScalarReplacementSymMap *symMap, IR::Instr *instr, IR::Opnd *fieldOpnd)
+{
+    if (!fieldOpnd || !fieldOpnd->IsSymOpnd() || !fieldOpnd->AsSymOpnd()->m_sym->IsPropertySym())
+    {
+        return nullptr;
+    }
+
+    PropertySym *propertySym = fieldOpnd->AsSymOpnd()->m_sym->AsPropertySym();
+    ScalarReplacementSym *replacementSym = FindScalarReplacementSym(symMap, propertySym->m_stackSym);
+    if (replacementSym == nullptr || propertySym->m_fieldKind != PropertyKindData)
+    {
+        return nullptr;
+    }
+
+    if (fieldOpnd == instr->GetDst()
+            ? IsScalarReplacementFieldStore(instr)
+            : (fieldOpnd == instr->GetSrc1() && (IsScalarReplacementFieldLoad(instr) || IsScalarReplacementTypeCheck(instr))))
+    {
+        return replacementSym->object;
+    }
+    return nullptr;
+}
+
+void
+GlobOpt::ScalarReplacementPass()
+{
+    if (PHASE_OFF(Js::ScalarReplacementPhase, this->func) ||
+        this->func->HasTry() ||
+        this->func->IsJitInDebugMode() ||
+        this->func->GetJITFunctionBody()->IsCoroutine())
+    {
+        return;
+    }
+
+    NoRecoverMemoryJitArenaAllocator localAlloc(_u("BE-ScalarReplacement"), this->func->m_alloc->GetPageAllocator(), Js::Throw::OutOfMemory);
+    ScalarReplacementSymMap symMap(&localAlloc);
+
+    // Collect the allocations, and the copies of them made in the same block
+    FOREACH_BLOCK_IN_FUNC_DEAD_OR_ALIVE(block, this->func)
+    {
+        FOREACH_INSTR_IN_BLOCK(instr, block)
+        {
+            IR::Opnd *dst = instr->GetDst();
+            if (!dst || !dst->IsRegOpnd() || dst->GetType() != TyVar || symMap.ContainsKey(dst->AsRegOpnd()->m_sym->m_id))
+            {
+                continue;
+            }
+
+            if (instr->m_opcode == Js::OpCode::NewScObjectLiteral || instr->m_opcode == Js::OpCode::NewScObjectSimple)
+            {
+                ScalarReplacementObject *object = JitAnewStruct(&localAlloc, ScalarReplacementObject);
+                object->allocInstr = instr;
+                object->block = block;
+                object->fieldStores = nullptr;
+                object->isRejected = false;
+
+                ScalarReplacementSym replacementSym = { object, instr, false };
+                symMap.Add(dst->AsRegOpnd()->m_sym->m_id, replacementSym);
+            }
+            else if (instr->m_opcode == Js::OpCode::Ld_A && instr->GetSrc1()->IsRegOpnd())
+            {
+                ScalarReplacementSym *srcSym = FindScalarReplacementSym(&symMap, instr->GetSrc1()->AsRegOpnd()->m_sym);
+                if (srcSym && srcSym->object->block == block)
+                {
+                    ScalarReplacementSym replacementSym = { srcSym->object, instr, false };
+                    symMap.Add(dst->AsRegOpnd()->m_sym->m_id, replacementSym);
+                }
+            }
+        } NEXT_INSTR_IN_BLOCK;
+    } NEXT_BLOCK_IN_FUNC_DEAD_OR_ALIVE;
+
+    if (symMap.Count() == 0)
+    {
+        return;
+    }
+
+    // Escape analysis: reject the objects that are used by anything other than their field loads and stores
+    // and copies in the allocating block, or that a bailout would have to restore.
+    const auto rejectSym = [&](StackSym *sym, ScalarReplacementObject *exemptObject)
+    {
+        ScalarReplacementSym *replacementSym = FindScalarReplacementSym(&symMap, sym);
+        if (replacementSym && replacementSym->object != exemptObject)
+        {
+            replacementSym->object->isRejected = true;
+        }
+    };
+
+    const auto rejectOpnd = [&](IR::Instr *instr, IR::Opnd *opnd, BasicBlock *block)
+    {
+        if (!opnd)
+        {
+            return;
+        }
+
+        if (opnd->IsRegOpnd())
+        {
+            ScalarReplacementSym *replacementSym = FindScalarReplacementSym(&symMap, opnd->AsRegOpnd()->m_sym);
+            if (replacementSym == nullptr)
+            {
+                return;
+            }
+
+            if (opnd == instr->GetDst())
+            {
+                if (replacementSym->defInstr != instr)
+                {
+                    replacementSym->object->isRejected = true;
+                }
+                return;
+            }
+
+            // A copy of the object to another candidate sym of the same object
+            IR::Opnd *dst = instr->GetDst();
+            ScalarReplacementSym *dstSym = instr->m_opcode == Js::OpCode::Ld_A && dst->IsRegOpnd() ? FindScalarReplacementSym(&symMap, dst->AsRegOpnd()->m_sym) : nullptr;
+            if (dstSym == nullptr || dstSym->defInstr != instr || dstSym->object != replacementSym->object)
+            {
+                replacementSym->object->isRejected = true;
+            }
+        }
+        else if (opnd->IsSymOpnd())
+        {
+            if (!opnd->AsSymOpnd()->m_sym->IsPropertySym())
+            {
+                return;
+            }
+
+            StackSym *objectSym = opnd->AsSymOpnd()->m_sym->AsPropertySym()->m_stackSym;
+            ScalarReplacementSym *replacementSym = FindScalarReplacementSym(&symMap, objectSym);
+            if (replacementSym && GetScalarReplacementFieldObject(&symMap, instr, opnd) != replacementSym->object)
+            {
+                replacementSym->object->isRejected = true;
+            }
+            else if (replacementSym && replacementSym->object->block != block)
+            {
+                replacementSym->object->isRejected = true;
+            }
+        }
+        else if (opnd->IsIndirOpnd())
+        {
+            rejectSym(opnd->AsIndirOpnd()->GetBaseOpnd()->m_sym, nullptr);
+            if (opnd->AsIndirOpnd()->GetIndexOpnd())
+            {
+                rejectSym(opnd->AsIndirOpnd()->GetIndexOpnd()->m_sym, nullptr);
+            }
+        }
+    };
+
+    FOREACH_BLOCK_IN_FUNC_DEAD_OR_ALIVE(block, this->func)
+    {
+        FOREACH_INSTR_IN_BLOCK(instr, block)
+        {
+            rejectOpnd(instr, instr->GetDst(), block);
+            rejectOpnd(instr, instr->GetSrc1(), block);
+            rejectOpnd(instr, instr->GetSrc2(), block);
+
+            if (!instr->HasBailOutInfo() && !instr->HasAuxBailOut())
+            {
+                continue;
+            }
+
+            // The same syms that SCCLiveness::ProcessBailOutUses keeps alive. A field access doesn't need to
+            // restore its own object when its bailout goes away along with it.
+            BailOutInfo *bailOutInfo = instr->GetBailOutInfo();
+            ScalarReplacementObject *exemptObject = nullptr;
+            if (bailOutInfo->bailOutInstr == instr)
+            {
+                exemptObject = GetScalarReplacementFieldObject(&symMap, instr, IsScalarReplacementFieldStore(instr) ? instr->GetDst() : instr->GetSrc1());
+            }
+
+            if (bailOutInfo->byteCodeUpwardExposedUsed)
+            {
+                symMap.Map([&](SymID symId, const ScalarReplacementSym &replacementSym)
+                {
+                    if (replacementSym.object != exemptObject && bailOutInfo->byteCodeUpwardExposedUsed->Test(symId))
+                    {
+                        replacementSym.object->isRejected = true;
+                    }
+                });
+            }
+
+            FOREACH_SLISTBASE_ENTRY(CopyPropSyms, copyPropSyms, &bailOutInfo->usedCapturedValues.copyPropSyms)
+            {
+                rejectSym(copyPropSyms.Key(), exemptObject);
+                rejectSym(copyPropSyms.Value(), exemptObject);
+            }
+            NEXT_SLISTBASE_ENTRY;
+
+            bailOutInfo->IterateArgOutSyms([&](uint, uint, StackSym *sym)
+            {
+                rejectSym(sym, nullptr);
+            });
+
+            for (uint i = 0; i < bailOutInfo->stackLiteralBailOutInfoCount; i++)
+            {
+                rejectSym(bailOutInfo->stackLiteralBailOutInfo[i].stackSym, exemptObject);
+            }
+
+            if (bailOutInfo->branchConditionOpnd && bailOutInfo->branchConditionOpnd->IsRegOpnd())
+            {
+                rejectSym(bailOutInfo->branchConditionOpnd->AsRegOpnd()->m_sym, nullptr);
+            }
+
+            for (Func *inlinee = instr->m_func; !inlinee->IsTopFunc(); inlinee = inlinee->GetParentFunc())
+            {
+                if (inlinee->frameInfo && inlinee->frameInfo->isRecorded)
+                {
+                    inlinee->frameInfo->IterateSyms([&](StackSym *argSym)
+                    {
+                        rejectSym(argSym, nullptr);
+                    });
+                }
+            }
+        } NEXT_INSTR_IN_BLOCK;
+    } NEXT_BLOCK_IN_FUNC_DEAD_OR_ALIVE;
+
+    symMap.Map([&](SymID symId, const ScalarReplacementSym &replacementSym)
+    {
+        StackSym *sym = this->func->m_symTable->FindStackSym(symId);
+        if (sym->m_isBailOutReferenced)
+        {
+            replacementSym.object->isRejected = true;
+        }
+    });
+
+    // Follow the fields through the block. Every load must read an own data property stored earlier in the
+    // block, otherwise it could reach the prototype. Stores that are loaded back get a sym for their value.
+    ScalarReplacementCopySymMap copySymMap(&localAlloc);
+    FOREACH_BLOCK_IN_FUNC(block, this->func)
+    {
+        FOREACH_INSTR_IN_BLOCK(instr, block)
+        {
+            IR::Opnd *dst = instr->GetDst();
+            ScalarReplacementSym *defSym = dst && dst->IsRegOpnd() ? FindScalarReplacementSym(&symMap, dst->AsRegOpnd()->m_sym) : nullptr;
+            if (defSym && defSym->defInstr == instr)
+            {
+                if (instr == defSym->object->allocInstr)
+                {
+                    defSym->object->fieldStores = JitAnew(&localAlloc, ScalarReplacementObject::FieldStoreMap, &localAlloc);
+                }
+                defSym->isDefined = true;
+                continue;
+            }
+
+            IR::Opnd *fieldOpnd = IsScalarReplacementFieldStore(instr) ? dst : instr->GetSrc1();
+            ScalarReplacementObject *object = GetScalarReplacementFieldObject(&symMap, instr, fieldOpnd);
+            if (object == nullptr || object->isRejected)
+            {
+                continue;
+            }
+
+            // In a single block loop, a use can come before the allocation and read the previous iteration's object
+            PropertySym *propertySym = fieldOpnd->AsSymOpnd()->m_sym->AsPropertySym();
+            if (!FindScalarReplacementSym(&symMap, propertySym->m_stackSym)->isDefined)
+            {
+                object->isRejected = true;
+                continue;
+            }
+
+            if (IsScalarReplacementTypeCheck(instr))
+            {
+                continue;
+            }
+
+            Js::PropertyId propertyId = propertySym->m_propertyId;
+            if (IsScalarReplacementFieldStore(instr))
+            {
+                // InitFld defines the property, a plain store needs an own data property or it could run a setter
+                if (instr->GetSrc1()->GetType() != TyVar ||
+                    (instr->m_opcode != Js::OpCode::InitFld && !object->fieldStores->ContainsKey(propertyId)))
+                {
+                    object->isRejected = true;
+                    continue;
+                }
+                object->fieldStores->Item(propertyId, instr);
+            }
+            else
+            {
+                IR::Instr *storeInstr;
+                if (instr->GetDst()->GetType() != TyVar || !object->fieldStores->TryGetValue(propertyId, &storeInstr))
+                {
+                    object->isRejected = true;
+                    continue;
+                }
+
+                StackSym *copySym;
+                if (!copySymMap.TryGetValue(storeInstr, &copySym))
+                {
+                    copySym = StackSym::New(TyVar, this->func);
+                    copySymMap.Add(storeInstr, copySym);
+                }
+                copySymMap.Add(instr, copySym);
+            }
+        } NEXT_INSTR_IN_BLOCK;
+    } NEXT_BLOCK_IN_FUNC;
+
+    // Rewrite the field accesses of the remaining objects and remove the objects
+    FOREACH_BLOCK_IN_FUNC(block, this->func)
+    {
+        FOREACH_INSTR_IN_BLOCK_EDITING(instr, instrNext, block)
+        {
+            IR::Opnd *dst = instr->GetDst();
+            ScalarReplacementSym *defSym = dst && dst->IsRegOpnd() ? FindScalarReplacementSym(&symMap, dst->AsRegOpnd()->m_sym) : nullptr;
+            if (defSym && defSym->defInstr == instr)
+            {
+                if (!defSym->object->isRejected)
+                {
+                    TRACE_TESTTRACE_PHASE_INSTR(Js::ScalarReplacementPhase, instr, _u("Removed non-escaping object\n"));
+                    instr->Remove();
+                }
+                continue;
+            }
+
+            bool isStore = IsScalarReplacementFieldStore(instr);
+            ScalarReplacementObject *object = GetScalarReplacementFieldObject(&symMap, instr, isStore ? dst : instr->GetSrc1());
+            if (object == nullptr || object->isRejected)
+            {
+                continue;
+            }
+
+            if (IsScalarReplacementTypeCheck(instr))
+            {
+                TRACE_PHASE_INSTR(Js::ScalarReplacementPhase, instr, _u("Removed type check of non-escaping object\n"));
+                instr->Remove();
+                continue;
+            }
+
+            StackSym *copySym = nullptr;
+            copySymMap.TryGetValue(instr, &copySym);
+            if (isStore)
+            {
+                if (copySym)
+                {
+                    IR::RegOpnd *copyOpnd = IR::RegOpnd::New(copySym, TyVar, instr->m_func);
+                    copyOpnd->SetIsJITOptimizedReg(true);
+                    copyOpnd->SetValueType(instr->GetSrc1()->GetValueType());
+                    IR::Instr *copyInstr = IR::Instr::New(Js::OpCode::Ld_A, copyOpnd, instr->UnlinkSrc1(), instr->m_func);
+                    copyInstr->SetByteCodeOffset(instr);
+                    instr->InsertBefore(copyInstr);
+                }
+            }
+            else
+            {
+                Assert(copySym);
+                IR::RegOpnd *copyOpnd = IR::RegOpnd::New(copySym, TyVar, instr->m_func);
+                copyOpnd->SetIsJITOptimizedReg(true);
+                copyOpnd->SetValueType(dst->GetValueType());
+                IR::Instr *loadInstr = IR::Instr::New(Js::OpCode::Ld_A, instr->UnlinkDst(), copyOpnd, instr->m_func);
+                loadInstr->SetByteCodeOffset(instr);
+                instr->InsertBefore(loadInstr);
+            }
+
+            TRACE_PHASE_INSTR(Js::ScalarReplacementPhase, instr, _u("Replaced field access of non-escaping object\n"));
+            instr->Remove();
+        } NEXT_INSTR_IN_BLOCK_EDITING;
+    } NEXT_BLOCK_IN_FUNC;
+}
+
 void
 GlobOpt::MergePredBlocksValueMaps(BasicBlock *block)
 {
@@ -4628,6 +5053,216 @@ bool GlobOpt::CollectMemcopyStElementI(IR::Instr *instr, Loop *loop)
     return true;
 }
 
+bool
+GlobOpt::CollectMemvectorArithInstr(IR::Instr *instr, Loop *loop)
+{
+    // Float32Array kernels are float specialized and Int32Array kernels int specialized. Single precision results
+    // rounded from the double arithmetic match the single precision arithmetic, and int32 add/sub wrap like the
+    // ToInt32 of the store. Int32 multiplication is left out, the double product is not the wrapped int32 product.
+    bool isFloat;
+    switch (instr->m_opcode)
+    {
+    case Js::OpCode::Add_A:
+    case Js::OpCode::Sub_A:
+    case Js::OpCode::Mul_A:
+    case Js::OpCode::Div_A:
+        isFloat = true;
+        break;
+    case Js::OpCode::Add_I4:
+    case Js::OpCode::Sub_I4:
+        isFloat = false;
+        break;
+    default:
+        return false;
+    }
+
+    IR::Opnd *dst = instr->GetDst();
+    if (!dst || !dst->IsRegOpnd() || dst->GetType() != (isFloat ? TyFloat64 : TyInt32) || !dst->AsRegOpnd()->GetStackSym()->IsSingleDef())
+    {
+        return false;
+    }
+
+    if (!loop->memOpInfo || loop->memOpInfo->candidates->Empty())
+    {
+        return false;
+    }
+
+    // The element loads are the memcopy candidates that are still waiting for their StElemI
+    Loop::MemCopyCandidate* loads[2] = { nullptr, nullptr };
+    int loadCount = 0;
+    FOREACH_MEMOP_CANDIDATES(candidate, loop)
+    {
+        if (!candidate->IsMemCopy() || candidate->AsMemCopy()->base != Js::Constants::InvalidSymID)
+        {
+            break;
+        }
+        if (loadCount == 2)
+        {
+            return false;
+        }
+        loads[loadCount++] = candidate->AsMemCopy();
+    }
+    NEXT_MEMOP_CANDIDATE;
+
+    if (loadCount == 0 || (loadCount == 2 && loads[0]->bIndexAlreadyChanged != loads[1]->bIndexAlreadyChanged))
+    {
+        return false;
+    }
+
+    Loop::MemVectorCandidate::Operand operands[2];
+    bool isLoadUsed[2] = { false, false };
+    IR::Opnd *srcs[2] = { instr->GetSrc1(), instr->GetSrc2() };
+    for (int i = 0; i < 2; i++)
+    {
+        IR::Opnd *src = srcs[i];
+        Loop::MemVectorCandidate::Operand &operand = operands[i];
+        BailoutConstantValue constant = {TyIllegal, 0};
+        operand.ldBase = Js::Constants::InvalidSymID;
+        operand.transferSym = nullptr;
+        operand.srcSym = nullptr;
+        operand.constant = constant;
+
+        if (!src)
+        {
+            return false;
+        }
+
+        if (src->IsRegOpnd())
+        {
+            IR::RegOpnd *regSrc = src->AsRegOpnd();
+            SymID srcSymID = GetVarSymID(regSrc->GetStackSym());
+            if (src->GetType() != dst->GetType())
+            {
+                return false;
+            }
+
+            int load = 0;
+            while (load < loadCount && GetVarSymID(loads[load]->transferSym) != srcSymID)
+            {
+                load++;
+            }
+            if (load < loadCount)
+            {
+                if (isLoadUsed[load] || !regSrc->GetIsDead())
+                {
+                    TRACE_MEMOP_PHASE_VERBOSE(MemVector, loop, instr, _u("Loaded value (s%d) is still alive after the arithmetic"), srcSymID);
+                    return false;
+                }
+                isLoadUsed[load] = true;
+                operand.ldBase = loads[load]->ldBase;
+                operand.transferSym = loads[load]->transferSym;
+            }
+            else if (this->OptIsInvariant(regSrc, this->currentBlock, loop, this->FindValue(regSrc->m_sym), true, true))
+            {
+                operand.srcSym = regSrc->GetStackSym();
+            }
+            else
+            {
+                TRACE_MEMOP_PHASE_VERBOSE(MemVector, loop, instr, _u("Source (s%d) is neither a loaded element nor an invariant"), srcSymID);
+                return false;
+            }
+        }
+        else if (isFloat && src->IsFloatConstOpnd())
+        {
+            operand.constant.InitFloatConstValue(src->AsFloatConstOpnd()->m_value);
+        }
+        else if (!isFloat && src->IsIntConstOpnd())
+        {
+            operand.constant.InitIntConstValue(src->AsIntConstOpnd()->GetValue(), src->AsIntConstOpnd()->GetType());
+        }
+        else
+        {
+            return false;
+        }
+    }
+
+    if (!isLoadUsed[0] || (loadCount == 2 && !isLoadUsed[1]))
+    {
+        TRACE_MEMOP_PHASE_VERBOSE(MemVector, loop, instr, _u("Loaded element not used by the arithmetic"));
+        return false;
+    }
+
+    // The arithmetic replaces its loads in the list of candidates
+    Loop::MemVectorCandidate* memvectorInfo = JitAnewStruct(this->func->GetTopFunc()->m_fg->alloc, Loop::MemVectorCandidate);
+    memvectorInfo->opcode = instr->m_opcode;
+    memvectorInfo->resultSym = dst->AsRegOpnd()->GetStackSym();
+    memvectorInfo->operands[0] = operands[0];
+    memvectorInfo->operands[1] = operands[1];
+    memvectorInfo->count = 0;
+    memvectorInfo->bIndexAlreadyChanged = loads[0]->bIndexAlreadyChanged;
+    memvectorInfo->base = Js::Constants::InvalidSymID; //need to find the stElem first
+    memvectorInfo->index = loads[0]->index;
+    for (int i = 0; i < loadCount; i++)
+    {
+        loop->memOpInfo->candidates->RemoveHead();
+    }
+    loop->memOpInfo->candidates->Prepend(memvectorInfo);
+    return true;
+}
+
+bool
+GlobOpt::CollectMemvectorStElementI(IR::Instr *instr, Loop *loop)
+{
+    if (!loop->memOpInfo || loop->memOpInfo->candidates->Empty())
+    {
+        // There is no arithmetic matching this stElem
+        return false;
+    }
+
+    Assert(instr->GetDst()->IsIndirOpnd());
+    IR::IndirOpnd *dst = instr->GetDst()->AsIndirOpnd();
+    IR::Opnd *indexOp = dst->GetIndexOpnd();
+    IR::RegOpnd *baseOp = dst->GetBaseOpnd()->AsRegOpnd();
+    SymID baseSymID = GetVarSymID(baseOp->GetStackSym());
+
+    if (!instr->GetSrc1()->IsRegOpnd())
+    {
+        return false;
+    }
+    IR::RegOpnd* src1 = instr->GetSrc1()->AsRegOpnd();
+
+    Loop::MemOpCandidate* previousCandidate = loop->memOpInfo->candidates->Head();
+    if (!previousCandidate->IsMemVector())
+    {
+        return false;
+    }
+    Loop::MemVectorCandidate* memvectorInfo = previousCandidate->AsMemVector();
+
+    // The previous candidate has to have been created by the arithmetic computing the stored value
+    if (memvectorInfo->base != Js::Constants::InvalidSymID || src1->GetStackSym() != memvectorInfo->resultSym)
+    {
+        TRACE_MEMOP_PHASE_VERBOSE(MemVector, loop, instr, _u("No matching arithmetic found (s%d)"), baseSymID);
+        return false;
+    }
+
+    if (!src1->GetIsDead())
+    {
+        TRACE_MEMOP_PHASE_VERBOSE(MemVector, loop, instr, _u("Source (s%d) is still alive after StElemI"), baseSymID);
+        return false;
+    }
+
+    if (!IsAllowedForMemOpt(instr, false, baseOp, indexOp))
+    {
+        return false;
+    }
+
+    Assert(indexOp->GetStackSym());
+    SymID inductionSymID = GetVarSymID(indexOp->GetStackSym());
+    Assert(IsSymIDInductionVariable(inductionSymID, loop));
+    bool isIndexPreIncr = loop->memOpInfo->inductionVariableChangeInfoMap->ContainsKey(inductionSymID);
+    if (isIndexPreIncr != memvectorInfo->bIndexAlreadyChanged)
+    {
+        // The index changed between the loads and the store
+        TRACE_MEMOP_PHASE_VERBOSE(MemVector, loop, instr, _u("Index value changed between ldElem and stElem"));
+        return false;
+    }
+
+    memvectorInfo->count++;
+    memvectorInfo->base = baseSymID;
+
+    return true;
+}
+
 bool
 GlobOpt::CollectMemOpLdElementI(IR::Instr *instr, Loop *loop)
 {
@@ -4641,7 +5276,8 @@ GlobOpt::CollectMemOpStElementI(IR::Instr *instr, Loop *loop)
     Assert(instr->m_opcode == Js::OpCode::StElemI_A || instr->m_opcode == Js::OpCode::StElemI_A_Strict);
     Assert(instr->GetSrc1());
     return (!PHASE_OFF(Js::MemSetPhase, this->func) && CollectMemsetStElementI(instr, loop)) ||
-        (!PHASE_OFF(Js::MemCopyPhase, this->func) && CollectMemcopyStElementI(instr, loop));
+        (!PHASE_OFF(Js::MemCopyPhase, this->func) && CollectMemcopyStElementI(instr, loop)) ||
+        (!PHASE_OFF(Js::MemVectorPhase, this->func) && CollectMemvectorStElementI(instr, loop));
 }
 
 bool
@@ -4771,6 +5407,11 @@ MemOpCheckInductionVariable:
         // Fallthrough if not an induction variable
     }
     default:
+        if (!PHASE_OFF(Js::MemVectorPhase, this->func) && CollectMemvectorArithInstr(instr, loop))
+        {
+            break;
+        }
+
         if (IsInstrInvalidForMemOp(instr, loop, src1Val, src2Val))
         {
             loop->doMemOp = false;
@@ -4794,6 +5435,16 @@ MemOpCheckInductionVariable:
                     }
                 }
             }
+            else if (prevCandidate->IsMemVector())
+            {
+                Loop::MemVectorCandidate* memvectorCandidate = prevCandidate->AsMemVector();
+                if (memvectorCandidate->base == Js::Constants::InvalidSymID && instr->FindRegUse(memvectorCandidate->resultSym))
+                {
+                    loop->doMemOp = false;
+                    TRACE_MEMOP_PHASE_VERBOSE(MemVector, loop, instr, _u("Found illegal use of arithmetic value(s%d)"), GetVarSymID(memvectorCandidate->resultSym));
+                    return false;
+                }
+            }
         }
     }
 
@@ -21333,11 +21984,13 @@ void
 GlobOpt::RemoveMemOpSrcInstr(IR::Instr* memopInstr, IR::Instr* srcInstr, BasicBlock* block)
 {
     Assert(srcInstr && (srcInstr->m_opcode == Js::OpCode::LdElemI_A || srcInstr->m_opcode == Js::OpCode::StElemI_A || srcInstr->m_opcode == Js::OpCode::StElemI_A_Strict));
-    Assert(memopInstr && (memopInstr->m_opcode == Js::OpCode::Memcopy || memopInstr->m_opcode == Js::OpCode::Memset));
+    Assert(memopInstr && (memopInstr->m_opcode == Js::OpCode::Memcopy || memopInstr->m_opcode == Js::OpCode::Memset || memopInstr->m_opcode == Js::OpCode::Memvector));
     Assert(block);
     const bool isDst = srcInstr->m_opcode == Js::OpCode::StElemI_A || srcInstr->m_opcode == Js::OpCode::StElemI_A_Strict;
-    IR::RegOpnd* opnd = (isDst ? memopInstr->GetDst() : memopInstr->GetSrc1())->AsIndirOpnd()->GetBaseOpnd();
-    IR::ArrayRegOpnd* arrayOpnd = opnd->IsArrayRegOpnd() ? opnd->AsArrayRegOpnd() : nullptr;
+    // The sources of Memvector are chained with ExtendArg_A, they are typed arrays that have no head segment to remove
+    IR::Opnd* memopArrayOpnd = isDst ? memopInstr->GetDst() : memopInstr->GetSrc1();
+    IR::RegOpnd* opnd = memopArrayOpnd->IsIndirOpnd() ? memopArrayOpnd->AsIndirOpnd()->GetBaseOpnd() : nullptr;
+    IR::ArrayRegOpnd* arrayOpnd = opnd && opnd->IsArrayRegOpnd() ? opnd->AsArrayRegOpnd() : nullptr;
 
     IR::Instr* topInstr = srcInstr;
     if (srcInstr->extractedUpperBoundCheckWithoutHoisting)
@@ -21461,6 +22114,7 @@ GlobOpt::EmitMemop(Loop * loop, LoopCount *loopCount, const MemOpEmitData* emitD
 
     IR::Opnd *src1;
     const bool isMemset = emitData->candidate->IsMemSet();
+    const bool isMemvector = emitData->candidate->IsMemVector();
 
     // Get the source according to the memop type
     if (isMemset)
@@ -21478,6 +22132,64 @@ GlobOpt::EmitMemop(Loop * loop, LoopCount *loopCount, const MemOpEmitData* emitD
             src1 = IR::AddrOpnd::New(candidate->constant.ToVar(localFunc), IR::AddrOpndKindConstantAddress, localFunc);
         }
     }
+    else if (isMemvector)
+    {
+        MemVectorEmitData* data = (MemVectorEmitData*)emitData;
+        const Loop::MemVectorCandidate* candidate = data->candidate->AsMemVector();
+        Assert(data->arithInstr);
+
+        // Chain the sources and the arithmetic, the lowerer passes them all to the helper
+        //     s1 = ExtendArg_A src2
+        //     s2 = ExtendArg_A src1, s1
+        //     s3 = ExtendArg_A opcode, s2
+        //     Memvector [base + startIndex], s3, size
+        IR::Instr *extendArgInstr = nullptr;
+        for (int i = 1; i >= 0; --i)
+        {
+            const Loop::MemVectorCandidate::Operand &operand = candidate->operands[i];
+            IR::Opnd *srcOpnd;
+            if (operand.ldBase != Js::Constants::InvalidSymID)
+            {
+                IR::Instr *ldElemInstr = data->ldElemInstrs[i];
+                Assert(ldElemInstr && ldElemInstr->m_opcode == Js::OpCode::LdElemI_A);
+
+                IR::RegOpnd *srcBaseOpnd = nullptr;
+                IR::RegOpnd *srcIndexOpnd = nullptr;
+                IRType srcType;
+                GetMemOpSrcInfo(loop, ldElemInstr, srcBaseOpnd, srcIndexOpnd, srcType);
+                Assert(GetVarSymID(srcIndexOpnd->GetStackSym()) == GetVarSymID(indexOpnd->GetStackSym()));
+
+                IR::RegOpnd *regSrc = IR::RegOpnd::New(srcBaseOpnd->m_sym, TyVar, localFunc);
+                regSrc->SetValueType(srcBaseOpnd->GetValueType());
+                regSrc->SetIsJITOptimizedReg(true);
+                srcOpnd = regSrc;
+            }
+            else if (operand.srcSym)
+            {
+                IR::RegOpnd* regSrc = IR::RegOpnd::New(operand.srcSym, operand.srcSym->GetType(), localFunc);
+                regSrc->SetIsJITOptimizedReg(true);
+                srcOpnd = regSrc;
+            }
+            else
+            {
+                srcOpnd = IR::AddrOpnd::New(operand.constant.ToVar(localFunc), IR::AddrOpndKindConstantAddress, localFunc);
+            }
+
+            extendArgInstr = extendArgInstr ?
+                IR::Instr::New(Js::OpCode::ExtendArg_A, IR::RegOpnd::New(TyVar, localFunc), srcOpnd, extendArgInstr->GetDst(), localFunc) :
+                IR::Instr::New(Js::OpCode::ExtendArg_A, IR::RegOpnd::New(TyVar, localFunc), srcOpnd, localFunc);
+            insertBeforeInstr->InsertBefore(extendArgInstr);
+        }
+
+        // The helper works on the JavaScript operation, the int32 opcodes only differ by their specialization
+        Js::OpCode opcode = candidate->opcode == Js::OpCode::Add_I4 ? Js::OpCode::Add_A :
+            candidate->opcode == Js::OpCode::Sub_I4 ? Js::OpCode::Sub_A :
+            candidate->opcode;
+        extendArgInstr = IR::Instr::New(Js::OpCode::ExtendArg_A, IR::RegOpnd::New(TyVar, localFunc),
+            IR::IntConstOpnd::New((IntConstType)opcode, TyInt32, localFunc, true), extendArgInstr->GetDst(), localFunc);
+        insertBeforeInstr->InsertBefore(extendArgInstr);
+        src1 = extendArgInstr->GetDst();
+    }
     else
     {
         Assert(emitData->candidate->IsMemCopy());
@@ -21496,7 +22208,7 @@ GlobOpt::EmitMemop(Loop * loop, LoopCount *loopCount, const MemOpEmitData* emitD
     }
 
     // Generate memcopy
-    IR::Instr* memopInstr = IR::BailOutInstr::New(isMemset ? Js::OpCode::Memset : Js::OpCode::Memcopy, bailOutKind, bailOutInfo, localFunc);
+    IR::Instr* memopInstr = IR::BailOutInstr::New(isMemset ? Js::OpCode::Memset : isMemvector ? Js::OpCode::Memvector : Js::OpCode::Memcopy, bailOutKind, bailOutInfo, localFunc);
     memopInstr->SetDst(dstOpnd);
     memopInstr->SetSrc1(src1);
     memopInstr->SetSrc2(sizeOpnd);
@@ -21558,6 +22270,20 @@ GlobOpt::EmitMemop(Loop * loop, LoopCount *loopCount, const MemOpEmitData* emitD
                               loopCountBuf,
                               bIndexAlreadyChanged);
         }
+        else if (isMemvector)
+        {
+            const Loop::MemVectorCandidate* candidate = emitData->candidate->AsMemVector();
+            TRACE_MEMOP_PHASE(MemVector, loop, emitData->stElemInstr,
+                              _u("ValueType: %S, StBase: s%u, Index: s%u, Op: %s, LdBase1: s%u, LdBase2: s%u, LoopCount: %s, IsIndexChangedBeforeUse: %d"),
+                              valueTypeStr,
+                              candidate->base,
+                              candidate->index,
+                              Js::OpCodeUtil::GetOpCodeName(candidate->opcode),
+                              candidate->operands[0].ldBase,
+                              candidate->operands[1].ldBase,
+                              loopCountBuf,
+                              bIndexAlreadyChanged);
+        }
         else
         {
             const Loop::MemCopyCandidate* candidate = emitData->candidate->AsMemCopy();
@@ -21574,8 +22300,26 @@ GlobOpt::EmitMemop(Loop * loop, LoopCount *loopCount, const MemOpEmitData* emitD
     }
 #endif
 
+    if (isMemvector)
+    {
+        TESTTRACE_PHASE_INSTR(Js::MemVectorPhase, emitData->stElemInstr, _u("Emitting memvector %s\n"),
+                              Js::OpCodeUtil::GetOpCodeName(emitData->candidate->AsMemVector()->opcode));
+    }
+
     RemoveMemOpSrcInstr(memopInstr, emitData->stElemInstr, emitData->block);
-    if (!isMemset)
+    if (isMemvector)
+    {
+        MemVectorEmitData* data = (MemVectorEmitData*)emitData;
+        this->ConvertToByteCodeUses(data->arithInstr);
+        for (int i = 0; i < 2; i++)
+        {
+            if (data->ldElemInstrs[i])
+            {
+                RemoveMemOpSrcInstr(memopInstr, data->ldElemInstrs[i], emitData->block);
+            }
+        }
+    }
+    else if (!isMemset)
     {
         RemoveMemOpSrcInstr(memopInstr, ((MemCopyEmitData*)emitData)->ldElemInstr, emitData->block);
     }
@@ -21665,6 +22409,132 @@ GlobOpt::InspectInstrForMemCopyCandidate(Loop* loop, IR::Instr* instr, MemCopyEm
     return false;
 }
 
+static bool
+IsMemvectorArrayValueType(const Loop::MemVectorCandidate* candidate, const ValueType arrayValueType)
+{
+    if (!arrayValueType.IsTypedArray())
+    {
+        return false;
+    }
+
+    switch (candidate->opcode)
+    {
+    case Js::OpCode::Add_I4:
+    case Js::OpCode::Sub_I4:
+        return arrayValueType.GetObjectType() == ObjectType::Int32Array;
+    default:
+        return arrayValueType.GetObjectType() == ObjectType::Float32Array;
+    }
+}
+
+bool
+GlobOpt::InspectInstrForMemVectorCandidate(Loop* loop, IR::Instr* instr, MemVectorEmitData* emitData, bool& errorInInstr)
+{
+    Assert(emitData && emitData->candidate && emitData->candidate->IsMemVector());
+    Loop::MemVectorCandidate* candidate = (Loop::MemVectorCandidate*)emitData->candidate;
+    if (instr->m_opcode == Js::OpCode::StElemI_A || instr->m_opcode == Js::OpCode::StElemI_A_Strict)
+    {
+        if (
+            !emitData->stElemInstr &&
+            instr->GetDst()->IsIndirOpnd() &&
+            (GetVarSymID(instr->GetDst()->AsIndirOpnd()->GetBaseOpnd()->GetStackSym()) == candidate->base) &&
+            (GetVarSymID(instr->GetDst()->AsIndirOpnd()->GetIndexOpnd()->GetStackSym()) == candidate->index)
+            )
+        {
+            Assert(instr->IsProfiledInstr());
+            if (!IsMemvectorArrayValueType(candidate, instr->GetDst()->AsIndirOpnd()->GetBaseOpnd()->GetValueType()))
+            {
+                TRACE_MEMOP_PHASE_VERBOSE(MemVector, loop, instr, _u("Store is not to a typed array of the arithmetic's type"));
+                errorInInstr = true;
+                return false;
+            }
+            emitData->stElemInstr = instr;
+            emitData->bailOutKind = instr->GetBailOutKind();
+            // Still need to find the arithmetic and the LdElems
+            return false;
+        }
+        TRACE_MEMOP_PHASE_VERBOSE(MemVector, loop, instr, _u("Orphan StElemI_A detected"));
+        errorInInstr = true;
+    }
+    else if (instr->m_opcode == Js::OpCode::LdElemI_A)
+    {
+        if (
+            emitData->arithInstr &&
+            instr->GetSrc1()->IsIndirOpnd() &&
+            (GetVarSymID(instr->GetSrc1()->AsIndirOpnd()->GetIndexOpnd()->GetStackSym()) == candidate->index)
+            )
+        {
+            SymID baseSymID = GetVarSymID(instr->GetSrc1()->AsIndirOpnd()->GetBaseOpnd()->GetStackSym());
+            for (int i = 0; i < 2; i++)
+            {
+                const Loop::MemVectorCandidate::Operand &operand = candidate->operands[i];
+                if (operand.ldBase != baseSymID || emitData->ldElemInstrs[i] || !instr->GetDst()->IsRegOpnd() ||
+                    instr->GetDst()->AsRegOpnd()->GetStackSym() != operand.transferSym)
+                {
+                    continue;
+                }
+
+                Assert(instr->IsProfiledInstr());
+                ValueType stValueType = emitData->stElemInstr->GetDst()->AsIndirOpnd()->GetBaseOpnd()->GetValueType();
+                ValueType ldValueType = instr->GetSrc1()->AsIndirOpnd()->GetBaseOpnd()->GetValueType();
+                if (stValueType != ldValueType)
+                {
+#if DBG_DUMP
+                    char16 stValueTypeStr[VALUE_TYPE_MAX_STRING_SIZE];
+                    stValueType.ToString(stValueTypeStr);
+                    char16 ldValueTypeStr[VALUE_TYPE_MAX_STRING_SIZE];
+                    ldValueType.ToString(ldValueTypeStr);
+                    TRACE_MEMOP_PHASE_VERBOSE(MemVector, loop, instr, _u("for mismatch in Load(%s) and Store(%s) value type"), ldValueTypeStr, stValueTypeStr);
+#endif
+                    errorInInstr = true;
+                    return false;
+                }
+                emitData->ldElemInstrs[i] = instr;
+
+                // We found all the instructions of this candidate once every loaded operand has its LdElem
+                return
+                    (candidate->operands[0].ldBase == Js::Constants::InvalidSymID || emitData->ldElemInstrs[0]) &&
+                    (candidate->operands[1].ldBase == Js::Constants::InvalidSymID || emitData->ldElemInstrs[1]);
+            }
+        }
+        TRACE_MEMOP_PHASE_VERBOSE(MemVector, loop, instr, _u("Orphan LdElemI_A detected"));
+        errorInInstr = true;
+    }
+    else if (emitData->stElemInstr && !emitData->arithInstr &&
+        instr->GetDst() && instr->GetDst()->IsRegOpnd() && instr->GetDst()->AsRegOpnd()->GetStackSym() == candidate->resultSym)
+    {
+        // An overflow bailout only gets the interpreter to compute the sum in double, which the store truncates the same way
+        if (instr->HasBailOutInfo() && (instr->GetBailOutKind() & ~IR::BailOutOnResultConditions))
+        {
+            TRACE_MEMOP_PHASE_VERBOSE(MemVector, loop, instr, _u("Arithmetic has a bailout"));
+            errorInInstr = true;
+            return false;
+        }
+        emitData->arithInstr = instr;
+    }
+    else if (emitData->stElemInstr)
+    {
+        // Conversions of the loaded or computed values would be left without their definitions
+        const auto IsCandidateSym = [&](IR::Opnd *opnd) -> bool
+        {
+            if (!opnd || !opnd->IsRegOpnd())
+            {
+                return false;
+            }
+            SymID symID = GetVarSymID(opnd->AsRegOpnd()->GetStackSym());
+            return symID == GetVarSymID(candidate->resultSym) ||
+                (candidate->operands[0].transferSym && symID == GetVarSymID(candidate->operands[0].transferSym)) ||
+                (candidate->operands[1].transferSym && symID == GetVarSymID(candidate->operands[1].transferSym));
+        };
+        if (IsCandidateSym(instr->GetDst()) || IsCandidateSym(instr->GetSrc1()) || IsCandidateSym(instr->GetSrc2()))
+        {
+            TRACE_MEMOP_PHASE_VERBOSE(MemVector, loop, instr, _u("Found other use of the arithmetic values"));
+            errorInInstr = true;
+        }
+    }
+    return false;
+}
+
 // The caller is responsible to free the memory allocated between inOrderEmitData[iEmitData -> end]
 bool
 GlobOpt::ValidateMemOpCandidates(Loop * loop, _Out_writes_(iEmitData) MemOpEmitData** inOrderEmitData, int& iEmitData)
@@ -21716,6 +22586,18 @@ GlobOpt::ValidateMemOpCandidates(Loop * loop, _Out_writes_(iEmitData) MemOpEmitD
                 Assert(!PHASE_OFF(Js::MemSetPhase, this->func));
                 emitData = JitAnew(this->alloc, MemSetEmitData);
             }
+            else if (candidate->IsMemVector())
+            {
+                Assert(!PHASE_OFF(Js::MemVectorPhase, this->func));
+                // The arithmetic can read the array it writes, running it a second time after another memop of the loop
+                // bailed out would change the result. Only accept it alone in its loop.
+                if (candidate->base == Js::Constants::InvalidSymID || loop->memOpInfo->candidates->Count() != 1)
+                {
+                    TRACE_MEMOP_PHASE(MemVector, loop, nullptr, _u("(s%d): no matching stElem or not alone in the loop"), candidate->base);
+                    return false;
+                }
+                emitData = JitAnew(this->alloc, MemVectorEmitData);
+            }
             else
             {
                 Assert(!PHASE_OFF(Js::MemCopyPhase, this->func));
@@ -21740,6 +22622,8 @@ GlobOpt::ValidateMemOpCandidates(Loop * loop, _Out_writes_(iEmitData) MemOpEmitD
         bool errorInInstr = false;
         bool candidateFound = candidate->IsMemSet() ?
             InspectInstrForMemSetCandidate(loop, instr, (MemSetEmitData*)emitData, errorInInstr)
+            : candidate->IsMemVector() ?
+            InspectInstrForMemVectorCandidate(loop, instr, (MemVectorEmitData*)emitData, errorInInstr)
             : InspectInstrForMemCopyCandidate(loop, instr, (MemCopyEmitData*)emitData, errorInInstr);
         if (errorInInstr)
         {
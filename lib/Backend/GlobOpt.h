@@ -1298,6 +1298,7 @@ private:
     void                    BackwardPass(Js::Phase tag);
     void                    ForwardPass();
     void                    OptLoops(Loop *loop);
+    void                    ScalarReplacementPass();
     void                    TailDupPass();
     bool                    TryTailDup(IR::BranchInstr *tailBranch);
     void                    CleanUpValueMaps();
@@ -1460,6 +1461,8 @@ private:
     bool                    CollectMemcopyStElementI(IR::Instr *, Loop *);
     bool                    CollectMemOpLdElementI(IR::Instr *, Loop *);
     bool                    CollectMemcopyLdElementI(IR::Instr *, Loop *);
+    bool                    CollectMemvectorStElementI(IR::Instr *, Loop *);
+    bool                    CollectMemvectorArithInstr(IR::Instr *, Loop *);
     SymID                   GetVarSymID(StackSym *);
     const InductionVariable* GetInductionVariable(SymID, Loop *);
     bool                    IsSymIDInductionVariable(SymID, Loop *);
@@ -1468,6 +1471,7 @@ private:
     void                    ProcessMemOp();
     bool                    InspectInstrForMemSetCandidate(Loop* loop, IR::Instr* instr, struct MemSetEmitData* emitData, bool& errorInInstr);
     bool                    InspectInstrForMemCopyCandidate(Loop* loop, IR::Instr* instr, struct MemCopyEmitData* emitData, bool& errorInInstr);
+    bool                    InspectInstrForMemVectorCandidate(Loop* loop, IR::Instr* instr, struct MemVectorEmitData* emitData, bool& errorInInstr);
     bool                    ValidateMemOpCandidates(Loop * loop, _Out_writes_(iEmitData) struct MemOpEmitData** emitData, int& iEmitData);
     void                    HoistHeadSegmentForMemOp(IR::Instr *instr, IR::ArrayRegOpnd *arrayRegOpnd, IR::Instr *insertBeforeInstr);
     void                    EmitMemop(Loop * loop, LoopCount *loopCount, const struct MemOpEmitData* emitData);
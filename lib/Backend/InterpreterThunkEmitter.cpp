@@ -3,6 +3,9 @@
 // Licensed under the MIT license. See LICENSE.txt file in the project root for full license information.
 //-------------------------------------------------------------------------------------------------------
 #include "Backend.h"
+#ifdef PERF_JIT_PROFILING
+#include "Base/PerfChakraProfile.h"
+#endif
 
 #ifdef ENABLE_NATIVE_CODEGEN
 #ifdef _M_X64
@@ -339,6 +342,9 @@ void InterpreterThunkEmitter::NewThunkBlock()
     block->SetPdata(pdataTable);
 #else
     Unused(block);
+#endif
+#ifdef PERF_JIT_PROFILING
+    PerfChakraProfile::LogInterpreterThunkLoadEvent(buffer, BlockSize, this->isAsmInterpreterThunk);
 #endif
     this->thunkBuffer = buffer;
 }
@@ -0,0 +1,383 @@
+//-------------------------------------------------------------------------------------------------------
+// Copyright (C) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE.txt file in the project root for full license information.
+//-------------------------------------------------------------------------------------------------------
+#include "Backend.h"
+
+void
+LoopUnroll::Optimize()
+{
+    if (!this->DoLoopUnroll())
+    {
+        return;
+    }
+
+    FOREACH_INSTR_IN_FUNC_EDITING(instr, instrNext, this->func)
+    {
+        if (!instr->IsLabelInstr() || !instr->AsLabelInstr()->m_isLoopTop)
+        {
+            continue;
+        }
+
+        IR::LabelInstr * loopTop = instr->AsLabelInstr();
+        CountedLoop countedLoop;
+        if (this->IsProfitableLoop(loopTop) && this->FindCountedLoop(loopTop, &countedLoop))
+        {
+            // Resume after the original loop, it is now the remainder loop
+            instrNext = this->Unroll(countedLoop);
+        }
+    }
+    NEXT_INSTR_IN_FUNC_EDITING;
+}
+
+bool
+LoopUnroll::DoLoopUnroll() const
+{
+    // Without the globopt the loops aren't type specialized, there is no int32 induction variable to find.
+    // Try regions and generators have loop entries other than the loop top.
+    return
+        !PHASE_OFF(Js::LoopUnrollPhase, this->func) &&
+        this->unrollFactor > 1 &&
+        this->func->DoGlobOpt() &&
+        !this->func->HasTry() &&
+        !this->func->IsJitInDebugMode() &&
+        !this->func->GetJITFunctionBody()->IsCoroutine();
+}
+
+bool
+LoopUnroll::IsProfitableLoop(IR::LabelInstr * loopTop) const
+{
+    if (PHASE_FORCE(Js::LoopUnrollPhase, this->func))
+    {
+        return true;
+    }
+
+    return Loop::IsWorthDuplicating(loopTop->GetLoop()->GetLoopFlags());
+}
+
+bool
+LoopUnroll::FindCountedLoop(IR::LabelInstr * loopTop, CountedLoop * countedLoop) const
+{
+    //  $loopTop:
+    //      Br<exit>_I4 $loopExit, i, bound     ; bound is a constant or isn't defined in the loop
+    //      ...                                 ; straight line, i = Add_I4 i, 1 is the only def of i
+    //      Br $loopTop
+
+    Loop * loop = loopTop->GetLoop();
+    if (loopTop->labelRefs.Count() != 1 || loopTop->m_hasNonBranchRef || loop->regAlloc.liveOnBackEdgeSyms == nullptr)
+    {
+        return false;
+    }
+
+    IR::BranchInstr * loopTail = loopTop->labelRefs.Head();
+    if (loopTail->m_opcode != Js::OpCode::Br)
+    {
+        return false;
+    }
+
+    IR::Instr * instr = loopTop->m_next;
+    while (instr->IsPragmaInstr())
+    {
+        instr = instr->m_next;
+    }
+
+    if (!instr->IsBranchInstr() || instr->HasBailOutInfo() || instr->AsBranchInstr()->GetTarget() == loopTop)
+    {
+        return false;
+    }
+
+    // Normalize the test to exit when i >= bound or i > bound
+    IR::BranchInstr * exitBranch = instr->AsBranchInstr();
+    IR::Opnd * inductionOpnd;
+    IR::Opnd * boundOpnd;
+    switch (exitBranch->m_opcode)
+    {
+    case Js::OpCode::BrGe_I4:
+    case Js::OpCode::BrGt_I4:
+        countedLoop->exitOpcode = exitBranch->m_opcode;
+        inductionOpnd = exitBranch->GetSrc1();
+        boundOpnd = exitBranch->GetSrc2();
+        break;
+
+    case Js::OpCode::BrLe_I4:
+        countedLoop->exitOpcode = Js::OpCode::BrGe_I4;
+        inductionOpnd = exitBranch->GetSrc2();
+        boundOpnd = exitBranch->GetSrc1();
+        break;
+
+    case Js::OpCode::BrLt_I4:
+        countedLoop->exitOpcode = Js::OpCode::BrGt_I4;
+        inductionOpnd = exitBranch->GetSrc2();
+        boundOpnd = exitBranch->GetSrc1();
+        break;
+
+    default:
+        return false;
+    }
+
+    if (!inductionOpnd->IsRegOpnd() || inductionOpnd->GetType() != TyInt32 || boundOpnd->GetType() != TyInt32)
+    {
+        return false;
+    }
+
+    StackSym * inductionSym = inductionOpnd->AsRegOpnd()->m_sym;
+    StackSym * boundSym = nullptr;
+    int32 boundValue = 0;
+    if (boundOpnd->IsRegOpnd())
+    {
+        boundSym = boundOpnd->AsRegOpnd()->m_sym;
+        if (boundSym == inductionSym)
+        {
+            return false;
+        }
+    }
+    else if (boundOpnd->IsIntConstOpnd())
+    {
+        // The unrolled loop is never entered if bound - (factor - 1) is out of range
+        boundValue = boundOpnd->AsIntConstOpnd()->AsInt32();
+        if ((int64)boundValue - (int64)(this->unrollFactor - 1) < INT32_MIN)
+        {
+            return false;
+        }
+    }
+    else
+    {
+        return false;
+    }
+
+    // Registers are only written by the instructions that define them at this point. In iteration k of
+    // the group, i is its value at the start of the group plus k, so a single test of i + factor - 1
+    // stands for the tests of all the iterations of the group.
+    uint instrCount = 0;
+    uint incrementCount = 0;
+    for (instr = exitBranch->m_next; instr != loopTail; instr = instr->m_next)
+    {
+        if (instr->IsPragmaInstr())
+        {
+            continue;
+        }
+
+        if (!this->CanCopyInstr(instr))
+        {
+            return false;
+        }
+
+        if (instr->IsRealInstr() && ++instrCount > (uint)CONFIG_FLAG(LoopUnrollMaxInstrCount))
+        {
+            return false;
+        }
+
+        IR::Opnd * dst = instr->GetDst();
+        StackSym * dstSym = dst ? dst->GetStackSym() : nullptr;
+        if (dstSym == nullptr)
+        {
+            continue;
+        }
+
+        if (dstSym == boundSym)
+        {
+            return false;
+        }
+
+        if (dstSym == inductionSym && (!IsIncrement(instr, inductionSym) || ++incrementCount > 1))
+        {
+            return false;
+        }
+    }
+
+    if (incrementCount != 1)
+    {
+        return false;
+    }
+
+    countedLoop->loopTop = loopTop;
+    countedLoop->exitBranch = exitBranch;
+    countedLoop->loopTail = loopTail;
+    countedLoop->inductionSym = inductionSym;
+    countedLoop->boundSym = boundSym;
+    countedLoop->boundValue = boundValue;
+    return true;
+}
+
+bool
+LoopUnroll::CanCopyInstr(IR::Instr * instr) const
+{
+    // The copies would share the bailout record of the original, which the lowerer only supports for
+    // a few kinds of bailouts. Labels and branches would give the body more than one path.
+    if (instr->HasBailOutInfo() || instr->HasAuxBailOut())
+    {
+        return false;
+    }
+
+    switch (instr->GetKind())
+    {
+    case IR::InstrKindInstr:
+    case IR::InstrKindProfiled:
+        break;
+
+    default:
+        return false;
+    }
+
+    // Inlinee frames and argument slots have a single def
+    if (instr->m_func != this->func || OpCodeAttr::CallInstr(instr->m_opcode))
+    {
+        return false;
+    }
+
+    switch (instr->m_opcode)
+    {
+    case Js::OpCode::StartCall:
+    case Js::OpCode::InlineeStart:
+    case Js::OpCode::InlineeEnd:
+        return false;
+
+    default:
+        break;
+    }
+
+    IR::Opnd * dst = instr->GetDst();
+    StackSym * dstSym = dst ? dst->GetStackSym() : nullptr;
+    if (dstSym && dstSym->IsArgSlotSym())
+    {
+        return false;
+    }
+
+    return
+        !(instr->GetSrc1() && instr->GetSrc1()->IsLabelOpnd()) &&
+        !(instr->GetSrc2() && instr->GetSrc2()->IsLabelOpnd());
+}
+
+bool
+LoopUnroll::IsIncrement(IR::Instr * instr, StackSym * inductionSym)
+{
+    if (instr->m_opcode != Js::OpCode::Add_I4)
+    {
+        return false;
+    }
+
+    IR::Opnd * src1 = instr->GetSrc1();
+    IR::Opnd * src2 = instr->GetSrc2();
+    if (src1->IsIntConstOpnd())
+    {
+        IR::Opnd * swap = src1;
+        src1 = src2;
+        src2 = swap;
+    }
+
+    return
+        src1->IsRegOpnd() && src1->AsRegOpnd()->m_sym == inductionSym &&
+        src2->IsIntConstOpnd() && src2->AsIntConstOpnd()->GetValue() == 1;
+}
+
+IR::Instr *
+LoopUnroll::Unroll(const CountedLoop &countedLoop)
+{
+    //      BrLt_I4 $remainder, bound, INT32_MIN + factor - 1   ; only if the bound isn't a constant
+    //      limit = Sub_I4 bound, factor - 1
+    //      Br<exit>_I4 $remainder, i, limit
+    //  $unrolledTop:
+    //      ...                                                 ; factor copies of the loop body
+    //      Br<!exit>_I4 $unrolledTop, i, limit
+    //  $remainder:
+    //  $loopTop:                                               ; the original loop, runs what is left
+    //      Br<exit>_I4 $loopExit, i, bound
+    //      ...
+    //      Br $loopTop
+    //  $loopExit:
+
+    Func * func = this->func;
+    IR::LabelInstr * loopTop = countedLoop.loopTop;
+    IR::BranchInstr * loopTail = countedLoop.loopTail;
+    Loop * loop = loopTop->GetLoop();
+
+#if DBG_DUMP
+    if (PHASE_TRACE(Js::LoopUnrollPhase, func))
+    {
+        char16 debugStringBuffer[MAX_FUNCTION_BODY_DEBUG_STRING_SIZE];
+        Output::Print(_u("LoopUnroll: function %s (%s), loop at 0x%04x, unrolled %u times\n"),
+            func->GetJITFunctionBody()->GetDisplayName(), func->GetDebugNumberSet(debugStringBuffer),
+            loopTop->GetByteCodeOffset(), this->unrollFactor);
+        Output::Flush();
+    }
+#endif
+#if ENABLE_DEBUG_CONFIG_OPTIONS
+    if (PHASE_TESTTRACE(Js::LoopUnrollPhase, func))
+    {
+        char16 debugStringBuffer[MAX_FUNCTION_BODY_DEBUG_STRING_SIZE];
+        Output::Print(_u("Testtrace: LoopUnroll function %s (%s): unrolled %u times\n"),
+            func->GetJITFunctionBody()->GetDisplayName(), func->GetDebugNumberSet(debugStringBuffer), this->unrollFactor);
+        Output::Flush();
+    }
+#endif
+
+    IR::LabelInstr * remainderLabel = IR::LabelInstr::New(Js::OpCode::Label, func);
+    remainderLabel->SetByteCodeOffset(loopTop);
+
+    // The remainder label falls through to the loop top, so the lowerer's landing pad for the original
+    // loop is run on both paths.
+    IR::Opnd * limitOpnd;
+    if (countedLoop.boundSym)
+    {
+        IR::BranchInstr * brNoGroup = IR::BranchInstr::New(Js::OpCode::BrLt_I4, remainderLabel,
+            IR::RegOpnd::New(countedLoop.boundSym, TyInt32, func),
+            IR::IntConstOpnd::New(INT32_MIN + (int32)(this->unrollFactor - 1), TyInt32, func), func);
+        brNoGroup->SetByteCodeOffset(loopTop);
+        loopTop->InsertBefore(brNoGroup);
+
+        limitOpnd = IR::RegOpnd::New(TyInt32, func);
+        IR::Instr * ldLimit = IR::Instr::New(Js::OpCode::Sub_I4, limitOpnd,
+            IR::RegOpnd::New(countedLoop.boundSym, TyInt32, func),
+            IR::IntConstOpnd::New(this->unrollFactor - 1, TyInt32, func), func);
+        ldLimit->SetByteCodeOffset(loopTop);
+        loopTop->InsertBefore(ldLimit);
+    }
+    else
+    {
+        limitOpnd = IR::IntConstOpnd::New(countedLoop.boundValue - (int32)(this->unrollFactor - 1), TyInt32, func);
+    }
+
+    IR::BranchInstr * guardInstr = IR::BranchInstr::New(countedLoop.exitOpcode, remainderLabel,
+        IR::RegOpnd::New(countedLoop.inductionSym, TyInt32, func), limitOpnd->Copy(func), func);
+    guardInstr->SetByteCodeOffset(loopTop);
+    loopTop->InsertBefore(guardInstr);
+
+    // Same loop nest and same live syms as the original loop, plus the limit
+    IR::LabelInstr * unrolledTop = IR::LabelInstr::New(Js::OpCode::Label, func);
+    unrolledTop->SetByteCodeOffset(loopTop);
+    unrolledTop->m_isLoopTop = true;
+
+    Loop * unrolledLoop = JitAnew(func->m_alloc, Loop, func->m_alloc, func);
+    unrolledLoop->parent = loop->parent;
+    unrolledLoop->SetLoopFlags(loop->GetLoopFlags());
+    unrolledTop->SetLoop(unrolledLoop);
+    unrolledLoop->SetLoopTopInstr(unrolledTop);
+    unrolledLoop->regAlloc.liveOnBackEdgeSyms = loop->regAlloc.liveOnBackEdgeSyms->CopyNew(func->m_alloc);
+    if (limitOpnd->IsRegOpnd())
+    {
+        unrolledLoop->regAlloc.liveOnBackEdgeSyms->Set(limitOpnd->AsRegOpnd()->m_sym->m_id);
+    }
+    loopTop->InsertBefore(unrolledTop);
+
+    // Copies of single-def syms become multi-def when the dst is set
+    for (uint i = 0; i < this->unrollFactor; i++)
+    {
+        for (IR::Instr * instr = countedLoop.exitBranch->m_next; instr != loopTail; instr = instr->m_next)
+        {
+            if (!instr->IsPragmaInstr())
+            {
+                loopTop->InsertBefore(instr->Copy());
+            }
+        }
+    }
+
+    IR::BranchInstr * backEdge = IR::BranchInstr::New(countedLoop.exitOpcode, unrolledTop,
+        IR::RegOpnd::New(countedLoop.inductionSym, TyInt32, func), limitOpnd->Copy(func), func);
+    backEdge->Invert();
+    backEdge->SetByteCodeOffset(loopTail);
+    loopTop->InsertBefore(backEdge);
+
+    loopTop->InsertBefore(remainderLabel);
+
+    return loopTail->m_next;
+}
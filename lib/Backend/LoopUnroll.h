@@ -0,0 +1,44 @@
+//-------------------------------------------------------------------------------------------------------
+// Copyright (C) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE.txt file in the project root for full license information.
+//-------------------------------------------------------------------------------------------------------
+#pragma once
+
+//
+// Unrolls small counted loops: an int32 induction variable incremented by one, tested against a loop
+// invariant bound at the loop top. An unrolled copy of the loop runs the iterations in groups, testing
+// the bound once per group, and the original loop runs the remaining iterations.
+//
+// Runs on the linear IR between the globopt and the lowerer, once the loops are type specialized and
+// the induction variable and its bound are int32 syms.
+//
+class LoopUnroll
+{
+public:
+    LoopUnroll(Func * func) : func(func), unrollFactor(CONFIG_FLAG(LoopUnrollFactor)) {}
+
+    void                Optimize();
+
+private:
+    struct CountedLoop
+    {
+        IR::LabelInstr *    loopTop;
+        IR::BranchInstr *   exitBranch;     // Br<exit>_I4 $loopExit, i, bound
+        IR::BranchInstr *   loopTail;       // Br $loopTop
+        Js::OpCode          exitOpcode;     // BrGe_I4 or BrGt_I4, with the induction variable as src1
+        StackSym *          inductionSym;
+        StackSym *          boundSym;       // nullptr if the bound is a constant
+        int32               boundValue;
+    };
+
+    bool                DoLoopUnroll() const;
+    bool                IsProfitableLoop(IR::LabelInstr * loopTop) const;
+    bool                FindCountedLoop(IR::LabelInstr * loopTop, CountedLoop * countedLoop) const;
+    bool                CanCopyInstr(IR::Instr * instr) const;
+    static bool         IsIncrement(IR::Instr * instr, StackSym * inductionSym);
+    IR::Instr *         Unroll(const CountedLoop &countedLoop);
+
+private:
+    Func *              func;
+    uint                unrollFactor;
+};
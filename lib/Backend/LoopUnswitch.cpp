@@ -0,0 +1,382 @@
+//-------------------------------------------------------------------------------------------------------
+// Copyright (C) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE.txt file in the project root for full license information.
+//-------------------------------------------------------------------------------------------------------
+#include "Backend.h"
+
+void
+LoopUnswitch::Optimize()
+{
+    if (!this->DoLoopUnswitch())
+    {
+        return;
+    }
+
+    NoRecoverMemoryJitArenaAllocator localAlloc(_u("BE-LoopUnswitch"), this->func->m_alloc->GetPageAllocator(), Js::Throw::OutOfMemory);
+    this->alloc = &localAlloc;
+
+    FOREACH_INSTR_IN_FUNC_EDITING(instr, instrNext, this->func)
+    {
+        if (this->unswitchCount >= (uint)CONFIG_FLAG(LoopUnswitchMaxLoopCount))
+        {
+            break;
+        }
+
+        if (!instr->IsLabelInstr() || !instr->AsLabelInstr()->m_isLoopTop)
+        {
+            continue;
+        }
+
+        IR::LabelInstr * loopTop = instr->AsLabelInstr();
+        if (!this->IsProfitableLoop(loopTop))
+        {
+            continue;
+        }
+
+        IR::BranchInstr * loopTail = this->GetInnermostLoopTail(loopTop);
+        if (loopTail == nullptr || !this->CanCloneLoop(loopTop, loopTail))
+        {
+            continue;
+        }
+
+        IR::BranchInstr * branchInstr = this->FindInvariantBranch(loopTop, loopTail);
+        if (branchInstr != nullptr)
+        {
+            // Resume after both copies of the loop
+            instrNext = this->Unswitch(loopTop, loopTail, branchInstr);
+        }
+    }
+    NEXT_INSTR_IN_FUNC_EDITING;
+
+    this->alloc = nullptr;
+}
+
+bool
+LoopUnswitch::DoLoopUnswitch() const
+{
+    // Without profile info there is no telling whether the loop is hot. Loop bodies, try regions and
+    // generators have loop entries and exits other than the loop top and the branches in the loop.
+    return
+        !PHASE_OFF(Js::LoopUnswitchPhase, this->func) &&
+        this->func->DoGlobOpt() &&
+        this->func->HasProfileInfo() &&
+        !this->func->HasTry() &&
+        !this->func->IsLoopBody() &&
+        !this->func->IsJitInDebugMode() &&
+        !this->func->GetJITFunctionBody()->IsAsmJsMode() &&
+        !this->func->GetJITFunctionBody()->IsCoroutine();
+}
+
+bool
+LoopUnswitch::IsProfitableLoop(IR::LabelInstr * loopTop) const
+{
+    if (PHASE_FORCE(Js::LoopUnswitchPhase, this->func))
+    {
+        return true;
+    }
+
+    if (!loopTop->IsProfiledLabelInstr())
+    {
+        return false;
+    }
+
+    return Loop::IsWorthDuplicating(loopTop->AsProfiledLabelInstr()->loopFlags);
+}
+
+IR::BranchInstr *
+LoopUnswitch::GetInnermostLoopTail(IR::LabelInstr * loopTop) const
+{
+    // The loop is the range from the loop top to its last back edge. Every reference to the loop top
+    // has to be a back edge, so that a test inserted before the loop top is run before the loop.
+    uint backEdgeCount = loopTop->labelRefs.Count();
+    if (backEdgeCount == 0 || loopTop->m_hasNonBranchRef)
+    {
+        return nullptr;
+    }
+
+    uint instrCount = 0;
+    FOREACH_INSTR_IN_RANGE(instr, loopTop->m_next, nullptr)
+    {
+        if (instr->IsLabelInstr() && instr->AsLabelInstr()->m_isLoopTop)
+        {
+            // Nested loop, or references to the loop top from before it
+            return nullptr;
+        }
+
+        if (instr->IsRealInstr() && ++instrCount > (uint)CONFIG_FLAG(LoopUnswitchMaxInstrCount))
+        {
+            return nullptr;
+        }
+
+        if (instr->IsBranchInstr() && !instr->AsBranchInstr()->IsMultiBranch() && instr->AsBranchInstr()->GetTarget() == loopTop)
+        {
+            if (--backEdgeCount == 0)
+            {
+                return instr->AsBranchInstr();
+            }
+        }
+    }
+    NEXT_INSTR_IN_RANGE;
+
+    return nullptr;
+}
+
+bool
+LoopUnswitch::CanCloneLoop(IR::LabelInstr * loopTop, IR::BranchInstr * loopTail) const
+{
+    // The labels in the loop may only be targeted from the loop, otherwise the clone would have other
+    // entries than its loop top. Count the references to the labels in the loop, then take away the
+    // branches of the loop that target them.
+    BVSparse<JitArenaAllocator> labelsInLoop(this->alloc);
+    uint refCount = 0;
+
+    FOREACH_INSTR_IN_RANGE(instr, loopTop, loopTail)
+    {
+        if (instr->HasBailOutInfo() || instr->HasAuxBailOut())
+        {
+            // BailOnNoProfile and the like. A path of the loop has never run, the globopt already
+            // keeps it out of the type specialization of the loop.
+            return false;
+        }
+
+        switch (instr->GetKind())
+        {
+        case IR::InstrKindInstr:
+        case IR::InstrKindProfiled:
+        case IR::InstrKindPragma:
+            break;
+
+        case IR::InstrKindLabel:
+        case IR::InstrKindProfiledLabel:
+            if (instr->AsLabelInstr()->m_hasNonBranchRef)
+            {
+                return false;
+            }
+            labelsInLoop.Set(instr->AsLabelInstr()->m_id);
+            refCount += instr->AsLabelInstr()->labelRefs.Count();
+            break;
+
+        case IR::InstrKindBranch:
+            if (instr->AsBranchInstr()->IsMultiBranch() || instr->AsBranchInstr()->m_isOrphanedLeave)
+            {
+                return false;
+            }
+            break;
+
+        default:
+            // Not supported by the cloner
+            return false;
+        }
+    }
+    NEXT_INSTR_IN_RANGE;
+
+    FOREACH_INSTR_IN_RANGE(instr, loopTop, loopTail)
+    {
+        if (instr->IsBranchInstr() && labelsInLoop.Test(instr->AsBranchInstr()->GetTarget()->m_id))
+        {
+            refCount--;
+        }
+    }
+    NEXT_INSTR_IN_RANGE;
+
+    return refCount == 0;
+}
+
+IR::BranchInstr *
+LoopUnswitch::FindInvariantBranch(IR::LabelInstr * loopTop, IR::BranchInstr * loopTail) const
+{
+    // Registers are only written by the instructions that define them at this point, a sym that isn't
+    // defined in the loop has the same value in every iteration.
+    BVSparse<JitArenaAllocator> loopDefs(this->alloc);
+    FOREACH_INSTR_IN_RANGE(instr, loopTop, loopTail)
+    {
+        IR::Opnd * dst = instr->GetDst();
+        StackSym * dstSym = dst ? dst->GetStackSym() : nullptr;
+        if (dstSym)
+        {
+            loopDefs.Set(dstSym->m_id);
+        }
+    }
+    NEXT_INSTR_IN_RANGE;
+
+    FOREACH_INSTR_IN_RANGE(instr, loopTop->m_next, loopTail->m_prev)
+    {
+        if (instr->IsBranchInstr() &&
+            instr->AsBranchInstr()->GetTarget() != loopTop &&
+            this->IsInvariantBranch(instr->AsBranchInstr(), &loopDefs))
+        {
+            return instr->AsBranchInstr();
+        }
+    }
+    NEXT_INSTR_IN_RANGE;
+
+    return nullptr;
+}
+
+bool
+LoopUnswitch::IsInvariantBranch(IR::BranchInstr * branchInstr, BVSparse<JitArenaAllocator> * loopDefs) const
+{
+    // The condition is tested before the loop, even if the loop would have exited before reaching the
+    // branch. That is only correct for tests without implicit calls.
+    bool needsConstant;
+    switch (branchInstr->m_opcode)
+    {
+    case Js::OpCode::BrTrue_A:
+    case Js::OpCode::BrFalse_A:
+    case Js::OpCode::BrOnObject_A:
+    case Js::OpCode::BrNotNull_A:
+        needsConstant = false;
+        break;
+
+    case Js::OpCode::BrSrEq_A:
+    case Js::OpCode::BrSrNeq_A:
+        // Strict equality of two host objects may call the host
+        needsConstant = true;
+        break;
+
+    default:
+        return false;
+    }
+
+    bool hasConstant = false;
+    bool hasVariable = false;
+    auto isInvariant = [&](IR::Opnd * src) -> bool
+    {
+        if (src == nullptr)
+        {
+            return true;
+        }
+        if (src->IsImmediateOpnd())
+        {
+            hasConstant = true;
+            return true;
+        }
+        if (!src->IsRegOpnd())
+        {
+            return false;
+        }
+
+        StackSym * sym = src->AsRegOpnd()->m_sym;
+        if (sym->IsFromByteCodeConstantTable())
+        {
+            hasConstant = true;
+        }
+        else
+        {
+            hasVariable = true;
+        }
+        return !loopDefs->Test(sym->m_id);
+    };
+
+    return isInvariant(branchInstr->GetSrc1()) && isInvariant(branchInstr->GetSrc2()) &&
+        hasVariable && (hasConstant || !needsConstant);
+}
+
+IR::Instr *
+LoopUnswitch::Unswitch(IR::LabelInstr * loopTop, IR::BranchInstr * loopTail, IR::BranchInstr * branchInstr)
+{
+    //      Br<cond> $loopTopTaken              ; guard
+    //  $loopTop:                               ; branch removed, always falls through
+    //      ...
+    //      Br<tail> $loopTop
+    //      Br $loopExit                        ; only if the loop tail falls through
+    //  $loopTopTaken:                          ; branch replaced by Br, always taken
+    //      ...
+    //      Br<tail> $loopTopTaken
+    //  $loopExit:
+
+#if DBG_DUMP
+    if (PHASE_TRACE(Js::LoopUnswitchPhase, this->func))
+    {
+        char16 debugStringBuffer[MAX_FUNCTION_BODY_DEBUG_STRING_SIZE];
+        Output::Print(_u("LoopUnswitch: function %s (%s), loop at 0x%04x, unswitched on %s at 0x%04x\n"),
+            this->func->GetJITFunctionBody()->GetDisplayName(), this->func->GetDebugNumberSet(debugStringBuffer),
+            loopTop->GetByteCodeOffset(), Js::OpCodeUtil::GetOpCodeName(branchInstr->m_opcode), branchInstr->GetByteCodeOffset());
+        Output::Flush();
+    }
+#endif
+#if ENABLE_DEBUG_CONFIG_OPTIONS
+    if (PHASE_TESTTRACE(Js::LoopUnswitchPhase, this->func))
+    {
+        char16 debugStringBuffer[MAX_FUNCTION_BODY_DEBUG_STRING_SIZE];
+        Output::Print(_u("Testtrace: LoopUnswitch function %s (%s): unswitched on %s\n"),
+            this->func->GetJITFunctionBody()->GetDisplayName(), this->func->GetDebugNumberSet(debugStringBuffer),
+            Js::OpCodeUtil::GetOpCodeName(branchInstr->m_opcode));
+        Output::Flush();
+    }
+#endif
+
+    IR::Instr * instrAfterLoop = loopTail->m_next;
+    IR::BranchInstr * branchClone = nullptr;
+
+    // Clone the loop after its tail. Arg out and StartCall syms get new syms, the other syms are shared
+    // and become multi-def. Branches to labels of the loop are retargeted when the clone is done.
+    this->func->BeginClone(nullptr, this->func->m_alloc);
+    this->func->GetCloner()->clonedInstrGetOrigArgSlotSym = false;
+
+    IR::Instr * instrInsert = loopTail;
+    for (IR::Instr * instr = loopTop; ; instr = instr->m_next)
+    {
+        IR::Instr * instrClone = instr->Clone();
+        instrInsert->InsertAfter(instrClone);
+        instrInsert = instrClone;
+
+        // Not carried over by the cloner
+        if (instr->IsPragmaInstr())
+        {
+            instrClone->AsPragmaInstr()->m_statementIndex = instr->AsPragmaInstr()->m_statementIndex;
+        }
+        else if (instr->IsBranchInstr())
+        {
+            instrClone->AsBranchInstr()->m_isSwitchBr = instr->AsBranchInstr()->m_isSwitchBr;
+            instrClone->AsBranchInstr()->SetByteCodeReg(instr->AsBranchInstr()->GetByteCodeReg());
+            if (instr == branchInstr)
+            {
+                branchClone = instrClone->AsBranchInstr();
+            }
+        }
+
+        if (instr == loopTail)
+        {
+            break;
+        }
+    }
+
+    this->func->EndClone();
+
+    IR::LabelInstr * loopTopClone = loopTail->m_next->AsLabelInstr();
+    Assert(loopTopClone->m_isLoopTop);
+    Assert(branchClone);
+
+    if (loopTail->IsConditional())
+    {
+        IR::LabelInstr * loopExit = IR::LabelInstr::New(Js::OpCode::Label, this->func);
+        loopExit->SetByteCodeOffset(instrAfterLoop);
+        instrAfterLoop->InsertBefore(loopExit);
+
+        IR::BranchInstr * brExit = IR::BranchInstr::New(Js::OpCode::Br, loopExit, this->func);
+        brExit->SetByteCodeOffset(loopTail);
+        loopTail->InsertAfter(brExit);
+    }
+
+    IR::BranchInstr * guardInstr = IR::BranchInstr::New(branchInstr->m_opcode, loopTopClone, branchInstr->GetSrc1()->Copy(this->func), this->func);
+    if (branchInstr->GetSrc2())
+    {
+        guardInstr->SetSrc2(branchInstr->GetSrc2()->Copy(this->func));
+    }
+    guardInstr->SetByteCodeOffset(loopTop);
+    loopTop->InsertBefore(guardInstr);
+
+    branchInstr->Remove();
+
+    branchClone->m_opcode = Js::OpCode::Br;
+    branchClone->FreeSrc1();
+    if (branchClone->GetSrc2())
+    {
+        branchClone->FreeSrc2();
+    }
+
+    this->unswitchCount++;
+
+    return instrAfterLoop;
+}
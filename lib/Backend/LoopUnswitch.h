@@ -0,0 +1,35 @@
+//-------------------------------------------------------------------------------------------------------
+// Copyright (C) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE.txt file in the project root for full license information.
+//-------------------------------------------------------------------------------------------------------
+#pragma once
+
+//
+// Duplicates an innermost loop that contains a branch on a loop invariant condition, and selects the
+// copy with a single test of the condition before the loop. In each copy the branch always goes the
+// same way, so the forward pass type specializes and hoists the copies independently.
+//
+// Runs on the linear IR between the IRBuilder and the inliner: a call site in the loop is inlined in
+// both copies, and the flow graph finds the copies as two separate loops.
+//
+class LoopUnswitch
+{
+public:
+    LoopUnswitch(Func * func) : func(func), alloc(nullptr), unswitchCount(0) {}
+
+    void                Optimize();
+
+private:
+    bool                DoLoopUnswitch() const;
+    bool                IsProfitableLoop(IR::LabelInstr * loopTop) const;
+    IR::BranchInstr *   GetInnermostLoopTail(IR::LabelInstr * loopTop) const;
+    bool                CanCloneLoop(IR::LabelInstr * loopTop, IR::BranchInstr * loopTail) const;
+    IR::BranchInstr *   FindInvariantBranch(IR::LabelInstr * loopTop, IR::BranchInstr * loopTail) const;
+    bool                IsInvariantBranch(IR::BranchInstr * branchInstr, BVSparse<JitArenaAllocator> * loopDefs) const;
+    IR::Instr *         Unswitch(IR::LabelInstr * loopTop, IR::BranchInstr * loopTail, IR::BranchInstr * branchInstr);
+
+private:
+    Func *              func;
+    JitArenaAllocator * alloc;
+    uint                unswitchCount;
+};
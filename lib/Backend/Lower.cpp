@@ -1565,6 +1565,7 @@ Lowerer::LowerRange(IR::Instr *instrStart, IR::Instr *instrEnd, bool defaultDoFa
 
         case Js::OpCode::Memset:
         case Js::OpCode::Memcopy:
+        case Js::OpCode::Memvector:
         {
             instrPrev = LowerMemOp(instr);
             break;
@@ -9003,10 +9004,71 @@ Lowerer::LowerMemcopy(IR::Instr * instr, IR::RegOpnd * helperRet)
     return nullptr;
 }
 
+IR::Instr *
+Lowerer::LowerMemvector(IR::Instr * instr, IR::RegOpnd * helperRet)
+{
+    IR::Opnd * dst = instr->UnlinkDst();
+    IR::Opnd * linkOpnd = instr->UnlinkSrc1();
+    IR::Opnd * sizeOpnd = instr->UnlinkSrc2();
+
+    Assert(dst->IsIndirOpnd());
+    IR::Opnd *baseOpnd = dst->AsIndirOpnd()->UnlinkBaseOpnd();
+    IR::Opnd *indexOpnd = dst->AsIndirOpnd()->UnlinkIndexOpnd();
+
+    Assert(baseOpnd);
+    Assert(sizeOpnd);
+    Assert(indexOpnd);
+
+    // The arithmetic opcode and the two sources are chained before the instruction:
+    //     s1 = ExtendArg_A src2
+    //     s2 = ExtendArg_A src1, s1
+    //     s3 = ExtendArg_A opcode, s2
+    //     Memvector [base + index], s3, size
+    // Each source is either a typed array or a number. The ExtendArg_A instructions are removed when we reach them.
+    IR::Instr *opcodeArg = linkOpnd->AsRegOpnd()->m_sym->m_instrDef;
+    Assert(opcodeArg->m_opcode == Js::OpCode::ExtendArg_A);
+    IR::Instr *src1Arg = opcodeArg->GetSrc2()->AsRegOpnd()->m_sym->m_instrDef;
+    Assert(src1Arg->m_opcode == Js::OpCode::ExtendArg_A);
+    IR::Instr *src2Arg = src1Arg->GetSrc2()->AsRegOpnd()->m_sym->m_instrDef;
+    Assert(src2Arg->m_opcode == Js::OpCode::ExtendArg_A);
+    Assert(src2Arg->GetSrc2() == nullptr);
+
+    IR::Instr *instrPrev = nullptr;
+    const auto ToVarSrc = [&](IR::Opnd *src) -> IR::Opnd *
+    {
+        if (src->IsRegOpnd() && !src->IsVar())
+        {
+            IR::RegOpnd* varOpnd = IR::RegOpnd::New(TyVar, instr->m_func);
+            instrPrev = IR::Instr::New(Js::OpCode::ToVar, varOpnd, src, instr->m_func);
+            instr->InsertBefore(instrPrev);
+            return varOpnd;
+        }
+        return src;
+    };
+    IR::Opnd *src2 = ToVarSrc(src2Arg->GetSrc1());
+    IR::Opnd *src1 = ToVarSrc(src1Arg->GetSrc1());
+
+    IR::JnHelperMethod helperMethod = IR::HelperOp_Memvector;
+
+    instr->SetDst(helperRet);
+    LoadScriptContext(instr);
+    m_lowererMD.LoadHelperArgument(instr, opcodeArg->GetSrc1());
+    m_lowererMD.LoadHelperArgument(instr, sizeOpnd);
+    m_lowererMD.LoadHelperArgument(instr, src2);
+    m_lowererMD.LoadHelperArgument(instr, src1);
+    m_lowererMD.LoadHelperArgument(instr, indexOpnd);
+    m_lowererMD.LoadHelperArgument(instr, baseOpnd);
+    m_lowererMD.ChangeToHelperCall(instr, helperMethod);
+    dst->Free(m_func);
+    linkOpnd->Free(m_func);
+
+    return instrPrev;
+}
+
 IR::Instr *
 Lowerer::LowerMemOp(IR::Instr * instr)
 {
-    Assert(instr->m_opcode == Js::OpCode::Memset || instr->m_opcode == Js::OpCode::Memcopy);
+    Assert(instr->m_opcode == Js::OpCode::Memset || instr->m_opcode == Js::OpCode::Memcopy || instr->m_opcode == Js::OpCode::Memvector);
     IR::Instr *instrPrev = instr->m_prev;
 
     IR::RegOpnd* helperRet = IR::RegOpnd::New(TyInt8, instr->m_func);
@@ -9072,6 +9134,10 @@ Lowerer::LowerMemOp(IR::Instr * instr)
     {
         newInstrPrev = LowerMemcopy(instr, helperRet);
     }
+    else if (instr->m_opcode == Js::OpCode::Memvector)
+    {
+        newInstrPrev = LowerMemvector(instr, helperRet);
+    }
 
     if (newInstrPrev != nullptr)
     {
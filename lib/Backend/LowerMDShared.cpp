@@ -1717,7 +1717,13 @@ LowererMD::Legalize(IR::Instr *const instr, bool fPostRegAlloc)
         case Js::OpCode::PUNPCKLDQ:
         case Js::OpCode::PUNPCKLWD:
 
-            MakeDstEquSrc1<verify>(instr);
+#ifdef _M_X64
+            // The three operand VEX form only needs src1 in a register
+            if (!EncoderMD::IsVexEncoding(instr))
+#endif
+            {
+                MakeDstEquSrc1<verify>(instr);
+            }
             LegalizeOpnds<verify>(
                 instr,
                 L_Reg,
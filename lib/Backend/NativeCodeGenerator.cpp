@@ -1639,6 +1639,15 @@ NativeCodeGenerator::CheckCodeGenDone(
         jsMethod = entryPointInfo->jsMethod;
 
         Assert(!functionBody->NeedEnsureDynamicProfileInfo() || jsMethod == Js::DynamicProfileInfo::EnsureDynamicProfileInfoThunk);
+
+#if ENABLE_PROFILE_INFO
+        // Remember in the profile that this function got to full JIT, so that when the profile is persisted
+        // a later run can speculatively full JIT it without going through the lower tiers again
+        if (entryPointInfo->GetJitMode() == ExecutionMode::FullJit && functionBody->HasDynamicProfileInfo())
+        {
+            functionBody->GetAnyDynamicProfileInfo()->RecordReachedFullJit();
+        }
+#endif
     }
 
     Assert(!IsThunk(jsMethod));
@@ -1853,10 +1862,12 @@ NativeCodeGenerator::Prioritize(JsUtil::Job *const job, const bool forceAddJobTo
     {
         // Prioritize full JIT work items over simple JIT work items. This simple solution seems sufficient for now, but it
         // might be better to use a priority queue if it becomes necessary to prioritize recent simple JIT work items relative
-        // to the older simple JIT work items.
+        // to the older simple JIT work items. A shared job processor orders the work items of all thread contexts by hotness
+        // instead.
         AddToJitQueue(
             workItem,
-            jitMode == ExecutionMode::FullJit || queuedFullJitWorkItemCount == 0 /* prioritize */,
+            !scriptContext->GetThreadContext()->IsBgJitShared() &&
+                (jitMode == ExecutionMode::FullJit || queuedFullJitWorkItemCount == 0) /* prioritize */,
             false /* lock */,
             function);
     }
@@ -3404,13 +3415,21 @@ void NativeCodeGenerator::AddToJitQueue(CodeGenWorkItem *const codeGenWorkItem,
             workItemRemoved->OnRemoveFromJitQueue(this);
         }
     }
+    const bool isBgJitShared = scriptContext->GetThreadContext()->IsBgJitShared();
+    if(isBgJitShared)
+    {
+        // The job processor is shared with other thread contexts, order the work item among theirs by how hot the code is
+        codeGenWorkItem->SetPriority(max(codeGenWorkItem->GetInterpretedCount(), 1u));
+    }
     Processor()->AddJob(codeGenWorkItem, prioritize);   // This one can throw (really unlikely though), OOM specifically.
     if(jitMode == ExecutionMode::FullJit)
     {
         QueuedFullJitWorkItem *const queuedFullJitWorkItem = codeGenWorkItem->EnsureQueuedFullJitWorkItem();
         if(queuedFullJitWorkItem) // ignore OOM, this work item just won't be removed from the job processor's queue
         {
-            if(prioritize)
+            // A shared job processor decays the priority of work items as they wait, keep the oldest one at the end so
+            // that it's the one removed when there are too many
+            if(prioritize || isBgJitShared)
             {
                 queuedFullJitWorkItems.LinkToBeginning(queuedFullJitWorkItem);
             }
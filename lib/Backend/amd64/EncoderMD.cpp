@@ -597,6 +597,11 @@ EncoderMD::Encode(IR::Instr *instr, BYTE *pc, BYTE* beginCodeAddress)
     const uint32 leadIn = EncoderMD::GetLeadIn(instr);
     uint32 opdope = EncoderMD::GetOpdope(instr);
 
+    if (EncoderMD::IsVexEncoding(instr))
+    {
+        return this->EncodeVex(instr);
+    }
+
     //
     // Canonicalize operands.
     //
@@ -1343,6 +1348,67 @@ EncoderMD::Encode(IR::Instr *instr, BYTE *pc, BYTE* beginCodeAddress)
     }
 }
 
+///----------------------------------------------------------------------------
+///
+/// EncoderMD::EncodeVex
+///
+///     Emit the VEX.128 encoding of a two operand SSE instruction. It takes
+///     dst in ModRM.reg, src1 in VEX.vvvv and src2 in ModRM.rm, so dst
+///     doesn't have to be src1.
+///
+///----------------------------------------------------------------------------
+
+ptrdiff_t
+EncoderMD::EncodeVex(IR::Instr *instr)
+{
+    IR::Opnd *dst  = instr->GetDst();
+    IR::Opnd *src1 = instr->GetSrc1();
+    IR::Opnd *src2 = instr->GetSrc2();
+    const uint32 opdope = EncoderMD::GetOpdope(instr);
+    BYTE *instrStart = m_pc;
+
+    AssertMsg(dst->IsRegOpnd() && src1->IsRegOpnd(), "Expected dst and src1 of a VEX instr to be registers");
+    AssertMsg(src2, "Expected src2 of a VEX instr");
+
+    // Reserve the 3 byte prefix, we shrink it to the 2 byte one if neither VEX.X nor VEX.B is needed.
+    BYTE *pvex = m_pc;
+    m_pc += 3;
+    *(m_pc++) = *EncoderMD::GetOpbyte(instr);
+
+    BYTE rexByte = this->GetRexByte(this->REXR, dst);
+    rexByte |= this->EmitModRM(instr, src2, this->GetRegEncode(dst->AsRegOpnd()));
+
+    AssertMsg(m_pc - instrStart <= MachMaxInstrSize, "MachMaxInstrSize not set correctly");
+
+    // R, X, B and vvvv are stored inverted. L = 0 selects 128 bit vectors and W is ignored.
+    RegNum src1Reg = src1->AsRegOpnd()->GetReg();
+    BYTE vvvv = (BYTE)(this->GetRegEncode(src1Reg) | (this->IsExtendedRegister(src1Reg) ? 0x8 : 0));
+    BYTE pp = (opdope & D66) ? 0x1 : (opdope & DF3) ? 0x2 : (opdope & DF2) ? 0x3 : 0x0;
+    BYTE vexLast = (BYTE)(((~vvvv & 0xF) << 3) | pp);
+
+    if ((rexByte & (REXX | REXB)) == 0)
+    {
+        // C5 [R vvvv L pp] opcode ModRM ...
+        for (BYTE *current = pvex + 2; current + 1 < m_pc; current++)
+        {
+            *current = *(current + 1);
+        }
+        m_pc--;
+
+        pvex[0] = 0xC5;
+        pvex[1] = (BYTE)(((rexByte & REXR) ? 0 : 0x80) | vexLast);
+    }
+    else
+    {
+        // C4 [R X B m-mmmm] [W vvvv L pp] opcode ModRM ..., with m-mmmm = 1 for the 0F opcode map
+        pvex[0] = 0xC4;
+        pvex[1] = (BYTE)(((~rexByte & (REXR | REXX | REXB)) << 5) | 0x1);
+        pvex[2] = vexLast;
+    }
+
+    return m_pc - instrStart;
+}
+
 void
 EncoderMD::EmitRexByte(BYTE * prexByte, BYTE rexByte, bool skipRexByte, bool reservedRexByte)
 {
@@ -1956,7 +2022,17 @@ bool EncoderMD::UsesConditionCode(IR::Instr *instr)
 
 bool EncoderMD::IsOPEQ(IR::Instr *instr)
 {
-    return instr->IsLowered() && (EncoderMD::GetOpdope(instr) & DOPEQ);
+    return instr->IsLowered() && (EncoderMD::GetOpdope(instr) & DOPEQ) && !EncoderMD::IsVexEncoding(instr);
+}
+
+bool EncoderMD::IsVexEncoding(IR::Instr *instr)
+{
+    // The SSE arithmetic on xmm registers, which has a three operand VEX form on AVX hardware
+    return instr->IsLowered() &&
+        (EncoderMD::GetOpdope(instr) & (DNO16 | DOPEQ | DDST | DSSE)) == (DNO16 | DOPEQ) &&
+        EncoderMD::GetInstrForm(instr) == FORM_MODRM &&
+        EncoderMD::GetLeadIn(instr) == OLB_0F &&
+        AutoSystemInfo::Data.AVXAvailable();
 }
 
 bool EncoderMD::IsMOVEncoding(IR::Instr *instr)
@@ -190,6 +190,7 @@ public:
     static bool     SetsConditionCode(IR::Instr *instr);
     static bool     UsesConditionCode(IR::Instr *instr);
     static bool     IsOPEQ(IR::Instr *instr);
+    static bool     IsVexEncoding(IR::Instr *instr);
     static bool     IsMOVEncoding(IR::Instr *instr);
     RelocList*      GetRelocList() const { return m_relocList; }
     int             AppendRelocEntry(RelocType type, void *ptr, IR::LabelInstr *label= nullptr);
@@ -209,7 +210,7 @@ private:
     const BYTE      GetRegEncode(IR::RegOpnd *regOpnd);
     const BYTE      GetRegEncode(RegNum reg);
     static const uint32 GetOpdope(IR::Instr *instr);
-    const uint32    GetLeadIn(IR::Instr * instr);
+    static const uint32 GetLeadIn(IR::Instr * instr);
     BYTE            EmitModRM(IR::Instr * instr, IR::Opnd *opnd, BYTE reg1);
     void            EmitConst(size_t val, int size, bool allowImm64 = false);
     BYTE            EmitImmed(IR::Opnd * opnd, int opSize, int sbit, bool allowImm64 = false);
@@ -223,6 +224,7 @@ private:
     int             GetOpndSize(IR::Opnd * opnd);
 
     void            EmitRexByte(BYTE * prexByte, BYTE rexByte, bool skipRexByte, bool reservedRexByte);
+    ptrdiff_t       EncodeVex(IR::Instr *instr);
 
     enum
     {
@@ -33,14 +33,14 @@ namespace JsUtil
     // Job
     // -------------------------------------------------------------------------------------------------------------------------
 
-    Job::Job(const bool isCritical) : manager(0), isCritical(isCritical)
+    Job::Job(const bool isCritical) : manager(0), isCritical(isCritical), priority(0), priorityTickCount(0)
 #if ENABLE_DEBUG_CONFIG_OPTIONS
         , failureReason(FailureReason::NotFailed)
 #endif
     {
     }
 
-    Job::Job(JobManager *const manager, const bool isCritical) : manager(manager), isCritical(isCritical)
+    Job::Job(JobManager *const manager, const bool isCritical) : manager(manager), isCritical(isCritical), priority(0), priorityTickCount(0)
 #if ENABLE_DEBUG_CONFIG_OPTIONS
         , failureReason(FailureReason::NotFailed)
 #endif
@@ -58,6 +58,33 @@ namespace JsUtil
         return isCritical;
     }
 
+    void Job::SetPriority(const unsigned int priority)
+    {
+        this->priority = priority;
+        this->priorityTickCount = ::GetTickCount();
+    }
+
+    void Job::SetPrioritized()
+    {
+        // Keep jobs without a priority in the order they were added
+        if (priority != 0)
+        {
+            SetPriority(MaxPriority);
+        }
+    }
+
+    unsigned int Job::GetPriority(const DWORD tickCount) const
+    {
+        if (priority == MaxPriority || priority == 0)
+        {
+            return priority;
+        }
+
+        // Halve the priority for every half-life the job has waited since it was set
+        const DWORD halfLives = (tickCount - priorityTickCount) / (DWORD)max(1, CONFIG_FLAG(JitQueuePriorityHalfLife));
+        return halfLives >= sizeof(priority) * 8 ? 0 : priority >> halfLives;
+    }
+
     // -------------------------------------------------------------------------------------------------------------------------
     // JobManager
     // -------------------------------------------------------------------------------------------------------------------------
@@ -277,6 +304,7 @@ namespace JsUtil
         {
             if (job->Manager() == manager)
             {
+                job->SetPrioritized();
                 if (!lastJob)
                     lastJob = job;
             }
@@ -310,9 +338,34 @@ namespace JsUtil
         ++job->Manager()->numJobsAddedToProcessor;
 
         if (prioritize)
+        {
+            job->SetPrioritized();
             jobs.LinkToBeginning(job);
+        }
+        else if (job->priority != 0)
+        {
+            // Queue the job after the jobs with a higher or equal current priority. Jobs without a priority are always queued
+            // at the end, in the order they were added.
+            const DWORD tickCount = ::GetTickCount();
+            Job *previousJob = jobs.Tail();
+            while (previousJob && previousJob->GetPriority(tickCount) < job->priority)
+            {
+                previousJob = previousJob->Previous();
+            }
+
+            if (previousJob)
+            {
+                jobs.LinkAfter(job, previousJob);
+            }
+            else
+            {
+                jobs.LinkToBeginning(job);
+            }
+        }
         else
+        {
             jobs.LinkToEnd(job);
+        }
     }
 
     bool JobProcessor::RemoveJob(Job *const job)
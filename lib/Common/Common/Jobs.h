@@ -34,6 +34,7 @@ namespace JsUtil
     {
         friend SingleJobManager;
         friend WaitableSingleJobManager;
+        friend JobProcessor;
 
     private:
         JobManager *manager;
@@ -44,6 +45,11 @@ namespace JsUtil
         // JobManager::JobProcessed(succeeded = false).
         const bool isCritical;
 
+        // Jobs added with a nonzero priority are queued ahead of jobs with a lower priority, see JobProcessor::AddJob. The
+        // priority decays while the job waits in the queue, so that stale jobs don't hold back newer ones indefinitely.
+        unsigned int priority;
+        DWORD priorityTickCount;
+
     private:
         Job(const bool isCritical = false);
     public:
@@ -63,8 +69,14 @@ namespace JsUtil
 #endif
 
     public:
+        // Priority of jobs that were explicitly prioritized, which does not decay
+        static const unsigned int MaxPriority = UINT_MAX;
+
         JobManager *Manager() const;
         bool IsCritical() const;
+        void SetPriority(const unsigned int priority);
+        void SetPrioritized();
+        unsigned int GetPriority(const DWORD tickCount) const;
     };
 
     // -------------------------------------------------------------------------------------------------------------------------
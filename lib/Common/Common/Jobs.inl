@@ -363,6 +363,7 @@ namespace JsUtil
             bool forcedInThread = (threadService->HasCallback() && this->parallelThreadData[0]->isWaitingForJobs);
             if (!forcedInThread && !manager->ShouldProcessInForeground(false, numJobs))
             {
+                job->SetPrioritized();
                 jobs.MoveToBeginning(job);
                 manager->PrioritizedButNotYetProcessed(job);
                 return false;
@@ -451,6 +452,7 @@ namespace JsUtil
             {
                 if (!IsBeingProcessed(job))
                 {
+                    job->SetPrioritized();
                     jobs.MoveToBeginning(job);
                 }
                 Assert(!manager->jobBeingWaitedUpon);
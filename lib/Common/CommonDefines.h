@@ -120,23 +120,42 @@
 
 // GC features
 
-// Concurrent and Partial GC are disabled on non-Windows builds
-// xplat-todo: re-enable this in the future
-// These are disabled because these GC features depend on hardware
-// write-watch support that the Windows Memory Manager provides.
+// Concurrent and Partial GC depend on write-watch to find the pages written to
+// during a concurrent mark. The Windows Memory Manager provides it in hardware.
+// On Linux the PAL emulates MEM_WRITE_WATCH by write protecting clean pages and
+// recording the first write to each of them in its SIGSEGV handler; objects
+// allocated with a write barrier are tracked by the software card table in
+// RecyclerWriteBarrierManager instead.
+// xplat-todo: Darwin reports access violations through Mach exceptions, which
+// the PAL write-watch emulation doesn't hook yet.
+// Background page zeroing and freeing run on the concurrent GC thread and need
+// the interlocked SList from CommonPal.h; on Linux large runs of pages are
+// zeroed by handing them back to the kernel with MEM_RESET (madvise).
+// Huge page backed recycler segments rely on the PAL reserving MEM_LARGE_PAGES
+// regions on a 2MB boundary and advising them for transparent huge pages.
 #ifdef _WIN32
 #define SYSINFO_IMAGE_BASE_AVAILABLE 1
 #define ENABLE_CONCURRENT_GC 1
 #define ENABLE_PARTIAL_GC 1
 #define ENABLE_BACKGROUND_PAGE_ZEROING 1
 #define ENABLE_BACKGROUND_PAGE_FREEING 1
+#define ENABLE_HUGE_PAGES 0
 #define ENABLE_RECYCLER_TYPE_TRACKING 1
 #else
 #define SYSINFO_IMAGE_BASE_AVAILABLE 0
+#ifdef __LINUX__
+#define ENABLE_CONCURRENT_GC 1
+#define ENABLE_PARTIAL_GC 1
+#define ENABLE_BACKGROUND_PAGE_ZEROING 1
+#define ENABLE_BACKGROUND_PAGE_FREEING 1
+#define ENABLE_HUGE_PAGES 1
+#else
 #define ENABLE_CONCURRENT_GC 0
 #define ENABLE_PARTIAL_GC 0
 #define ENABLE_BACKGROUND_PAGE_ZEROING 0
 #define ENABLE_BACKGROUND_PAGE_FREEING 0
+#define ENABLE_HUGE_PAGES 0
+#endif
 #define ENABLE_RECYCLER_TYPE_TRACKING 0
 #endif
 
@@ -144,6 +163,14 @@
 #error "Background page zeroing can't be turned on if freeing pages in the background is disabled"
 #endif
 
+#if ENABLE_BACKGROUND_PAGE_FREEING && !ENABLE_CONCURRENT_GC
+#error "Background page freeing can't be turned on if concurrent GC is disabled, it runs on the concurrent thread"
+#endif
+
+#if ENABLE_PARTIAL_GC && !ENABLE_CONCURRENT_GC
+#error "Partial GC can't be turned on if concurrent GC is disabled, it relies on the same write-watch support"
+#endif
+
 #define BUCKETIZE_MEDIUM_ALLOCATIONS 1              // *** TODO: Won't build if disabled currently
 #define SMALLBLOCK_MEDIUM_ALLOC 1                   // *** TODO: Won't build if disabled currently
 #define LARGEHEAPBLOCK_ENCODING 1                   // Large heap block metadata encoding
@@ -268,6 +295,17 @@
 #define ENABLE_DIRECTCALL_TELEMETRY_STATS
 #endif
 
+// Dynamic profile persistence. The on-disk source profile cache (JsSetDynamicProfileCacheDirectory)
+// is available in release builds, the flag driven profile files in builds with debug config options.
+#if ENABLE_PROFILE_INFO
+#define DYNAMIC_PROFILE_STORAGE
+#endif
+
+// Linux perf map and jitdump output for jitted code (-PerfMap, -PerfJitDump), for profiling release builds
+#if defined(__linux__) && ENABLE_NATIVE_CODEGEN
+#define PERF_JIT_PROFILING
+#endif
+
 //----------------------------------------------------------------------------------------------------
 // Debug and fretest features
 //----------------------------------------------------------------------------------------------------
@@ -275,7 +313,6 @@
 
 #define BAILOUT_INJECTION
 #if ENABLE_PROFILE_INFO
-#define DYNAMIC_PROFILE_STORAGE
 #define DYNAMIC_PROFILE_MUTATOR
 #endif
 #define RUNTIME_DATA_COLLECTION
@@ -42,4 +42,5 @@ class FinalizableObject;
 #include "Memory/RecyclerHeuristic.h"
 #include "Memory/MarkContext.h"
 #include "Memory/RecyclerWatsonTelemetry.h"
+#include "Memory/RecyclerGCStatistics.h"
 #include "Memory/Recycler.h"
@@ -73,6 +73,7 @@ typedef wchar_t char16;
 #define INIT_PRIORITY(x)
 
 #define get_cpuid __cpuid
+#define get_xgetbv _xgetbv
 
 #if defined(__clang__)
 __forceinline void  __int2c()
@@ -92,6 +93,7 @@ __forceinline void  __int2c()
 #include <time.h>
 #include <smmintrin.h>
 #include <xmmintrin.h>
+#include <immintrin.h>
 #endif
 
 #include "inc/pal.h"
@@ -123,6 +125,13 @@ inline int get_cpuid(int cpuInfo[4], int function_id)
             reinterpret_cast<unsigned int*>(&cpuInfo[3]));
 }
 
+inline unsigned long long get_xgetbv(unsigned int xcr)
+{
+    unsigned int eax, edx;
+    __asm__ volatile("xgetbv" : "=a"(eax), "=d"(edx) : "c"(xcr));
+    return (static_cast<unsigned long long>(edx) << 32) | eax;
+}
+
 inline void DebugBreak()
 {
     __builtin_trap();
@@ -357,9 +366,95 @@ typedef union _SLIST_HEADER {
 
 #endif
 
-PALIMPORT VOID PALAPI InitializeSListHead(IN OUT PSLIST_HEADER ListHead);
-PALIMPORT PSLIST_ENTRY PALAPI InterlockedPushEntrySList(IN OUT PSLIST_HEADER ListHead, IN OUT PSLIST_ENTRY  ListEntry);
-PALIMPORT PSLIST_ENTRY PALAPI InterlockedPopEntrySList(IN OUT PSLIST_HEADER ListHead);
+//
+// Interlocked SList. The PAL has no implementation, so provide one on top of a
+// double-width compare-exchange. The header is treated as the first entry plus
+// a word holding the depth in the low 16 bits and a sequence number above it.
+// The sequence number changes on every push and pop, which protects the pop
+// from ABA when an entry is popped and pushed again concurrently.
+//
+#if defined(_AMD64_)
+typedef unsigned __int128 SLIST_HEADER_BITS;
+typedef ULONGLONG SLIST_DEPTH_AND_SEQUENCE;
+#else
+typedef ULONGLONG SLIST_HEADER_BITS;
+typedef ULONG SLIST_DEPTH_AND_SEQUENCE;
+#endif
+
+typedef union _SLIST_HEADER_VALUE {
+  SLIST_HEADER_BITS Bits;
+  struct {
+    PSLIST_ENTRY Next;
+    SLIST_DEPTH_AND_SEQUENCE DepthAndSequence;
+  } DUMMYSTRUCTNAME;
+} SLIST_HEADER_VALUE;
+
+static_assert(sizeof(SLIST_HEADER_VALUE) == sizeof(SLIST_HEADER), "SLIST_HEADER_VALUE must overlay SLIST_HEADER");
+
+#define SLIST_DEPTH_MASK ((SLIST_DEPTH_AND_SEQUENCE)0xFFFF)
+#define SLIST_SEQUENCE_INCREMENT ((SLIST_DEPTH_AND_SEQUENCE)0x10000)
+
+inline SLIST_HEADER_VALUE SListReadHeader(IN PSLIST_HEADER ListHead)
+{
+    // The read is not atomic; a torn value is caught by the compare-exchange
+    SLIST_HEADER_VALUE value;
+    value.Bits = *(SLIST_HEADER_BITS volatile *)ListHead;
+    return value;
+}
+
+inline VOID InitializeSListHead(IN OUT PSLIST_HEADER ListHead)
+{
+    SLIST_HEADER_VALUE value;
+    value.Bits = 0;
+    *(SLIST_HEADER_BITS volatile *)ListHead = value.Bits;
+}
+
+inline USHORT QueryDepthSList(IN PSLIST_HEADER ListHead)
+{
+    return (USHORT)(SListReadHeader(ListHead).DepthAndSequence & SLIST_DEPTH_MASK);
+}
+
+inline PSLIST_ENTRY InterlockedPushEntrySList(IN OUT PSLIST_HEADER ListHead, IN OUT PSLIST_ENTRY ListEntry)
+{
+    SLIST_HEADER_VALUE oldValue = SListReadHeader(ListHead);
+    while (true)
+    {
+        SLIST_HEADER_VALUE newValue;
+        ListEntry->Next = oldValue.Next;
+        newValue.Next = ListEntry;
+        newValue.DepthAndSequence = oldValue.DepthAndSequence + SLIST_SEQUENCE_INCREMENT + 1;
+
+        SLIST_HEADER_BITS currentBits = __sync_val_compare_and_swap((SLIST_HEADER_BITS volatile *)ListHead, oldValue.Bits, newValue.Bits);
+        if (currentBits == oldValue.Bits)
+        {
+            return oldValue.Next;
+        }
+        oldValue.Bits = currentBits;
+    }
+}
+
+inline PSLIST_ENTRY InterlockedPopEntrySList(IN OUT PSLIST_HEADER ListHead)
+{
+    SLIST_HEADER_VALUE oldValue = SListReadHeader(ListHead);
+    while (oldValue.Next != nullptr)
+    {
+        // Entries stay mapped while they are on a list (the page allocator only
+        // decommits a segment after draining its queues), so reading Next from
+        // an entry that another thread has just popped is safe; the sequence
+        // number makes the compare-exchange below fail in that case.
+        SLIST_HEADER_VALUE newValue;
+        newValue.Next = oldValue.Next->Next;
+        newValue.DepthAndSequence = oldValue.DepthAndSequence + SLIST_SEQUENCE_INCREMENT - 1;
+
+        SLIST_HEADER_BITS currentBits = __sync_val_compare_and_swap((SLIST_HEADER_BITS volatile *)ListHead, oldValue.Bits, newValue.Bits);
+        if (currentBits == oldValue.Bits)
+        {
+            return oldValue.Next;
+        }
+        oldValue.Bits = currentBits;
+    }
+    return nullptr;
+}
 
 
 template <class T>
@@ -672,5 +767,6 @@ namespace PlatformAgnostic
 
 #include "PlatformAgnostic/DateTime.h"
 #include "PlatformAgnostic/Numbers.h"
+#include "PlatformAgnostic/PerfTrace.h"
 #include "PlatformAgnostic/SystemInfo.h"
 #include "PlatformAgnostic/Thread.h"
@@ -55,6 +55,7 @@ PHASE(All)
             PHASE(BackendConcatExprOpt)
             PHASE(ClosureRangeCheck)
             PHASE(ClosureRegCheck)
+        PHASE(LoopUnswitch)
         PHASE(Inline)
             PHASE(InlineRecursive)
             PHASE(InlineAtEveryCaller)      //Inlines a function, say, foo at every caller of foo. Doesn't guarantee all the calls within foo are inlined too.
@@ -176,6 +177,7 @@ PHASE(All)
                 PHASE(MemOp)
                     PHASE(MemSet)
                     PHASE(MemCopy)
+                    PHASE(MemVector)
                 PHASE(IncrementalBailout)
             PHASE(DeadStore)
                 PHASE(ReverseCopyProp)
@@ -183,6 +185,8 @@ PHASE(All)
                     PHASE(MarkTempNumber)
                     PHASE(MarkTempObject)
                     PHASE(MarkTempNumberOnTempObject)
+            PHASE(ScalarReplacement)
+        PHASE(LoopUnroll)
         PHASE(Lowerer)
             PHASE(FastPath)
                 PHASE(LoopFastPath)
@@ -280,7 +284,9 @@ PHASE(All)
                     PHASE(SweepSmall)
                     PHASE(SweepLarge)
                     PHASE(SweepPartialReuse)
+                    PHASE(Compact)
                 PHASE(ConcurrentSweep)
+                    PHASE(ParallelSweep)
                 PHASE(Finalize)
                 PHASE(Dispose)
                 PHASE(FinishPartial)
@@ -477,6 +483,8 @@ PHASE(All)
 #define DEFAULT_CONFIG_GoptCleanupThreshold  (25)
 #define DEFAULT_CONFIG_AsmGoptCleanupThreshold  (500)
 #define DEFAULT_CONFIG_OptimizeForManyInstances (false)
+#define DEFAULT_CONFIG_PerfMap              (false)
+#define DEFAULT_CONFIG_PerfJitDump          (false)
 
 #define DEFAULT_CONFIG_DeferParseThreshold             (4 * 1024) // Unit is number of characters
 #define DEFAULT_CONFIG_ProfileBasedDeferParseThreshold (100)      // Unit is number of characters
@@ -599,6 +607,7 @@ PHASE(All)
 #define DEFAULT_CONFIG_MaxJITFunctionBytecodeSize (120000)
 
 #define DEFAULT_CONFIG_JitQueueThreshold      (6)
+#define DEFAULT_CONFIG_JitQueuePriorityHalfLife (250)
 
 #define DEFAULT_CONFIG_FullJitRequeueThreshold (25)     // Minimum number of times a function needs to be executed before it is re-added to the jit queue
 
@@ -707,6 +716,10 @@ PHASE(All)
 #define DEFAULT_CONFIG_SkipSplitWhenResultIgnored (false)
 
 #define DEFAULT_CONFIG_MinMemOpCount (16U)
+#define DEFAULT_CONFIG_LoopUnswitchMaxInstrCount (128U)
+#define DEFAULT_CONFIG_LoopUnswitchMaxLoopCount (4U)
+#define DEFAULT_CONFIG_LoopUnrollFactor (4U)
+#define DEFAULT_CONFIG_LoopUnrollMaxInstrCount (16U)
 
 #if ENABLE_COPYONACCESS_ARRAY
 #define DEFAULT_CONFIG_MaxCopyOnAccessArrayLength (32U)
@@ -721,6 +734,8 @@ PHASE(All)
 #if defined(_M_IX86) || defined(_M_X64)
 #define DEFAULT_CONFIG_ZeroMemoryWithNonTemporalStore (true)
 #endif
+#define DEFAULT_CONFIG_HugePages (false)
+#define DEFAULT_CONFIG_ArenaPageCacheMaxPageCount (1024)
 
 #define TraceLevel_Error        (1)
 #define TraceLevel_Warning      (2)
@@ -1131,6 +1146,7 @@ FLAGNR(Number,  InlineThresholdAdjustCountInSmallFunction       , "Adjustment in
 FLAGNR(String,  Interpret             , "List of functions to interpret", nullptr)
 FLAGNR(Phases,  Instrument            , "Instrument the generated code from the given phase", )
 FLAGNR(Number,  JitQueueThreshold     , "Max number of work items/script context in the jit queue", DEFAULT_CONFIG_JitQueueThreshold)
+FLAGNR(Number,  JitQueuePriorityHalfLife, "Time in milliseconds after which the priority of a queued work item in a shared jit queue is halved", DEFAULT_CONFIG_JitQueuePriorityHalfLife)
 #ifdef LEAK_REPORT
 FLAGNR(String,  LeakReport            , "File name for the leak report", nullptr)
 #endif
@@ -1169,6 +1185,10 @@ FLAGNR(Number,  MinSimpleJitRunCount  , "Minimum number of times a function must
 FLAGNRA(Number, MaxInterpretCount     , Mic, "Maximum number of times a function can be interpreted", 0)
 FLAGNRA(Number, MaxSimpleJitRunCount  , Msjrc, "Maximum number of times a function will be run in SimpleJitted code", 0)
 FLAGNRA(Number, MinMemOpCount         , Mmoc, "Minimum count of a loop to activate MemOp", DEFAULT_CONFIG_MinMemOpCount)
+FLAGNR(Number,  LoopUnswitchMaxInstrCount, "Maximum number of instructions in a loop that is duplicated by loop unswitching", DEFAULT_CONFIG_LoopUnswitchMaxInstrCount)
+FLAGNR(Number,  LoopUnswitchMaxLoopCount, "Maximum number of loops unswitched in a function", DEFAULT_CONFIG_LoopUnswitchMaxLoopCount)
+FLAGNR(Number,  LoopUnrollFactor      , "Number of iterations of a counted loop run by one iteration of its unrolled copy", DEFAULT_CONFIG_LoopUnrollFactor)
+FLAGNR(Number,  LoopUnrollMaxInstrCount, "Maximum number of instructions in the body of a loop that is unrolled", DEFAULT_CONFIG_LoopUnrollMaxInstrCount)
 
 #if ENABLE_COPYONACCESS_ARRAY
 FLAGNR(Number,  MaxCopyOnAccessArrayLength, "Maximum length of copy-on-access array", DEFAULT_CONFIG_MaxCopyOnAccessArrayLength)
@@ -1395,6 +1415,10 @@ FLAGR (Number,  DynamicRegexMruListSize, "Size of the MRU list for dynamic regex
 #endif
 
 FLAGR (Boolean, OptimizeForManyInstances, "Optimize script engine for many instances (low memory footprint per engine, assume low spare CPU cycles) (default: false)", DEFAULT_CONFIG_OptimizeForManyInstances)
+#ifdef PERF_JIT_PROFILING
+FLAGR (Boolean, PerfMap               , "Write the address ranges and names of jitted code to /tmp/perf-<pid>.map for perf (default: false)", DEFAULT_CONFIG_PerfMap)
+FLAGR (Boolean, PerfJitDump           , "Write jitted code to /tmp/jit-<pid>.dump for perf inject --jit (default: false)", DEFAULT_CONFIG_PerfJitDump)
+#endif
 FLAGNR(Phases,  TestTrace             , "Test trace for the given phase", )
 FLAGNR(Boolean, EnableEvalMapCleanup, "Enable cleaning up the eval map", true)
 #ifdef PROFILE_MEM
@@ -1406,7 +1430,7 @@ FLAGNR(Number, TargetWinRTVersion, "Specifies WinRT version number to target. [o
 FLAGNR(Boolean, EnableVersioningAllAssemblies, "Enable versioning behavior for all assemblies, regardless of host flag (default: false)", false)
 FLAGR(Boolean, FailFastIfDisconnectedDelegate, "When set fail fast if disconnected delegate is invoked", DEFAULT_CONFIG_FailFastIfDisconnectedDelegate)
 #endif
-FLAGNR(Number, Sse, "Virtually disables SSE-based optimizations above the specified SSE level in the Chakra JIT (does not affect CRT SSE usage)", DEFAULT_CONFIG_Sse)
+FLAGNR(Number, Sse, "Virtually disables SSE-based optimizations above the specified SSE level in the Chakra JIT (5 is AVX, 6 is AVX2; does not affect CRT SSE usage)", DEFAULT_CONFIG_Sse)
 FLAGNR(Number,  DeletedPropertyReuseThreshold, "Start reusing deleted property indexes after this many properties are deleted. Zero to disable reuse.", DEFAULT_CONFIG_DeletedPropertyReuseThreshold)
 FLAGNR(Boolean, ForceStringKeyedSimpleDictionaryTypeHandler, "Force switch to string keyed version of SimpleDictionaryTypeHandler on first new property added to a SimpleDictionaryTypeHandler", DEFAULT_CONFIG_ForceStringKeyedSimpleDictionaryTypeHandler)
 FLAGNR(Number,  BigDictionaryTypeHandlerThreshold, "Min Slot Capacity required to convert DictionaryTypeHandler to BigDictionaryTypeHandler.(Advisable to give more than 15 - to avoid false positive cases)", DEFAULT_CONFIG_BigDictionaryTypeHandlerThreshold)
@@ -1443,10 +1467,18 @@ FLAGNR(NumberSet, RejitTraceFilter, "Filter the rejit trace messages to specific
 FLAGNR(Number,  MaxBackgroundFinishMarkCount, "Maximum number of background finish mark", 1)
 FLAGNR(Number,  BackgroundFinishMarkWaitTime, "Millisecond to wait for background finish mark", 15)
 FLAGNR(Number,  MinBackgroundRepeatMarkRescanBytes, "Minimum number of bytes rescan to trigger background finish mark",  -1)
+#if ENABLE_CONCURRENT_GC
+FLAGNR(Number,  MaxParallelMarkThreadCount, "Maximum number of threads, including the main and concurrent threads, that mark in parallel", 8)
+#endif
+FLAGNR(Number,  ArenaPageCacheMaxPageCount, "Maximum number of pages from released arena page segments kept in the process-wide page cache", DEFAULT_CONFIG_ArenaPageCacheMaxPageCount)
+#if ENABLE_PARTIAL_GC
+FLAGR (Number,  RecyclerNurseryBytes, "Maximum bytes of new pages allocated before a partial collection (nursery size)", -1)
+#endif
 
 #if defined(_M_IX86) || defined(_M_X64)
 FLAGNR(Boolean, ZeroMemoryWithNonTemporalStore, "Zero free memory with non-temporal stores to avoid evicting other content from processor cache", DEFAULT_CONFIG_ZeroMemoryWithNonTemporalStore)
 #endif
+FLAGR (Boolean, HugePages, "Back recycler page segments that aren't write watched with transparent huge pages (ignored where huge pages aren't supported)", DEFAULT_CONFIG_HugePages)
 
 // recycler memory restrict test flags
 FLAGNR(Number,  MaxMarkStackPageCount , "Restrict recycler mark stack size (in pages)", -1)
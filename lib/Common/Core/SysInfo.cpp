@@ -74,6 +74,8 @@ AutoSystemInfo::Initialize()
 #if defined(_M_IX86) || defined(_M_X64)
     get_cpuid(CPUInfo, 1);
     isAtom = CheckForAtom();
+    isAVX = CheckForAVX();
+    isAVX2 = isAVX && CheckForAVX2();
 #endif
 #if defined(_M_ARM32_OR_ARM64)
     armDivAvailable = IsProcessorFeaturePresent(PF_ARM_DIVIDE_INSTRUCTION_AVAILABLE) ? true : false;
@@ -279,6 +281,20 @@ AutoSystemInfo::TZCntAvailable() const
     return VirtualSseAvailable(4) && (CPUInfo[1] & (1 << 3));
 }
 
+BOOL
+AutoSystemInfo::AVXAvailable() const
+{
+    Assert(initialized);
+    return VirtualSseAvailable(5) && isAVX;
+}
+
+BOOL
+AutoSystemInfo::AVX2Available() const
+{
+    Assert(initialized);
+    return VirtualSseAvailable(6) && isAVX2;
+}
+
 bool
 AutoSystemInfo::IsAtomPlatform() const
 {
@@ -324,6 +340,35 @@ AutoSystemInfo::CheckForAtom() const
     }
     return false;
 }
+
+bool
+AutoSystemInfo::CheckForAVX() const
+{
+    // The CPU has to support AVX, and the OS has to save the YMM state on a context switch (OSXSAVE is
+    // set and XCR0 enables both the XMM and the YMM state).
+    const int OSXSAVE = 1 << 27,
+              AVX = 1 << 28;
+
+    if ((CPUInfo[2] & (OSXSAVE | AVX)) != (OSXSAVE | AVX))
+    {
+        return false;
+    }
+    return (get_xgetbv(0) & 0x6) == 0x6;
+}
+
+bool
+AutoSystemInfo::CheckForAVX2() const
+{
+    int CPUInfo[4];
+    get_cpuid(CPUInfo, 0);
+    if (CPUInfo[0] < 7)
+    {
+        return false;
+    }
+
+    get_cpuid(CPUInfo, 7);
+    return (CPUInfo[1] & (1 << 5)) != 0;
+}
 #endif
 
 bool
@@ -31,6 +31,8 @@ public:
     BOOL PopCntAvailable() const;
     BOOL LZCntAvailable() const;
     BOOL TZCntAvailable() const;
+    BOOL AVXAvailable() const;
+    BOOL AVX2Available() const;
     bool IsAtomPlatform() const;
 #endif
     bool IsLowMemoryProcess();
@@ -94,7 +96,11 @@ private:
 private:
 #if defined(_M_IX86) || defined(_M_X64)
     bool isAtom;
+    bool isAVX;
+    bool isAVX2;
     bool CheckForAtom() const;
+    bool CheckForAVX() const;
+    bool CheckForAVX2() const;
 #endif
 
     bool InitPhysicalProcessorCount();
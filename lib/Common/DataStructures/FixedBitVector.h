@@ -468,6 +468,22 @@ public:
         return sum;
     }
 
+    // Number of set bits below index i
+    BVIndex CountBelow(BVIndex i) const
+    {
+        AssertRange(i);
+        BVIndex sum = 0;
+        BVIndex position = BVUnit::Position(i);
+        for (BVIndex j = 0; j < position; j++)
+        {
+            sum += this->data[j].Count();
+        }
+
+        BVUnit bitsFromIndex = this->data[position];
+        bitsFromIndex.ClearAllTill(BVUnit::Offset(i));
+        return sum + this->data[position].Count() - bitsFromIndex.Count();
+    }
+
     BVIndex Length() const
     {
         return bitCount;
@@ -15,6 +15,31 @@ private:
     static const size_t EntriesPerChunk = (AutoSystemInfo::PageSize - sizeof(Chunk)) / sizeof(T);
 
 public:
+    // Full chunks handed between stacks that are processed in parallel.
+    // While another thread is waiting for work, a stack with more than one chunk gives
+    // one away; a thread that runs out of work takes one. The parallel phase is over
+    // when every thread that joined is waiting and there are no chunks left.
+    class SharedChunkList
+    {
+    public:
+        SharedChunkList() : head(nullptr), activeCount(0), waitingCount(0) {}
+        ~SharedChunkList() { Assert(head == nullptr && activeCount == 0); }
+
+        void Join();
+        bool Give(PageStack<T> * stack);
+        bool Take(PageStack<T> * stack);
+
+        // Some thread is waiting and there is nothing for it to take
+        bool IsStarving() const { return waitingCount != 0 && head == nullptr; }
+        bool IsEmpty() const { return head == nullptr; }
+
+    private:
+        CriticalSection cs;
+        Chunk * volatile head;
+        uint activeCount;
+        uint volatile waitingCount;
+    };
+
     PageStack(PagePool * pagePool);
     ~PageStack();
 
@@ -44,11 +69,13 @@ public:
     }
 #endif
 
-    static const uint MaxSplitTargets = 3;     // Not counting original stack, so this supports 4-way parallel
+    static const uint MaxSplitTargets = 31;     // Not counting original stack, so this supports 32-way parallel
 
 private:
     Chunk * CreateChunk();
     void FreeChunk(Chunk * chunk);
+    Chunk * DetachChunk();
+    void AttachChunk(Chunk * chunk);
 
 private:
     T * nextEntry;
@@ -263,9 +290,18 @@ uint PageStack<T>::Split(uint targetCount, __in_ecount(targetCount) PageStack<T>
     mainCurrent = chunk;
     chunk = chunk->nextChunk;
 
+    // Reserved chunks always stay with the main stack, since the target stacks would free
+    // them to their own page pools.
     uint targetIndex = 0;
     while (targetIndex < targetCount)
     {
+        while (chunk != nullptr && chunk->IsReserved())
+        {
+            mainCurrent->nextChunk = chunk;
+            mainCurrent = chunk;
+            chunk = chunk->nextChunk;
+        }
+
         if (chunk == nullptr)
         {
             // No more pages.  Adjust targetCount down to what we were actually able to do.
@@ -322,6 +358,14 @@ uint PageStack<T>::Split(uint targetCount, __in_ecount(targetCount) PageStack<T>
                 break;
             }
 
+            if (chunk->IsReserved())
+            {
+                mainCurrent->nextChunk = chunk;
+                mainCurrent = chunk;
+                chunk = chunk->nextChunk;
+                continue;
+            }
+
             targetCurrents[targetIndex]->nextChunk = chunk;
             targetCurrents[targetIndex] = chunk;
 
@@ -353,6 +397,131 @@ uint PageStack<T>::Split(uint targetCount, __in_ecount(targetCount) PageStack<T>
 }
 
 
+template <typename T>
+typename PageStack<T>::Chunk * PageStack<T>::DetachChunk()
+{
+    // Every chunk below the current one is full; detach the nearest one below it.
+    // Reserved chunks stay: the stack that took them would free them to its own page pool,
+    // and this stack's pool would lose the pages it needs to keep going when out of memory.
+    if (currentChunk == nullptr)
+    {
+        return nullptr;
+    }
+
+    Chunk * prevChunk = currentChunk;
+    Chunk * chunk = currentChunk->nextChunk;
+    while (chunk != nullptr && chunk->IsReserved())
+    {
+        prevChunk = chunk;
+        chunk = chunk->nextChunk;
+    }
+
+    if (chunk == nullptr)
+    {
+        return nullptr;
+    }
+
+    prevChunk->nextChunk = chunk->nextChunk;
+    chunk->nextChunk = nullptr;
+
+#ifdef ENABLE_DEBUG_CONFIG_OPTIONS
+    this->pageCount--;
+#endif
+#if DBG
+    this->count -= EntriesPerChunk;
+#endif
+
+    return chunk;
+}
+
+
+template <typename T>
+void PageStack<T>::AttachChunk(Chunk * chunk)
+{
+    // Link the full chunk below the current one. Pop moves on to it once the current chunk is empty.
+    if (currentChunk == nullptr)
+    {
+        chunk->nextChunk = nullptr;
+        currentChunk = chunk;
+        chunkStart = chunk->entries;
+        chunkEnd = &chunk->entries[EntriesPerChunk];
+        nextEntry = chunkEnd;
+    }
+    else
+    {
+        chunk->nextChunk = currentChunk->nextChunk;
+        currentChunk->nextChunk = chunk;
+    }
+
+#ifdef ENABLE_DEBUG_CONFIG_OPTIONS
+    this->pageCount++;
+#endif
+#if DBG
+    this->count += EntriesPerChunk;
+#endif
+}
+
+
+template <typename T>
+void PageStack<T>::SharedChunkList::Join()
+{
+    AutoCriticalSection autocs(&cs);
+    activeCount++;
+}
+
+
+template <typename T>
+bool PageStack<T>::SharedChunkList::Give(PageStack<T> * stack)
+{
+    Chunk * chunk = stack->DetachChunk();
+    if (chunk == nullptr)
+    {
+        return false;
+    }
+
+    AutoCriticalSection autocs(&cs);
+    chunk->nextChunk = head;
+    head = chunk;
+    return true;
+}
+
+
+template <typename T>
+bool PageStack<T>::SharedChunkList::Take(PageStack<T> * stack)
+{
+    Assert(stack->IsEmpty());
+
+    cs.Enter();
+    Assert(activeCount != 0);
+    activeCount--;
+    waitingCount++;
+
+    while (head == nullptr)
+    {
+        if (activeCount == 0)
+        {
+            // Nobody is left to give us more work; we are done.
+            waitingCount--;
+            cs.Leave();
+            return false;
+        }
+
+        cs.Leave();
+        SwitchToThread();
+        cs.Enter();
+    }
+
+    Chunk * chunk = head;
+    head = chunk->nextChunk;
+    activeCount++;
+    waitingCount--;
+    cs.Leave();
+
+    stack->AttachChunk(chunk);
+    return true;
+}
+
+
 template <typename T>
 void PageStack<T>::Abort()
 {
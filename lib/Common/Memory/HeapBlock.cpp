@@ -1572,12 +1572,40 @@ template <class TBlockAttributes>
 void
 SmallHeapBlockT<TBlockAttributes>::EnumerateObjects(ObjectInfoBits infoBits, void (*CallBackFunction)(void * address, size_t size))
 {
+    if (infoBits & EnumerateAllObjectsBit)
+    {
+        ForEachAllocatedObject([=](uint index, void * objectAddress)
+        {
+            CallBackFunction(objectAddress, this->objectSize);
+        });
+        return;
+    }
+
     ForEachAllocatedObject(infoBits, [=](uint index, void * objectAddress)
     {
         CallBackFunction(objectAddress, this->objectSize);
     });
 }
 
+// Returns the position of an allocated object among the objects EnumerateObjects(EnumerateAllObjectsBit)
+// reports for this block, so that callers can number objects without remembering each one.
+template <class TBlockAttributes>
+uint
+SmallHeapBlockT<TBlockAttributes>::GetAllocatedObjectIndex(void * objectAddress)
+{
+    ushort index = GetAddressIndex(objectAddress);
+    Assert(index != SmallHeapBlockT<TBlockAttributes>::InvalidAddressBit);
+
+    uint const objectBitDelta = this->GetObjectBitDelta();
+    SmallHeapBlockBitVector * free = this->EnsureFreeBitVector();
+    Assert(!free->Test(index * objectBitDelta));
+
+    // Only the first bit of each object is ever set in the free bit vector, so the objects before this
+    // one that aren't allocated are the set bits below its bit. The heap snapshot writer calls this for
+    // every edge, so count them a word at a time.
+    return index - free->CountBelow(index * objectBitDelta);
+}
+
 template <class TBlockAttributes>
 inline
 void SmallHeapBlockT<TBlockAttributes>::FillFreeMemory(__in_bcount(size) void * address, size_t size)
@@ -99,6 +99,10 @@ enum ObjectInfoBits : unsigned short
     ClientTrackedBit            = 0x0200,       // This allocation is client tracked
     TraceBit                    = 0x0400,
 
+    // Bits that only affect enumeration
+
+    EnumerateAllObjectsBit      = 0x0800,       // EnumerateObjects reports every allocated object regardless of its bits
+
     // Additional definitions based on above
 
 #ifdef RECYCLER_STATS
@@ -582,6 +586,7 @@ public:
     void Reset();
 
     void EnumerateObjects(ObjectInfoBits infoBits, void (*CallBackFunction)(void * address, size_t size));
+    uint GetAllocatedObjectIndex(void * objectAddress);
 
     bool IsImplicitRoot(uint objectIndex)
     {
@@ -767,6 +772,60 @@ public:
         return tail;
     }
 
+    // Stable merge sort of the list, ordered by the lessThan predicate
+    template <typename TBlockType, typename Fn>
+    static TBlockType * Sort(TBlockType * list, Fn lessThan)
+    {
+        if (list == nullptr || list->GetNextBlock() == nullptr)
+        {
+            return list;
+        }
+
+        // Split the list in half
+        TBlockType * slow = list;
+        TBlockType * fast = list->GetNextBlock();
+        while (fast != nullptr && fast->GetNextBlock() != nullptr)
+        {
+            slow = slow->GetNextBlock();
+            fast = fast->GetNextBlock()->GetNextBlock();
+        }
+        TBlockType * second = slow->GetNextBlock();
+        slow->SetNextBlock(nullptr);
+
+        TBlockType * first = Sort(list, lessThan);
+        second = Sort(second, lessThan);
+
+        // Merge the two sorted halves
+        TBlockType * head = nullptr;
+        TBlockType * tail = nullptr;
+        while (first != nullptr && second != nullptr)
+        {
+            TBlockType * heapBlock;
+            if (lessThan(second, first))
+            {
+                heapBlock = second;
+                second = second->GetNextBlock();
+            }
+            else
+            {
+                heapBlock = first;
+                first = first->GetNextBlock();
+            }
+
+            if (tail == nullptr)
+            {
+                head = heapBlock;
+            }
+            else
+            {
+                tail->SetNextBlock(heapBlock);
+            }
+            tail = heapBlock;
+        }
+        tail->SetNextBlock(first != nullptr ? first : second);
+        return head;
+    }
+
 #if DBG
     template <typename TBlockType>
     static bool Contains(TBlockType * block, TBlockType * list, TBlockType * tail = nullptr)
@@ -236,7 +236,9 @@ HeapBucketT<TBlockType>::IntegrateBlock(char * blockAddress, PageSegment * segme
     this->fullBlockList = heapBlock;
     RECYCLER_SLOW_CHECK(this->heapBlockCount++);
 
-    this->heapInfo->uncollectedAllocBytes += heapBlock->GetAndClearLastFreeCount() * heapBlock->GetObjectSize();
+    const size_t allocBytes = heapBlock->GetAndClearLastFreeCount() * heapBlock->GetObjectSize();
+    this->heapInfo->uncollectedAllocBytes += allocBytes;
+    this->heapInfo->totalAllocBytes += allocBytes;
     RecyclerMemoryTracking::ReportAllocation(recycler, blockAddress, heapBlock->GetObjectSize() * heapBlock->GetObjectCount());
     RECYCLER_PERF_COUNTER_ADD(LiveObject,heapBlock->GetObjectCount());
     RECYCLER_PERF_COUNTER_ADD(LiveObjectSize, heapBlock->GetObjectSize() * heapBlock->GetObjectCount());
@@ -729,13 +731,13 @@ HeapBucketT<TBlockType>::SweepHeapBlockList(RecyclerSweep& recyclerSweep, TBlock
 #if DBG
     if (TBlockType::HeapBlockAttributes::IsSmallBlock)
     {
-        Assert(recyclerSweep.smallBlockVerifyListConsistencyData.hasSetupVerifyListConsistencyData);
-        recyclerSweep.smallBlockVerifyListConsistencyData.hasSetupVerifyListConsistencyData = false;
+        Assert(this->sweepVerifyListConsistencyData.smallBlockVerifyListConsistencyData.hasSetupVerifyListConsistencyData);
+        this->sweepVerifyListConsistencyData.smallBlockVerifyListConsistencyData.hasSetupVerifyListConsistencyData = false;
     }
     else if (TBlockType::HeapBlockAttributes::IsMediumBlock)
     {
-        Assert(recyclerSweep.mediumBlockVerifyListConsistencyData.hasSetupVerifyListConsistencyData);
-        recyclerSweep.mediumBlockVerifyListConsistencyData.hasSetupVerifyListConsistencyData = false;
+        Assert(this->sweepVerifyListConsistencyData.mediumBlockVerifyListConsistencyData.hasSetupVerifyListConsistencyData);
+        this->sweepVerifyListConsistencyData.mediumBlockVerifyListConsistencyData.hasSetupVerifyListConsistencyData = false;
     }
     else
     {
@@ -760,11 +762,11 @@ HeapBucketT<TBlockType>::SweepHeapBlockList(RecyclerSweep& recyclerSweep, TBlock
     HeapBlockList::ForEachEditing(heapBlockList, [=, &recyclerSweep](TBlockType * heapBlock)
     {
         // The whole list need to be consistent
-        DebugOnly(VerifyBlockConsistencyInList(heapBlock, recyclerSweep));
+        DebugOnly(VerifyBlockConsistencyInList(heapBlock, this->sweepVerifyListConsistencyData));
 
         SweepState state = heapBlock->Sweep(recyclerSweep, queuePendingSweep, allocable);
 
-        DebugOnly(VerifyBlockConsistencyInList(heapBlock, recyclerSweep, state));
+        DebugOnly(VerifyBlockConsistencyInList(heapBlock, this->sweepVerifyListConsistencyData, state));
 
         switch (state)
         {
@@ -899,11 +901,11 @@ HeapBucketT<TBlockType>::SweepBucket(RecyclerSweep& recyclerSweep)
 #if DBG
     if (TBlockType::HeapBlockAttributes::IsSmallBlock)
     {
-        recyclerSweep.SetupVerifyListConsistencyDataForSmallBlock((SmallHeapBlock*) savedNextAllocableBlockHead, true, false);
+        this->sweepVerifyListConsistencyData.SetupVerifyListConsistencyDataForSmallBlock((SmallHeapBlock*) savedNextAllocableBlockHead, true, false);
     }
     else if (TBlockType::HeapBlockAttributes::IsMediumBlock)
     {
-        recyclerSweep.SetupVerifyListConsistencyDataForMediumBlock((MediumHeapBlock*) savedNextAllocableBlockHead, true, false);
+        this->sweepVerifyListConsistencyData.SetupVerifyListConsistencyDataForMediumBlock((MediumHeapBlock*) savedNextAllocableBlockHead, true, false);
     }
     else
     {
@@ -921,11 +923,11 @@ HeapBucketT<TBlockType>::SweepBucket(RecyclerSweep& recyclerSweep)
 #if DBG
     if (TBlockType::HeapBlockAttributes::IsSmallBlock)
     {
-        recyclerSweep.SetupVerifyListConsistencyDataForSmallBlock(nullptr, true, false);
+        this->sweepVerifyListConsistencyData.SetupVerifyListConsistencyDataForSmallBlock(nullptr, true, false);
     }
     else if (TBlockType::HeapBlockAttributes::IsMediumBlock)
     {
-        recyclerSweep.SetupVerifyListConsistencyDataForMediumBlock(nullptr, true, false);
+        this->sweepVerifyListConsistencyData.SetupVerifyListConsistencyDataForMediumBlock(nullptr, true, false);
     }
     else
     {
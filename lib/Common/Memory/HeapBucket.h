@@ -242,6 +242,9 @@ protected:
 
 #if DBG
     bool isAllocationStopped;                 // whether the bucket is the middle of sweeping, not including partial sweeping
+
+    // Expected state of the blocks in the list being swept. Kept per bucket since buckets can be swept in parallel.
+    RecyclerVerifyListConsistencyData sweepVerifyListConsistencyData;
 #endif
 
     template <class TBlockAttributes>
@@ -285,6 +288,16 @@ HeapBucketT<TBlockType>::SweepBucket(RecyclerSweep& recyclerSweep, Fn sweepFn)
         Assert(recyclerSweep.GetPendingSweepBlockList(this) == nullptr);
 #endif
 
+        if (recyclerSweep.GetRecycler()->InCompactCollection())
+        {
+            // Objects can't be moved since roots are found conservatively. Instead, have the allocator
+            // fill the densest blocks first so the sparse ones drain and get released by later sweeps.
+            this->heapBlockList = HeapBlockList::Sort(this->heapBlockList, [](TBlockType * a, TBlockType * b)
+            {
+                return a->GetMarkedCount() > b->GetMarkedCount();
+            });
+        }
+
         // Every thing is swept immediately in non partial collect, so we can allocate
         // from the heap block list now
         StartAllocationAfterSweep();
@@ -361,6 +361,7 @@ HeapInfo::HeapInfo() :
     newMediumFinalizableWithBarrierHeapBlockList(nullptr),
 #endif
     newMediumFinalizableHeapBlockList(nullptr),
+    nextParallelSweepBucket(0),
 #endif
 #ifdef RECYCLER_FINALIZE_CHECK
     liveFinalizableObjectCount(0),
@@ -372,6 +373,7 @@ HeapInfo::HeapInfo() :
     unusedPartialCollectFreeBytes(0),
 #endif
     uncollectedAllocBytes(0),
+    totalAllocBytes(0),
     lastUncollectedAllocBytes(0),
     pendingZeroPageCount(0)
 #ifdef RECYCLER_PAGE_HEAP
@@ -965,6 +967,45 @@ HeapInfo::SetupBackgroundSweep(RecyclerSweep& recyclerSweep)
     }
 #endif
 }
+
+void
+HeapInfo::StartParallelSweep()
+{
+    this->nextParallelSweepBucket = 0;
+}
+
+void
+HeapInfo::ParallelSweepSmallNonFinalizable(RecyclerSweep& recyclerSweep)
+{
+    Assert(recyclerSweep.IsBackground());
+
+    // Claim one bucket group at a time, so threads that finish early help with the rest.
+#if defined(BUCKETIZE_MEDIUM_ALLOCATIONS) && SMALLBLOCK_MEDIUM_ALLOC
+    const uint bucketCount = HeapConstants::BucketCount + HeapConstants::MediumBucketCount;
+#else
+    const uint bucketCount = HeapConstants::BucketCount;
+#endif
+
+    while (true)
+    {
+        const uint i = (uint)::InterlockedIncrement(&this->nextParallelSweepBucket) - 1;
+        if (i >= bucketCount)
+        {
+            break;
+        }
+
+        if (i < HeapConstants::BucketCount)
+        {
+            heapBuckets[i].Sweep(recyclerSweep);
+        }
+#if defined(BUCKETIZE_MEDIUM_ALLOCATIONS) && SMALLBLOCK_MEDIUM_ALLOC
+        else
+        {
+            mediumHeapBuckets[i - HeapConstants::BucketCount].Sweep(recyclerSweep);
+        }
+#endif
+    }
+}
 #endif
 
 void
@@ -989,17 +1030,28 @@ HeapInfo::SweepSmallNonFinalizable(RecyclerSweep& recyclerSweep)
         // until  we are going to sweep leaf pages.
         recycler->GetRecyclerLeafPageAllocator()->SuspendIdleDecommit();
     }
-    for (uint i=0; i<HeapConstants::BucketCount; i++)
+
+#if ENABLE_CONCURRENT_GC
+    if (recyclerSweep.IsBackground() && recycler->DoParallelSweep())
     {
-        heapBuckets[i].Sweep(recyclerSweep);
+        // Empty blocks are only queued in the background, so the buckets can be swept by several threads
+        recycler->DoBackgroundParallelSweep(recyclerSweep);
     }
+    else
+#endif
+    {
+        for (uint i=0; i<HeapConstants::BucketCount; i++)
+        {
+            heapBuckets[i].Sweep(recyclerSweep);
+        }
 
 #if defined(BUCKETIZE_MEDIUM_ALLOCATIONS) && SMALLBLOCK_MEDIUM_ALLOC
-    for (uint i = 0; i < HeapConstants::MediumBucketCount; i++)
-    {
-        mediumHeapBuckets[i].Sweep(recyclerSweep);
-    }
+        for (uint i = 0; i < HeapConstants::MediumBucketCount; i++)
+        {
+            mediumHeapBuckets[i].Sweep(recyclerSweep);
+        }
 #endif
+    }
 
     if (!recyclerSweep.IsBackground())
     {
@@ -258,6 +258,8 @@ private:
 #endif
 
     void SetupBackgroundSweep(RecyclerSweep& recyclerSweep);
+    void StartParallelSweep();
+    void ParallelSweepSmallNonFinalizable(RecyclerSweep& recyclerSweep);
 #else
     template <typename TBlockType> TBlockType *& GetNewHeapBlockList(HeapBucketT<TBlockType> * heapBucket)
     {
@@ -374,6 +376,7 @@ public:
 
 private:
     size_t uncollectedAllocBytes;
+    size_t totalAllocBytes;
     size_t lastUncollectedAllocBytes;
     size_t uncollectedExternalBytes;
     uint pendingZeroPageCount;
@@ -404,6 +407,9 @@ private:
     MediumNormalWithBarrierHeapBlock * newMediumNormalWithBarrierHeapBlockList;
     MediumFinalizableWithBarrierHeapBlock * newMediumFinalizableWithBarrierHeapBlockList;
 #endif
+
+    // Index of the next bucket group to be claimed by a thread sweeping in parallel
+    LONG volatile nextParallelSweepBucket;
 #endif
 
 #ifdef RECYCLER_PAGE_HEAP
@@ -298,6 +298,50 @@ LargeHeapBlock::ReleasePagesSweep(Recycler * recycler)
     ReleasePages(recycler);
 }
 
+// Called on a block that swept as empty when the bucket keeps it for reuse instead of
+// releasing its pages. The dead objects are forgotten so that marking and object lookups
+// treat the block as unallocated. The memory up to allocAddressEnd is left dirty until
+// the block is reused.
+void
+LargeHeapBlock::ResetEmptyBlock()
+{
+    Assert(this->finalizeCount == 0);
+    Assert(this->pendingDisposeObject == nullptr);
+    Assert(!this->isInPendingDisposeList);
+    Assert(!this->hasPartialFreeObjects);
+#ifdef RECYCLER_PAGE_HEAP
+    Assert(!InPageHeapMode());
+#endif
+
+    memset(this->HeaderList(), 0, this->allocCount * sizeof(LargeObjectHeader *));
+    this->freeList.entries = nullptr;
+    this->allocCount = 0;
+    this->lastCollectAllocCount = 0;
+}
+
+// Bring a block reset by ResetEmptyBlock back into the same state as a newly added block
+void
+LargeHeapBlock::ReuseEmptyBlock(Recycler * recycler)
+{
+    Assert(IsEmptyBlock());
+    Assert(this->allocAddressEnd >= this->address && this->allocAddressEnd <= this->addressEnd);
+    Assert(recycler->collectionState != CollectionStateMark);
+
+    // Allocations expect zeroed memory, as they would get from fresh pages
+    memset(this->address, 0, this->allocAddressEnd - this->address);
+#ifdef RECYCLER_ZERO_MEM_CHECK
+    recycler->VerifyZeroFill(this->address, this->pageCount * AutoSystemInfo::PageSize);
+#endif
+
+    this->allocAddressEnd = this->address;
+    this->next = nullptr;
+#if DBG
+    this->hasDisposeBeenCalled = false;
+    this->expectedSweepCount = 0;
+    this->hadTrimmed = false;
+#endif
+}
+
 #ifdef RECYCLER_PAGE_HEAP
 _NOINLINE
 void LargeHeapBlock::VerifyPageHeapPattern()
@@ -397,39 +441,25 @@ LargeHeapBlock::GetPagesNeeded(size_t size, bool multiplyRequest)
 }
 
 char*
-LargeHeapBlock::TryAllocFromFreeList(size_t size, ObjectInfoBits attributes)
+LargeHeapBlock::AllocFromFreeList(size_t size, ObjectInfoBits attributes, LargeHeapBlockFreeListEntry* entry)
 {
     Assert((attributes & InternalObjectInfoBitMask) == attributes);
+    Assert(entry->objectSize >= size);
 
+    // The bucket has already unlinked the entry from its size class, take it off our own list as well.
+    // Look it up before allocating since the allocation clears the entry.
     LargeHeapBlockFreeListEntry** prev = &this->freeList.entries;
-    LargeHeapBlockFreeListEntry* freeListEntry = this->freeList.entries;
-
-    char* memBlock = nullptr;
-
-    // Walk through the free list, find the first entry that can fit our desired size
-    while (freeListEntry)
+    while (*prev != entry)
     {
-        LargeHeapBlockFreeListEntry* next = freeListEntry->next;
-        LargeHeapBlock* heapBlock = freeListEntry->heapBlock;
-
-        if (freeListEntry->objectSize >= size)
-        {
-            memBlock = heapBlock->AllocFreeListEntry(size, attributes, freeListEntry);
-            if (memBlock)
-            {
-                (*prev) = next;
-
-                break;
-            }
-        }
-
-        prev = &freeListEntry->next;
-        freeListEntry = freeListEntry->next;
+        Assert(*prev != nullptr);
+        prev = &(*prev)->next;
     }
+    LargeHeapBlockFreeListEntry* next = entry->next;
 
-    if (this->freeList.entries == nullptr)
+    char* memBlock = AllocFreeListEntry(size, attributes, entry);
+    if (memBlock != nullptr)
     {
-        this->bucket->UnregisterFreeList(&this->freeList);
+        (*prev) = next;
     }
 
     return memBlock;
@@ -441,7 +471,7 @@ LargeHeapBlock::AllocFreeListEntry(size_t size, ObjectInfoBits attributes, Large
     Assert((attributes & InternalObjectInfoBitMask) == attributes);
     Assert(HeapInfo::IsAlignedSize(size));
     AssertMsg((attributes & TrackBit) == 0, "Large tracked object collection not implemented");
-    Assert(entry->heapBlock == this);
+    Assert((char *)entry >= this->address && (char *)entry < this->addressEnd);
     Assert(entry->headerIndex < this->objectCount);
     Assert(this->HeaderList()[entry->headerIndex] == nullptr);
 
@@ -1673,9 +1703,9 @@ LargeHeapBlock::SweepObjects(Recycler * recycler)
             LargeHeapBlockFreeListEntry* head = this->freeList.entries;
             LargeHeapBlockFreeListEntry* entry = (LargeHeapBlockFreeListEntry*) header;
             entry->headerIndex = i;
-            entry->heapBlock = this;
-            entry->next = head;
             entry->objectSize = objectSize;
+            entry->next = head;
+            entry->nextInSizeClass = nullptr;
             this->freeList.entries = entry;
         }
 
@@ -1780,13 +1810,35 @@ LargeHeapBlock::EnumerateObjects(ObjectInfoBits infoBits, void (*CallBackFunctio
         {
             continue;
         }
-        if ((header->GetAttributes(this->heapInfo->recycler->Cookie) & infoBits) != 0)
+        if ((infoBits & EnumerateAllObjectsBit) != 0 || (header->GetAttributes(this->heapInfo->recycler->Cookie) & infoBits) != 0)
         {
             CallBackFunction(header->GetAddress(), header->objectSize);
         }
     }
 }
 
+uint
+LargeHeapBlock::GetAllocatedObjectIndex(void * objectAddress)
+{
+    LargeObjectHeader * header = nullptr;
+    if (!GetObjectHeader(objectAddress, &header))
+    {
+        Assert(false);
+        return 0;
+    }
+
+    // Objects are enumerated in header order, skipping the freed ones
+    uint allocatedIndex = 0;
+    for (uint i = 0; i < header->objectIndex; i++)
+    {
+        if (this->GetHeader(i) != nullptr)
+        {
+            allocatedIndex++;
+        }
+    }
+    return allocatedIndex;
+}
+
 
 uint
 LargeHeapBlock::GetMaxLargeObjectCount(size_t pageCount, size_t firstAllocationSize)
@@ -1867,7 +1919,6 @@ LargeHeapBlock::Verify(Recycler * recycler)
                 if (current->headerIndex == i)
                 {
                     BYTE* objectAddress = (BYTE *)current + sizeof(LargeObjectHeader);
-                    Recycler::VerifyCheck(current->heapBlock == this, _u("Invalid heap block"), this, current->heapBlock);
                     Recycler::VerifyCheck((char *)current >= lastAddress, _u("LargeHeapBlock invalid object header order"), this->address, current);
                     Recycler::VerifyCheckFill(lastAddress, (char *)current - lastAddress);
                     recycler->VerifyCheckPad(objectAddress, current->objectSize);
@@ -60,27 +60,26 @@ static_assert(sizeof(LargeObjectHeader) == 0x10, "Incorrect LargeObjectHeader si
 class LargeHeapBlock;
 class LargeHeapBucket;
 
+// Overlays the LargeObjectHeader of a swept object. Each entry is linked both into the
+// free list of its heap block and into the bucket's free list for its size class.
 struct LargeHeapBlockFreeListEntry
 {
     uint headerIndex;
     size_t objectSize;
-    LargeHeapBlock* heapBlock;
     LargeHeapBlockFreeListEntry* next;
+    LargeHeapBlockFreeListEntry* nextInSizeClass;
 };
+static_assert(sizeof(LargeHeapBlockFreeListEntry) <= sizeof(LargeObjectHeader), "LargeHeapBlockFreeListEntry must fit in a LargeObjectHeader");
 
 struct LargeHeapBlockFreeList
 {
 public:
     LargeHeapBlockFreeList(LargeHeapBlock* heapBlock):
-        previous(nullptr),
-        next(nullptr),
         entries(nullptr),
         heapBlock(heapBlock)
     {
     }
 
-    LargeHeapBlockFreeList* previous;
-    LargeHeapBlockFreeList* next;
     LargeHeapBlockFreeListEntry* entries;
     LargeHeapBlock* heapBlock;
 };
@@ -149,12 +148,17 @@ public:
     char* GetEndAddress() const { return addressEnd; }
 
     char * Alloc(DECLSPEC_GUARD_OVERFLOW size_t size, ObjectInfoBits attributes);
-    char * TryAllocFromFreeList(DECLSPEC_GUARD_OVERFLOW size_t size, ObjectInfoBits attributes);
+    char * AllocFromFreeList(DECLSPEC_GUARD_OVERFLOW size_t size, ObjectInfoBits attributes, LargeHeapBlockFreeListEntry* entry);
+
+    void ResetEmptyBlock();
+    void ReuseEmptyBlock(Recycler * recycler);
+    bool IsEmptyBlock() const { return allocCount == 0; }
 
     static size_t GetPagesNeeded(DECLSPEC_GUARD_OVERFLOW size_t size, bool multiplyRequest);
     static uint GetMaxLargeObjectCount(size_t pageCount, size_t firstAllocationSize);
 
     void EnumerateObjects(ObjectInfoBits infoBits, void (*CallBackFunction)(void * address, size_t size));
+    uint GetAllocatedObjectIndex(void * objectAddress);
 
 #ifdef RECYCLER_SLOW_CHECK_ENABLED
     void Check(bool expectFull, bool expectPending);
@@ -311,29 +311,49 @@ LargeHeapBucket::TryAllocFromFreeList(Recycler * recycler, size_t sizeCat, Objec
 {
     Assert((attributes & InternalObjectInfoBitMask) == attributes);
 
-    LargeHeapBlockFreeList* freeListEntry = this->freeList;
+    // Take the best fit from the request's own size class. Every entry in a larger
+    // size class can hold the request, so failing that, the first one found will do.
+    uint sizeClass = GetSizeClass(sizeCat);
+    LargeHeapBlockFreeListEntry ** bestEntryLink = nullptr;
+    for (LargeHeapBlockFreeListEntry ** entryLink = &this->freeListSizeClasses[sizeClass]; *entryLink != nullptr; entryLink = &(*entryLink)->nextInSizeClass)
+    {
+        size_t objectSize = (*entryLink)->objectSize;
+        if (objectSize >= sizeCat && (bestEntryLink == nullptr || objectSize < (*bestEntryLink)->objectSize))
+        {
+            bestEntryLink = entryLink;
+            if (objectSize == sizeCat)
+            {
+                break;
+            }
+        }
+    }
 
-    // Walk through the free list, find the first entry that can fit our desired size
-    while (freeListEntry)
+    for (uint i = sizeClass + 1; bestEntryLink == nullptr && i < SizeClassCount; i++)
     {
-        LargeHeapBlock* heapBlock = freeListEntry->heapBlock;
-
-        char * memBlock = heapBlock->TryAllocFromFreeList(sizeCat, attributes);
-        if (memBlock)
+        if (this->freeListSizeClasses[i] != nullptr)
         {
-            // Don't need to verify zero fill here since we will do it in LargeHeapBucket::Alloc
-            return memBlock;
+            bestEntryLink = &this->freeListSizeClasses[i];
         }
-        else
-        {
+    }
+
+    if (bestEntryLink == nullptr)
+    {
 #if DBG
-            LargeAllocationVerboseTrace(recycler->GetRecyclerFlagsTable(), _u("Unable to allocate object of size 0x%x from freelist\n"), sizeCat);
+        LargeAllocationVerboseTrace(recycler->GetRecyclerFlagsTable(), _u("Unable to allocate object of size 0x%x from freelist\n"), sizeCat);
 #endif
-        }
-
-        freeListEntry = freeListEntry->next;
+        return nullptr;
     }
-    return nullptr;
+
+    LargeHeapBlockFreeListEntry * entry = *bestEntryLink;
+    LargeHeapBlock * heapBlock = (LargeHeapBlock *)recycler->FindHeapBlock(entry);
+    Assert(heapBlock != nullptr && heapBlock->IsLargeHeapBlock());
+
+    (*bestEntryLink) = entry->nextInSizeClass;
+
+    // Don't need to verify zero fill here since we will do it in LargeHeapBucket::Alloc
+    char * memBlock = heapBlock->AllocFromFreeList(sizeCat, attributes, entry);
+    Assert(memBlock != nullptr);
+    return memBlock;
 }
 
 char *
@@ -526,6 +546,10 @@ LargeHeapBucket::Sweep(RecyclerSweep& recyclerSweep)
     Assert(!recyclerSweep.GetRecycler()->IsConcurrentExecutingState());
 #endif
 
+    // Empty blocks that went unused since the last sweep are given back now. The ones
+    // that sweep as empty this time take their place.
+    ReleaseFreeLargeHeapBlocks(recyclerSweep.GetRecycler());
+
     LargeHeapBlock * currentLargeObjectBlocks = largeBlockList;
 #ifdef RECYCLER_PAGE_HEAP
     LargeHeapBlock * currentLargePageHeapObjectBlocks = largePageHeapBlockList;
@@ -545,7 +569,7 @@ LargeHeapBucket::Sweep(RecyclerSweep& recyclerSweep)
 #if DBG
         LargeAllocationVerboseTrace(recyclerSweep.GetRecycler()->GetRecyclerFlagsTable(), _u("Resetting free list for 0x%x bucket\n"), this->sizeCat);
 #endif
-        this->freeList = nullptr;
+        memset(this->freeListSizeClasses, 0, sizeof(this->freeListSizeClasses));
         this->explicitFreeList = nullptr;
     }
 
@@ -566,8 +590,6 @@ LargeHeapBucket::SweepLargeHeapBlockList(RecyclerSweep& recyclerSweep, LargeHeap
     Recycler * recycler = recyclerSweep.GetRecycler();
     HeapBlockList::ForEachEditing(heapBlockList, [this, &recyclerSweep, recycler](LargeHeapBlock * heapBlock)
     {
-        this->UnregisterFreeList(heapBlock->GetFreeList());
-
         // CONCURRENT-TODO: Allow large block to be sweep in the background
         SweepState state = heapBlock->Sweep(recyclerSweep, false);
 
@@ -577,9 +599,12 @@ LargeHeapBucket::SweepLargeHeapBlockList(RecyclerSweep& recyclerSweep, LargeHeap
         switch (state)
         {
         case SweepStateEmpty:
-            heapBlock->ReleasePagesSweep(recycler);
-            LargeHeapBlock::Delete(heapBlock);
-            RECYCLER_SLOW_CHECK(this->heapInfo->heapBlockCount[HeapBlock::HeapBlockType::LargeBlockType]--);
+            if (!this->TryRetainFreeLargeHeapBlock(heapBlock))
+            {
+                heapBlock->ReleasePagesSweep(recycler);
+                LargeHeapBlock::Delete(heapBlock);
+                RECYCLER_SLOW_CHECK(this->heapInfo->heapBlockCount[HeapBlock::HeapBlockType::LargeBlockType]--);
+            }
             break;
         case SweepStateFull:
             heapBlock->SetNextBlock(this->fullLargeBlockList);
@@ -638,69 +663,156 @@ LargeHeapBucket::ReinsertLargeHeapBlock(LargeHeapBlock * heapBlock)
 }
 
 void
-LargeHeapBucket::RegisterFreeList(LargeHeapBlockFreeList* freeList)
+LargeHeapBucket::ConstructFreelist(LargeHeapBlock * heapBlock)
 {
-    Assert(freeList->next == nullptr);
-    Assert(freeList->previous == nullptr);
+    Assert(!heapBlock->hasPartialFreeObjects);
+    Assert(!heapBlock->IsInPendingDisposeList());
 
-    LargeHeapBlockFreeList* head = this->freeList;
+    // The free list is the only way we reuse heap block entries
+    // so if the heap block is allocated from directly, it'll not
+    // invalidate the free list
+    LargeHeapBlockFreeList* freeList = heapBlock->GetFreeList();
+    Assert(freeList);
 
-    if (head)
+    if (freeList->entries)
     {
-        head->previous = freeList;
+        for (LargeHeapBlockFreeListEntry * entry = freeList->entries; entry != nullptr; entry = entry->next)
+        {
+            uint sizeClass = GetSizeClass(entry->objectSize);
+            entry->nextInSizeClass = this->freeListSizeClasses[sizeClass];
+            this->freeListSizeClasses[sizeClass] = entry;
+        }
+
+#if DBG
+        LargeAllocationVerboseTrace(this->GetRecycler()->GetRecyclerFlagsTable(), _u("Free list created for 0x%x bucket\n"), this->sizeCat);
+#endif
     }
 
-    freeList->next = head;
-    this->freeList = freeList;
+    ReinsertLargeHeapBlock(heapBlock);
 }
 
-void
-LargeHeapBucket::UnregisterFreeList(LargeHeapBlockFreeList* freeList)
+uint
+LargeHeapBucket::GetSizeClass(size_t size)
 {
-    LargeHeapBlockFreeList* next = freeList->next;
-    LargeHeapBlockFreeList* previous = freeList->previous;
-
-    if (previous)
+    size_t pageCount = size / AutoSystemInfo::PageSize;
+    uint sizeClass = 0;
+    while (pageCount != 0 && sizeClass < SizeClassCount - 1)
     {
-        previous->next = next;
+        pageCount >>= 1;
+        sizeClass++;
     }
+    return sizeClass;
+}
 
-    if (next)
+bool
+LargeHeapBucket::TryRetainFreeLargeHeapBlock(LargeHeapBlock * heapBlock)
+{
+    // Buckets with free list support reuse space inside their blocks already, so this
+    // only applies to blocks that hold a single large object.
+    if (this->supportFreeList)
     {
-        next->previous = previous;
+        return false;
     }
 
-    freeList->next = nullptr;
-    freeList->previous = nullptr;
+#ifdef RECYCLER_PAGE_HEAP
+    if (heapBlock->InPageHeapMode())
+    {
+        return false;
+    }
+#endif
 
-    if (freeList == this->freeList)
+    size_t pageCount = heapBlock->GetPageCount();
+    if (this->freeLargeBlockPageCount + pageCount > MaxFreeLargeBlockPageCount)
     {
-        this->freeList = next;
+        return false;
     }
+
+    heapBlock->ResetEmptyBlock();
+
+    uint sizeClass = GetSizeClass(pageCount * AutoSystemInfo::PageSize);
+    heapBlock->SetNextBlock(this->freeLargeBlockLists[sizeClass]);
+    this->freeLargeBlockLists[sizeClass] = heapBlock;
+    this->freeLargeBlockPageCount += pageCount;
+    return true;
 }
 
 void
-LargeHeapBucket::ConstructFreelist(LargeHeapBlock * heapBlock)
+LargeHeapBucket::ReleaseFreeLargeHeapBlocks(Recycler * recycler)
 {
-    Assert(!heapBlock->hasPartialFreeObjects);
-    Assert(!heapBlock->IsInPendingDisposeList());
+    for (uint i = 0; i < SizeClassCount; i++)
+    {
+        HeapBlockList::ForEachEditing(this->freeLargeBlockLists[i], [this, recycler](LargeHeapBlock * heapBlock)
+        {
+            heapBlock->ReleasePagesSweep(recycler);
+            LargeHeapBlock::Delete(heapBlock);
+            RECYCLER_SLOW_CHECK(this->heapInfo->heapBlockCount[HeapBlock::HeapBlockType::LargeBlockType]--);
+        });
+        this->freeLargeBlockLists[i] = nullptr;
+    }
+    this->freeLargeBlockPageCount = 0;
+}
 
-    // The free list is the only way we reuse heap block entries
-    // so if the heap block is allocated from directly, it'll not
-    // invalidate the free list
-    LargeHeapBlockFreeList* freeList = heapBlock->GetFreeList();
-    Assert(freeList);
+LargeHeapBlock *
+LargeHeapBucket::TryReuseFreeLargeHeapBlock(size_t size)
+{
+    if (this->freeLargeBlockPageCount == 0)
+    {
+        return nullptr;
+    }
 
-    if (freeList->entries)
+    size_t pageCount = LargeHeapBlock::GetPagesNeeded(size, false);
+    if (pageCount == 0)
+    {
+        return nullptr;
+    }
+
+    // Best fit over the size class of the request and the next one up. The block is
+    // taken up by this one object until it dies, so don't hand out a block more than
+    // twice the size that was asked for.
+    uint sizeClass = GetSizeClass(pageCount * AutoSystemInfo::PageSize);
+    LargeHeapBlock ** bestBlockLink = nullptr;
+    for (uint i = sizeClass; i <= sizeClass + 1 && i < SizeClassCount; i++)
+    {
+        for (LargeHeapBlock ** blockLink = &this->freeLargeBlockLists[i]; *blockLink != nullptr; blockLink = &(*blockLink)->next)
+        {
+            size_t blockPageCount = (*blockLink)->GetPageCount();
+            if (blockPageCount >= pageCount && blockPageCount <= pageCount * 2 &&
+                (bestBlockLink == nullptr || blockPageCount < (*bestBlockLink)->GetPageCount()))
+            {
+                bestBlockLink = blockLink;
+            }
+        }
+
+        if (bestBlockLink != nullptr)
+        {
+            break;
+        }
+    }
+
+    if (bestBlockLink == nullptr)
     {
-        this->RegisterFreeList(freeList);
+        return nullptr;
+    }
 
+    LargeHeapBlock * heapBlock = *bestBlockLink;
+    (*bestBlockLink) = heapBlock->GetNextBlock();
+    this->freeLargeBlockPageCount -= heapBlock->GetPageCount();
+
+    Recycler * recycler = this->heapInfo->recycler;
+    heapBlock->ReuseEmptyBlock(recycler);
 #if DBG
-        LargeAllocationVerboseTrace(this->GetRecycler()->GetRecyclerFlagsTable(), _u("Free list created for 0x%x bucket\n"), this->sizeCat);
+    LargeAllocationVerboseTrace(recycler->GetRecyclerFlagsTable(), _u("Reusing empty large heap block 0x%p for size 0x%x\n"), heapBlock, size);
 #endif
-    }
 
-    ReinsertLargeHeapBlock(heapBlock);
+#if ENABLE_PARTIAL_GC
+    recycler->autoHeap.uncollectedNewPageCount += heapBlock->GetPageCount();
+#endif
+
+    heapBlock->SetNextBlock(this->largeBlockList);
+    this->largeBlockList = heapBlock;
+
+    RECYCLER_PERF_COUNTER_ADD(FreeObjectSize, heapBlock->GetPageCount() * AutoSystemInfo::PageSize);
+    return heapBlock;
 }
 
 #pragma endregion
@@ -961,6 +1073,10 @@ LargeHeapBucket::GetLargeHeapBlockCount(bool checkCount) const
     currentLargeHeapBlockCount += HeapBlockList::Count(largePageHeapBlockList);
 #endif
     currentLargeHeapBlockCount += HeapBlockList::Count(pendingDisposeLargeBlockList);
+    for (uint i = 0; i < SizeClassCount; i++)
+    {
+        currentLargeHeapBlockCount += HeapBlockList::Count(freeLargeBlockLists[i]);
+    }
 #if ENABLE_CONCURRENT_GC
     currentLargeHeapBlockCount += HeapBlockList::Count(pendingSweepLargeBlockList);
 #if ENABLE_PARTIAL_GC
@@ -989,6 +1105,10 @@ LargeHeapBucket::Check()
 #endif
 #endif
     currentLargeHeapBlockCount += Check(false, true, pendingDisposeLargeBlockList);
+    for (uint i = 0; i < SizeClassCount; i++)
+    {
+        currentLargeHeapBlockCount += Check(false, false, freeLargeBlockLists[i]);
+    }
     return currentLargeHeapBlockCount;
 }
 
@@ -17,8 +17,10 @@ class LargeHeapBucket: public HeapBucket
 public:
     LargeHeapBucket():
         supportFreeList(false),
-        freeList(nullptr),
+        freeListSizeClasses(),
         explicitFreeList(nullptr),
+        freeLargeBlockLists(),
+        freeLargeBlockPageCount(0),
         fullLargeBlockList(nullptr),
         largeBlockList(nullptr),
 #ifdef RECYCLER_PAGE_HEAP
@@ -39,6 +41,7 @@ public:
     void Initialize(HeapInfo * heapInfo, DECLSPEC_GUARD_OVERFLOW uint sizeCat, bool supportFreeList = false);
 
     LargeHeapBlock* AddLargeHeapBlock(DECLSPEC_GUARD_OVERFLOW size_t size, bool nothrow);
+    LargeHeapBlock* TryReuseFreeLargeHeapBlock(DECLSPEC_GUARD_OVERFLOW size_t size);
 
     template <ObjectInfoBits attributes, bool nothrow>
     char* Alloc(Recycler * recycler, size_t sizeCat);
@@ -54,9 +57,6 @@ public:
     void Sweep(RecyclerSweep& recyclerSweep);
     void ReinsertLargeHeapBlock(LargeHeapBlock * heapBlock);
 
-    void RegisterFreeList(LargeHeapBlockFreeList* freeList);
-    void UnregisterFreeList(LargeHeapBlockFreeList* freeList);
-
     void FinalizeAllObjects();
     void Finalize();
     void DisposeObjects();
@@ -105,6 +105,9 @@ private:
     void SweepLargeHeapBlockList(RecyclerSweep& recyclerSweep, LargeHeapBlock * heapBlockList);
 
     void ConstructFreelist(LargeHeapBlock * heapBlock);
+    bool TryRetainFreeLargeHeapBlock(LargeHeapBlock * heapBlock);
+    void ReleaseFreeLargeHeapBlocks(Recycler * recycler);
+    static uint GetSizeClass(size_t size);
 
     size_t Rescan(LargeHeapBlock * list, Recycler * recycler, bool isPartialSwept, RescanFlags flags);
 
@@ -121,10 +124,22 @@ private:
     LargeHeapBlock * partialSweptLargeBlockList;
 #endif
 #endif
+    // Free space is indexed by size class: class 0 holds sizes under a page, class n holds
+    // sizes of [2^(n-1), 2^n) pages, and the last class holds everything larger.
+    static const uint SizeClassCount = 8;
+
+    // Upper bound on the pages held by empty heap blocks kept for reuse between collections
+    static const size_t MaxFreeLargeBlockPageCount = 1024;
+
     bool supportFreeList;
-    LargeHeapBlockFreeList* freeList;
+    LargeHeapBlockFreeListEntry * freeListSizeClasses[SizeClassCount];
     FreeObject * explicitFreeList;
 
+    // Heap blocks that swept as empty, kept until the next sweep so that large allocations
+    // can reuse their pages instead of going back to the page allocator
+    LargeHeapBlock * freeLargeBlockLists[SizeClassCount];
+    size_t freeLargeBlockPageCount;
+
 
     friend class HeapInfo;
     friend class Recycler;
@@ -81,6 +81,10 @@ LargeHeapBucket::ForEachLargeHeapBlock(Fn fn)
     HeapBlockList::ForEach(largePageHeapBlockList, fn);
 #endif
     HeapBlockList::ForEach(pendingDisposeLargeBlockList, fn);
+    for (uint i = 0; i < SizeClassCount; i++)
+    {
+        HeapBlockList::ForEach(freeLargeBlockLists[i], fn);
+    }
 #if ENABLE_CONCURRENT_GC
     HeapBlockList::ForEach(pendingSweepLargeBlockList, fn);
 #if ENABLE_PARTIAL_GC
@@ -99,6 +103,10 @@ LargeHeapBucket::ForEachEditingLargeHeapBlock(Fn fn)
     HeapBlockList::ForEachEditing(largePageHeapBlockList, fn);
 #endif
     HeapBlockList::ForEachEditing(pendingDisposeLargeBlockList, fn);
+    for (uint i = 0; i < SizeClassCount; i++)
+    {
+        HeapBlockList::ForEachEditing(freeLargeBlockLists[i], fn);
+    }
 #if ENABLE_CONCURRENT_GC
     HeapBlockList::ForEachEditing(pendingSweepLargeBlockList, fn);
 #if ENABLE_PARTIAL_GC
@@ -20,6 +20,9 @@ private:
 public:
     static const int MarkCandidateSize = sizeof(MarkCandidate);
 
+    // Mark stack chunks shared between the threads of a parallel mark
+    typedef PageStack<MarkCandidate>::SharedChunkList SharedMarkStack;
+
     MarkContext(Recycler * recycler, PagePool * pagePool);
     ~MarkContext();
 
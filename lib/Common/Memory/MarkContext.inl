@@ -174,38 +174,60 @@ void MarkContext::ProcessMark()
     }
 #endif
 
+    // When marking in parallel, trade full mark stack chunks with the other threads through the
+    // Recycler's shared stack, and keep going for as long as any of them has work left.
+    SharedMarkStack * sharedMarkStack = parallel ? &recycler->parallelMarkSharedStack : nullptr;
+
 #if defined(_M_IX86) || defined(_M_X64)
     MarkCandidate current, next;
 
-    while (markStack.Pop(&current))
+    do
     {
-        // Process entries and prefetch as we go.
-        while (markStack.Pop(&next))
+        while (markStack.Pop(&current))
         {
-            // Prefetch the next entry so it's ready when we need it.
-            _mm_prefetch((char *)next.obj, _MM_HINT_T0);
+            // Process entries and prefetch as we go.
+            while (markStack.Pop(&next))
+            {
+                // Prefetch the next entry so it's ready when we need it.
+                _mm_prefetch((char *)next.obj, _MM_HINT_T0);
 
-            // Process the previously retrieved entry.
-            ScanObject<parallel, interior>(current.obj, current.byteCount);
+                // Process the previously retrieved entry.
+                ScanObject<parallel, interior>(current.obj, current.byteCount);
 
-            current = next;
-        }
+                current = next;
+
+                if (parallel && sharedMarkStack->IsStarving())
+                {
+                    sharedMarkStack->Give(&markStack);
+                }
+            }
 
-        // The stack is empty, but we still have a previously retrieved entry; process it now.
-        ScanObject<parallel, interior>(current.obj, current.byteCount);
+            // The stack is empty, but we still have a previously retrieved entry; process it now.
+            ScanObject<parallel, interior>(current.obj, current.byteCount);
 
-        // Processing that entry may have generated more entries in the mark stack, so continue the loop.
+            // Processing that entry may have generated more entries in the mark stack, so continue the loop.
+        }
     }
+    while (parallel && sharedMarkStack->Take(&markStack));
 #else
     // _mm_prefetch intrinsic is specific to Intel platforms.
     // CONSIDER: There does seem to be a compiler intrinsic for prefetch on ARM,
     // however, the information on this is scarce, so for now just don't do prefetch on ARM.
     MarkCandidate current;
 
-    while (markStack.Pop(&current))
+    do
     {
-        ScanObject<parallel, interior>(current.obj, current.byteCount);
+        while (markStack.Pop(&current))
+        {
+            ScanObject<parallel, interior>(current.obj, current.byteCount);
+
+            if (parallel && sharedMarkStack->IsStarving())
+            {
+                sharedMarkStack->Give(&markStack);
+            }
+        }
     }
+    while (parallel && sharedMarkStack->Take(&markStack));
 #endif
 
     Assert(markStack.IsEmpty());
@@ -8,6 +8,70 @@
 
 THREAD_LOCAL DWORD MemoryOperationLastError::MemOpLastError = 0;
 
+//=============================================================================================================
+// PageSegmentCache
+//=============================================================================================================
+
+PageSegmentCache PageSegmentCache::Instance;
+
+PageSegmentCache::PageSegmentCache() :
+    cachedSegments(nullptr),
+    cachedPageCount(0)
+{
+}
+
+bool
+PageSegmentCache::Add(__in char * address, size_t pageCount, size_t maxCachedPageCount)
+{
+    Assert(address != nullptr && pageCount != 0);
+
+    AutoCriticalSection autoCS(&cs);
+    if (cachedPageCount + pageCount > maxCachedPageCount)
+    {
+        return false;
+    }
+
+    CachedSegment * cachedSegment = (CachedSegment *)address;
+    cachedSegment->next = cachedSegments;
+    cachedSegment->pageCount = pageCount;
+    cachedSegments = cachedSegment;
+    cachedPageCount += pageCount;
+    return true;
+}
+
+char *
+PageSegmentCache::Remove(size_t pageCount)
+{
+    AutoCriticalSection autoCS(&cs);
+    CachedSegment ** link = &cachedSegments;
+    while (*link != nullptr)
+    {
+        CachedSegment * cachedSegment = *link;
+        if (cachedSegment->pageCount == pageCount)
+        {
+            *link = cachedSegment->next;
+            cachedPageCount -= pageCount;
+            return (char *)cachedSegment;
+        }
+        link = &cachedSegment->next;
+    }
+    return nullptr;
+}
+
+void
+PageSegmentCache::ReleaseAll()
+{
+    AutoCriticalSection autoCS(&cs);
+    while (cachedSegments != nullptr)
+    {
+        CachedSegment * cachedSegment = cachedSegments;
+        cachedSegments = cachedSegment->next;
+        cachedPageCount -= cachedSegment->pageCount;
+        VirtualAllocWrapper::Instance.Free(cachedSegment, cachedSegment->pageCount * AutoSystemInfo::PageSize, MEM_RELEASE, GetCurrentProcess());
+    }
+    Assert(cachedPageCount == 0);
+}
+
 //=============================================================================================================
 // Segment
 //=============================================================================================================
@@ -103,7 +167,22 @@ SegmentBase<T>::Initialize(DWORD allocFlags, bool excludeGuardPages)
         return false;
     }
 
-    this->address = (char *)GetAllocator()->GetVirtualAllocator()->Alloc(NULL, totalPages * AutoSystemInfo::PageSize, MEM_RESERVE | allocFlags, PAGE_READWRITE, this->IsInCustomHeapAllocator(), this->GetAllocator()->processHandle);
+    if (!addGuardPages && allocFlags == MEM_COMMIT && this->GetAllocator()->UseSegmentCache())
+    {
+        // Cached memory is still committed and read/write
+        this->address = PageSegmentCache::Instance.Remove(totalPages);
+#if DBG
+        if (this->address != nullptr)
+        {
+            memset(this->address, DbgMemFill, totalPages * AutoSystemInfo::PageSize);
+        }
+#endif
+    }
+
+    if (this->address == nullptr)
+    {
+        this->address = (char *)GetAllocator()->GetVirtualAllocator()->Alloc(NULL, totalPages * AutoSystemInfo::PageSize, MEM_RESERVE | allocFlags, PAGE_READWRITE, this->IsInCustomHeapAllocator(), this->GetAllocator()->processHandle);
+    }
 
     if (this->address == nullptr)
     {
@@ -204,6 +283,28 @@ PageSegmentBase<T>::PageSegmentBase(PageAllocatorBase<T> * allocator, void* addr
     this->segmentPageCount = pageCount;
 }
 
+template<typename T>
+PageSegmentBase<T>::~PageSegmentBase()
+{
+    // A fully committed segment of an arena page allocator goes to the process-wide cache
+    // instead of back to the OS. Clearing the address keeps SegmentBase from releasing it.
+    if (this->address != nullptr
+        && this->decommitPageCount == 0
+        && this->leadingGuardPageCount == 0
+        && this->trailingGuardPageCount == 0
+        && this->secondaryAllocator == nullptr
+        && this->GetAllocator()->UseSegmentCache()
+        && PageSegmentCache::Instance.Add(this->address, this->segmentPageCount,
+            this->GetAllocator()->GetSegmentCacheMaxPageCount()))
+    {
+        this->GetAllocator()->ReportFree(this->segmentPageCount * AutoSystemInfo::PageSize);
+#if defined(_M_X64_OR_ARM64) && defined(RECYCLER_WRITE_BARRIER_BYTE)
+        RecyclerWriteBarrierManager::OnSegmentFree(this->address, this->segmentPageCount);
+#endif
+        this->address = nullptr;
+    }
+}
+
 #ifdef PAGEALLOCATOR_PROTECT_FREEPAGE
 template<typename T>
 bool
@@ -683,6 +784,44 @@ PageAllocatorBase<T>::~PageAllocatorBase()
     PageTracking::PageAllocatorDestroyed((PageAllocator*)this);
 }
 
+template<typename T>
+bool
+PageAllocatorBase<T>::UseSegmentCache() const
+{
+#if defined(PAGEALLOCATOR_PROTECT_FREEPAGE)
+    // Free pages are left inaccessible, so the cache can't link through them
+    return false;
+#else
+#if defined(RECYCLER_NO_PAGE_REUSE) || defined(ARENA_MEMORY_VERIFY)
+    if (this->disablePageReuse)
+    {
+        return false;
+    }
+#endif
+    // Only arena page allocators take part. Their segments are plain read/write memory
+    // with no secondary allocations, and reused pages need not be zero.
+    return (this->type == PageAllocatorType_Thread || this->type == PageAllocatorType_BGJIT)
+        && !this->IsPreReservedPageAllocator()
+        && !this->ZeroPages()
+        && this->secondaryAllocPageCount == 0
+        && this->allocFlags == 0
+        && this->processHandle == GetCurrentProcess();
+#endif
+}
+
+template<typename T>
+size_t
+PageAllocatorBase<T>::GetSegmentCacheMaxPageCount() const
+{
+#ifdef ENABLE_DEBUG_CONFIG_OPTIONS
+    if (this->pageAllocatorFlagTable.IsEnabled(Js::ArenaPageCacheMaxPageCountFlag))
+    {
+        return (size_t)this->pageAllocatorFlagTable.ArenaPageCacheMaxPageCount;
+    }
+#endif
+    return DEFAULT_CONFIG_ArenaPageCacheMaxPageCount;
+}
+
 #if ENABLE_BACKGROUND_PAGE_ZEROING
 template<typename T>
 void
@@ -1669,6 +1808,20 @@ PageAllocatorBase<T>::ZeroQueuedPages()
         PageSegmentBase<T> * segment = freePageEntry->segment;
         uint pageCount = freePageEntry->pageCount;
 
+#ifdef __LINUX__
+        //
+        // The PAL implements MEM_RESET with madvise(MADV_DONTNEED); private anonymous
+        // pages read back as zero afterwards and their physical memory is released
+        // without touching (and caching) every byte.
+        //
+        if (pageCount >= MinResetZeroPageCount && this->processHandle == GetCurrentProcess() &&
+            ::VirtualAlloc(freePageEntry, pageCount * AutoSystemInfo::PageSize, MEM_RESET, PAGE_READWRITE) != nullptr)
+        {
+            QueuePages(freePageEntry, pageCount, segment);
+            continue;
+        }
+#endif
+
         //
         // Do memset via non-temporal store to avoid evicting existing processor cache.
         // This helps low-end machines with limited cache size.
@@ -2799,7 +2952,7 @@ char * PageSegmentBase<T>::DoAllocDecommitPages(uint pageCount)
 template<typename T>
 uint PageSegmentBase<T>::GetMaxPageCount()
 {
-    return MaxPageCount;
+    return MaxBitVectorPageCount;
 }
 
 namespace Memory
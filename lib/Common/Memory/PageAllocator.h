@@ -115,6 +115,39 @@ public:
     virtual ~SecondaryAllocator() {};
 };
 
+/*
+ * Process-wide cache of committed page segment memory. Arena page allocators
+ * (parser, bytecode generator, backend) hand the memory of released page segments
+ * here instead of freeing it, and new page segments of the same size are carved
+ * out of it before going to the OS. This cuts the VirtualAlloc/VirtualFree
+ * (mmap/munmap) churn when many short-lived arenas are created and torn down.
+ */
+class PageSegmentCache
+{
+public:
+    PageSegmentCache();
+
+    bool Add(__in char * address, size_t pageCount, size_t maxCachedPageCount);
+    char * Remove(size_t pageCount);
+    void ReleaseAll();
+
+    size_t GetCachedPageCount() const { return cachedPageCount; }
+
+    static PageSegmentCache Instance;
+
+private:
+    // Stored in the first page of the cached memory
+    struct CachedSegment
+    {
+        CachedSegment * next;
+        size_t pageCount;
+    };
+
+    CriticalSection cs;
+    CachedSegment * cachedSegments;
+    size_t cachedPageCount;
+};
+
 class PageAllocatorBaseCommon;
 
 class SegmentBaseCommon
@@ -229,12 +262,20 @@ class PageSegmentBase : public SegmentBase<TVirtualAlloc>
 public:
     PageSegmentBase(PageAllocatorBase<TVirtualAlloc> * allocator, bool committed, bool allocated);
     PageSegmentBase(PageAllocatorBase<TVirtualAlloc> * allocator, void* address, uint pageCount, uint committedCount);
+    virtual ~PageSegmentBase();
     // Maximum possible size of a PageSegment; may be smaller.
     static const uint MaxDataPageCount = 256;     // 1 MB
     static const uint MaxGuardPageCount = 16;
     static const uint MaxPageCount = MaxDataPageCount + MaxGuardPageCount;  // 272 Pages
+#if ENABLE_HUGE_PAGES
+    // Segments of a huge page allocator are one huge page and have no guard pages
+    static const uint MaxHugePageDataPageCount = 512;   // 2 MB
+    static const uint MaxBitVectorPageCount = MaxHugePageDataPageCount > MaxPageCount ? MaxHugePageDataPageCount : MaxPageCount;
+#else
+    static const uint MaxBitVectorPageCount = MaxPageCount;
+#endif
 
-    typedef BVStatic<MaxPageCount> PageBitVector;
+    typedef BVStatic<MaxBitVectorPageCount> PageBitVector;
 
     uint GetAvailablePageCount() const
     {
@@ -474,6 +515,12 @@ public:
     static uint const DefaultMaxAllocPageCount = 32;        // 128K
     static uint const DefaultSecondaryAllocPageCount = 0;
 
+#if ENABLE_BACKGROUND_PAGE_ZEROING && defined(__LINUX__)
+    // Queued runs of at least this many pages are zeroed by handing them back
+    // to the kernel (MEM_RESET) rather than writing them
+    static uint const MinResetZeroPageCount = 16;           // 64K
+#endif
+
     static size_t GetProcessUsedBytes();
 
     static size_t GetAndResetMaxUsedBytes();
@@ -652,6 +699,8 @@ protected:
 #endif
 
     bool ZeroPages() const { return zeroPages; }
+    bool UseSegmentCache() const;
+    size_t GetSegmentCacheMaxPageCount() const;
 #if ENABLE_BACKGROUND_PAGE_ZEROING
     bool QueueZeroPages() const { return queueZeroPages; }
 #endif
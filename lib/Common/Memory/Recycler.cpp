@@ -133,12 +133,8 @@ Recycler::Recycler(AllocationPolicyManager * policyManager, IdleDecommitPageAllo
     threadPageAllocator(pageAllocator),
     markPagePool(configFlagsTable),
     parallelMarkPagePool1(configFlagsTable),
-    parallelMarkPagePool2(configFlagsTable),
-    parallelMarkPagePool3(configFlagsTable),
     markContext(this, &this->markPagePool),
     parallelMarkContext1(this, &this->parallelMarkPagePool1),
-    parallelMarkContext2(this, &this->parallelMarkPagePool2),
-    parallelMarkContext3(this, &this->parallelMarkPagePool3),
 #if ENABLE_PARTIAL_GC
     clientTrackedObjectAllocator(_u("CTO-List"), GetPageAllocator(), Js::Throw::OutOfMemory),
 #endif
@@ -163,13 +159,20 @@ Recycler::Recycler(AllocationPolicyManager * policyManager, IdleDecommitPageAllo
     enableConcurrentMark(false),  // Default to non-concurrent
     enableParallelMark(false),
     enableConcurrentSweep(false),
+    enableParallelSweep(false),
     concurrentThread(NULL),
     concurrentWorkReadyEvent(NULL),
     concurrentWorkDoneEvent(NULL),
-    parallelThread1(this, &Recycler::ParallelWorkFunc<0>),
-    parallelThread2(this, &Recycler::ParallelWorkFunc<1>),
+    parallelMarkHelperCount(0),
     priorityBoost(false),
     isAborting(false),
+    hasIdleDeadline(false),
+    idleDeadlineTick(0),
+    backgroundFinalizeThread(this, &Recycler::BackgroundFinalizeWorkFunc, 0),
+    backgroundFinalizeQueue(nullptr),
+    isBackgroundFinalizing(false),
+    hasBackgroundFinalizeWork(false),
+    enableBackgroundFinalization(false),
 #if DBG
     concurrentThreadExited(true),
     isProcessingTrackedObjects(false),
@@ -216,6 +219,7 @@ Recycler::Recycler(AllocationPolicyManager * policyManager, IdleDecommitPageAllo
     inExhaustiveCollection(false),
     hasExhaustiveCandidate(false),
     inDecommitNowCollection(false),
+    inCompactCollection(false),
     inCacheCleanupCollection(false),
     hasPendingDeleteGuestArena(false),
     needOOMRescan(false),
@@ -260,8 +264,6 @@ Recycler::Recycler(AllocationPolicyManager * policyManager, IdleDecommitPageAllo
     this->markMap = NoCheckHeapNew(MarkMap, &NoCheckHeapAllocator::Instance, 163, &markMapCriticalSection);
     markContext.SetMarkMap(markMap);
     parallelMarkContext1.SetMarkMap(markMap);
-    parallelMarkContext2.SetMarkMap(markMap);
-    parallelMarkContext3.SetMarkMap(markMap);
 #endif
 
 #ifdef RECYCLER_MEMORY_VERIFY
@@ -331,8 +333,6 @@ Recycler::Recycler(AllocationPolicyManager * policyManager, IdleDecommitPageAllo
     // recycler requires at least Recycler::PrimaryMarkStackReservedPageCount to function properly for the main mark context
     this->markContext.SetMaxPageCount(max(static_cast<size_t>(GetRecyclerFlagsTable().MaxMarkStackPageCount), static_cast<size_t>(Recycler::PrimaryMarkStackReservedPageCount)));
     this->parallelMarkContext1.SetMaxPageCount(GetRecyclerFlagsTable().MaxMarkStackPageCount);
-    this->parallelMarkContext2.SetMaxPageCount(GetRecyclerFlagsTable().MaxMarkStackPageCount);
-    this->parallelMarkContext3.SetMaxPageCount(GetRecyclerFlagsTable().MaxMarkStackPageCount);
 
     if (GetRecyclerFlagsTable().IsEnabled(Js::GCMemoryThresholdFlag))
     {
@@ -515,8 +515,9 @@ Recycler::~Recycler()
 
     markContext.Release();
     parallelMarkContext1.Release();
-    parallelMarkContext2.Release();
-    parallelMarkContext3.Release();
+#if ENABLE_CONCURRENT_GC
+    DeleteParallelMarkHelpers();
+#endif
 
     // Clean up the weak reference map so that
     // objects being finalized can safely refer to weak references
@@ -831,7 +832,8 @@ Recycler::Initialize(const bool forceInThread, JsUtil::ThreadService *threadServ
 #if ENABLE_CONCURRENT_GC
     // Default to non-concurrent
     uint numProcs = (uint)AutoSystemInfo::Data.GetNumberOfPhysicalProcessors();
-    this->maxParallelism = (numProcs > 4) || CUSTOM_PHASE_FORCE1(GetRecyclerFlagsTable(), Js::ParallelMarkPhase) ? 4 : numProcs;
+    uint maxParallelMarkThreadCount = RecyclerHeuristic::MaxParallelMarkThreadCount(GetRecyclerFlagsTable());
+    this->maxParallelism = (numProcs > maxParallelMarkThreadCount) || CUSTOM_PHASE_FORCE1(GetRecyclerFlagsTable(), Js::ParallelMarkPhase) ? maxParallelMarkThreadCount : numProcs;
 
     if (forceInThread)
     {
@@ -880,6 +882,28 @@ Recycler::Initialize(const bool forceInThread, JsUtil::ThreadService *threadServ
 #else
     Assert(!needWriteWatch);
 #endif
+
+#if ENABLE_HUGE_PAGES
+    // Write watch write protects and unprotects single pages, which splits a huge
+    // page back into small pages. Only the allocators that aren't write watched are
+    // backed with huge pages.
+    if (GetRecyclerFlagsTable().HugePages)
+    {
+#ifdef RECYCLER_WRITE_BARRIER_ALLOC_SEPARATE_PAGE
+        // Never write watched: the software write barrier tracks its objects instead
+        recyclerWithBarrierPageAllocator.EnableHugePages(true);
+#endif
+
+        // The other allocators are write watched for concurrent and partial collection.
+        // Large block segments are sized to their allocation; only the small block
+        // page segments are grown to a huge page.
+        if (!needWriteWatch)
+        {
+            recyclerPageAllocator.EnableHugePages(true);
+            recyclerLargeBlockPageAllocator.EnableHugePages(false);
+        }
+    }
+#endif
 }
 
 #if DBG
@@ -924,6 +948,7 @@ void
 Recycler::AddExternalMemoryUsage(size_t size)
 {
     this->autoHeap.uncollectedAllocBytes += size;
+    this->autoHeap.totalAllocBytes += size;
     this->autoHeap.uncollectedExternalBytes += size;
     // Generally normal GC can cleanup the uncollectedAllocBytes. But if external components
     // do fast large allocations in a row, normal GC might not kick in. Let's force the GC
@@ -1204,9 +1229,8 @@ Recycler::TryLargeAlloc(HeapInfo * heap, size_t size, ObjectInfoBits attributes,
         }
     }
 
-    // We don't care whether a GC happened here or not, because we are not reusing freed
-    // large objects. We might try to allocate from existing block if we implement
-    // large object reuse.
+    // We don't care whether a GC happened here or not. Either way, empty blocks kept by
+    // the last sweep are reused below before we add a new heap block.
     if (!this->disableCollectOnAllocationHeuristics)
     {
         CollectNow<CollectOnAllocation>();
@@ -1229,10 +1253,14 @@ Recycler::TryLargeAlloc(HeapInfo * heap, size_t size, ObjectInfoBits attributes,
     }
 #endif
 
-    LargeHeapBlock * heapBlock = heap->AddLargeHeapBlock(sizeCat);
+    LargeHeapBlock * heapBlock = heap->largeObjectBucket.TryReuseFreeLargeHeapBlock(sizeCat);
     if (heapBlock == nullptr)
     {
-        return nullptr;
+        heapBlock = heap->AddLargeHeapBlock(sizeCat);
+        if (heapBlock == nullptr)
+        {
+            return nullptr;
+        }
     }
     memBlock = heapBlock->Alloc(sizeCat, attributes);
     Assert(memBlock != nullptr);
@@ -1269,6 +1297,7 @@ Recycler::LargeAlloc(HeapInfo* heap, size_t size, ObjectInfoBits attributes)
         }
     }
     autoHeap.uncollectedAllocBytes += size;
+    autoHeap.totalAllocBytes += size;
     return addr;
 }
 
@@ -2022,6 +2051,9 @@ Recycler::ProcessParallelMark(bool background, MarkContext * markContext)
 
     RECYCLER_PROFILE_EXEC_THREAD_BEGIN(background, this, Js::MarkPhase);
 
+    // Join before marking so the other threads keep waiting for chunks we may give them
+    this->parallelMarkSharedStack.Join();
+
     if (this->enableScanInteriorPointers)
     {
         this->ProcessMarkContext</* parallel */ true, /* interior */ true>(markContext);
@@ -2046,6 +2078,8 @@ Recycler::ProcessParallelMark(bool background, MarkContext * markContext)
 void
 Recycler::Mark()
 {
+    AutoRecyclerGCPhaseTimer markTimer(&this->gcStatistics.markTime);
+
     // Marking in thread, we can just pre-mark them
     ResetMarks(this->enableScanImplicitRoots ? ResetMarkFlags_InThreadImplicitRoots : ResetMarkFlags_InThread);
     collectionState = CollectionStateFindRoots;
@@ -2093,6 +2127,7 @@ Recycler::ResetCollectionState()
 #endif
     this->inExhaustiveCollection = false;
     this->inDecommitNowCollection = false;
+    this->inCompactCollection = false;
 
 #if ENABLE_CONCURRENT_GC
     CleanupPendingUnroot();
@@ -2113,6 +2148,30 @@ Recycler::ResetCollectionState()
 #endif
 }
 
+template <class Fn>
+void
+Recycler::ForEachParallelMarkContext(Fn fn)
+{
+    fn(&parallelMarkContext1);
+#if ENABLE_CONCURRENT_GC
+    for (uint i = 0; i < this->parallelMarkHelperCount; i++)
+    {
+        fn(&this->parallelMarkHelpers[i]->markContext);
+    }
+#endif
+}
+
+void
+Recycler::ClearNeedOOMRescan()
+{
+    this->needOOMRescan = false;
+    markContext.GetPageAllocator()->ResetDisableAllocationOutOfMemory();
+    ForEachParallelMarkContext([](MarkContext * parallelMarkContext)
+    {
+        parallelMarkContext->GetPageAllocator()->ResetDisableAllocationOutOfMemory();
+    });
+}
+
 void
 Recycler::ResetMarkCollectionState()
 {
@@ -2123,8 +2182,12 @@ Recycler::ResetMarkCollectionState()
     // If we aborted after doing a background parallel Mark, we wouldn't have cleaned up the
     // parallel markContexts yet. Clean these up now.
     // Note parallelMarkContext1 is not used in background parallel (see DoBackgroundParallelMark)
-    parallelMarkContext2.Cleanup();
-    parallelMarkContext3.Cleanup();
+#if ENABLE_CONCURRENT_GC
+    for (uint i = 0; i < this->parallelMarkHelperCount; i++)
+    {
+        this->parallelMarkHelpers[i]->markContext.Cleanup();
+    }
+#endif
 
     this->ClearNeedOOMRescan();
     DebugOnly(this->isProcessingRescan = false);
@@ -2162,7 +2225,8 @@ void Recycler::ResetPartialHeuristicCounters()
 void
 Recycler::ScheduleNextCollection()
 {
-    this->tickCountNextCollection = ::GetTickCount() + RecyclerHeuristic::TickCountCollection;
+    RecyclerHeuristic::Instance.UpdateMemoryPressure();
+    this->tickCountNextCollection = ::GetTickCount() + RecyclerHeuristic::Instance.GetTickCountCollection();
     this->tickCountNextFinishCollection = ::GetTickCount() + RecyclerHeuristic::TickCountFinishCollection;
 }
 
@@ -2243,6 +2307,7 @@ Recycler::RescanMark(DWORD waitTime)
 size_t
 Recycler::FinishMark(DWORD waitTime)
 {
+    AutoRecyclerGCPhaseTimer markTimer(&this->gcStatistics.markTime);
     size_t scannedRootBytes = RescanMark(waitTime);
     Assert(waitTime != INFINITE || scannedRootBytes != Recycler::InvalidScanRootBytes);
     if (scannedRootBytes != Recycler::InvalidScanRootBytes)
@@ -2282,14 +2347,20 @@ void
 Recycler::DoParallelMark()
 {
     Assert(this->enableParallelMark);
-    Assert(this->maxParallelism > 1 && this->maxParallelism <= 4);
+    Assert(this->maxParallelism > 1 && this->maxParallelism <= this->parallelMarkHelperCount + 2);
 
-    // Split the mark stack into [this->maxParallelism] equal pieces.
+    // Split the mark stack into [this->maxParallelism] equal pieces: the main thread takes parallelMarkContext1,
+    // the concurrent thread keeps markContext and each helper thread takes its own context.
     // The actual # of splits is returned, in case the stack was too small to split that many ways.
-    MarkContext * splitContexts[3] = { &parallelMarkContext1, &parallelMarkContext2, &parallelMarkContext3 };
+    MarkContext * splitContexts[MaxParallelism - 1];
+    splitContexts[0] = &parallelMarkContext1;
+    for (uint i = 0; i < this->maxParallelism - 2; i++)
+    {
+        splitContexts[i + 1] = &this->parallelMarkHelpers[i]->markContext;
+    }
     uint actualSplitCount = markContext.Split(this->maxParallelism - 1, splitContexts);
 
-    Assert(actualSplitCount <= 3);
+    Assert(actualSplitCount <= this->maxParallelism - 1);
 
     // If we failed to split at all, just mark in thread with no parallelism.
     if (actualSplitCount == 0)
@@ -2312,14 +2383,13 @@ Recycler::DoParallelMark()
 
     // If there's enough work to split, then kick off marking on parallel threads too.
     // If the threads haven't been created yet, this will create them (or fail).
-    bool parallelSuccess1 = false;
-    bool parallelSuccess2 = false;
-    if (concurrentSuccess && actualSplitCount >= 2)
+    const uint helperCount = actualSplitCount - 1;
+    uint startedHelperCount = 0;
+    if (concurrentSuccess)
     {
-        parallelSuccess1 = parallelThread1.StartConcurrent();
-        if (parallelSuccess1 && actualSplitCount == 3)
+        while (startedHelperCount < helperCount && this->parallelMarkHelpers[startedHelperCount]->parallelThread.StartConcurrent())
         {
-            parallelSuccess2 = parallelThread2.StartConcurrent();
+            startedHelperCount++;
         }
     }
 
@@ -2337,30 +2407,20 @@ Recycler::DoParallelMark()
         this->ProcessParallelMark(false, &markContext);
     }
 
-    if (actualSplitCount >= 2)
+    for (uint i = 0; i < helperCount; i++)
     {
-        if (parallelSuccess1)
+        if (i < startedHelperCount)
         {
-            parallelThread1.WaitForConcurrent();
+            this->parallelMarkHelpers[i]->parallelThread.WaitForConcurrent();
         }
         else
         {
-            this->ProcessParallelMark(false, &parallelMarkContext2);
-        }
-
-        if (actualSplitCount == 3)
-        {
-            if (parallelSuccess2)
-            {
-                parallelThread2.WaitForConcurrent();
-            }
-            else
-            {
-                this->ProcessParallelMark(false, &parallelMarkContext3);
-            }
+            this->ProcessParallelMark(false, &this->parallelMarkHelpers[i]->markContext);
         }
     }
 
+    Assert(this->parallelMarkSharedStack.IsEmpty());
+
     this->collectionState = CollectionStateMark;
 
     // Process tracked objects, if any, then do one final mark phase in case they marked any new objects.
@@ -2386,20 +2446,22 @@ Recycler::DoBackgroundParallelMark()
 {
     // Split the mark stack into [this->maxParallelism - 1] equal pieces (thus, "- 2" below).
     // The actual # of splits is returned, in case the stack was too small to split that many ways.
-    // The parallel threads are hardwired to use parallelMarkContext2/3, so we split using those.
+    // The main thread is running script, so only the helper threads' contexts are split targets.
     uint actualSplitCount = 0;
-    MarkContext * splitContexts[2] = { &parallelMarkContext2, &parallelMarkContext3 };
+    MarkContext * splitContexts[MaxParallelism - 2];
     if (this->enableParallelMark)
     {
-        Assert(this->maxParallelism > 1 && this->maxParallelism <= 4);
+        Assert(this->maxParallelism > 1 && this->maxParallelism <= this->parallelMarkHelperCount + 2);
         if (this->maxParallelism > 2)
         {
+            for (uint i = 0; i < this->maxParallelism - 2; i++)
+            {
+                splitContexts[i] = &this->parallelMarkHelpers[i]->markContext;
+            }
             actualSplitCount = markContext.Split(this->maxParallelism - 2, splitContexts);
         }
     }
 
-    Assert(actualSplitCount <= 2);
-
     // If we failed to split at all, just mark in thread with no parallelism.
     if (actualSplitCount == 0)
     {
@@ -2418,12 +2480,10 @@ Recycler::DoBackgroundParallelMark()
 
     // Kick off marking on parallel threads too, if there is work for them
     // If the threads haven't been created yet, this will create them (or fail).
-    bool parallelSuccess1 = false;
-    bool parallelSuccess2 = false;
-    parallelSuccess1 = parallelThread1.StartConcurrent();
-    if (parallelSuccess1 && actualSplitCount == 2)
+    uint startedHelperCount = 0;
+    while (startedHelperCount < actualSplitCount && this->parallelMarkHelpers[startedHelperCount]->parallelThread.StartConcurrent())
     {
-        parallelSuccess2 = parallelThread2.StartConcurrent();
+        startedHelperCount++;
     }
 
     // Process our portion of the split.
@@ -2431,27 +2491,20 @@ Recycler::DoBackgroundParallelMark()
 
     // If we successfully launched parallel work, wait for it to complete.
     // If we failed, then process the work in-thread now.
-    if (parallelSuccess1)
+    for (uint i = 0; i < actualSplitCount; i++)
     {
-        parallelThread1.WaitForConcurrent();
-    }
-    else
-    {
-        this->ProcessParallelMark(true, &parallelMarkContext2);
-    }
-
-    if (actualSplitCount == 2)
-    {
-        if (parallelSuccess2)
+        if (i < startedHelperCount)
         {
-            parallelThread2.WaitForConcurrent();
+            this->parallelMarkHelpers[i]->parallelThread.WaitForConcurrent();
         }
         else
         {
-            this->ProcessParallelMark(true, &parallelMarkContext3);
+            this->ProcessParallelMark(true, &this->parallelMarkHelpers[i]->markContext);
         }
     }
 
+    Assert(this->parallelMarkSharedStack.IsEmpty());
+
     this->collectionState = CollectionStateConcurrentMark;
 }
 #endif
@@ -2570,15 +2623,11 @@ Recycler::EndMark()
     // Clean up mark contexts, which will release held free pages
     // Do this for all contexts before we decommit, to make sure all pages are freed
     markContext.Cleanup();
-    parallelMarkContext1.Cleanup();
-    parallelMarkContext2.Cleanup();
-    parallelMarkContext3.Cleanup();
+    ForEachParallelMarkContext([](MarkContext * parallelMarkContext) { parallelMarkContext->Cleanup(); });
 
     // Decommit all pages
     markContext.DecommitPages();
-    parallelMarkContext1.DecommitPages();
-    parallelMarkContext2.DecommitPages();
-    parallelMarkContext3.DecommitPages();
+    ForEachParallelMarkContext([](MarkContext * parallelMarkContext) { parallelMarkContext->DecommitPages(); });
 
     GCETW(GC_DECOMMIT_CONCURRENT_COLLECT_PAGE_ALLOCATOR_STOP, (this));
 
@@ -2665,9 +2714,12 @@ Recycler::EndMarkOnLowMemory()
     while (this->NeedOOMRescan());
 
     Assert(!markContext.GetPageAllocator()->DisableAllocationOutOfMemory());
-    Assert(!parallelMarkContext1.GetPageAllocator()->DisableAllocationOutOfMemory());
-    Assert(!parallelMarkContext2.GetPageAllocator()->DisableAllocationOutOfMemory());
-    Assert(!parallelMarkContext3.GetPageAllocator()->DisableAllocationOutOfMemory());
+#if DBG
+    ForEachParallelMarkContext([](MarkContext * parallelMarkContext)
+    {
+        Assert(!parallelMarkContext->GetPageAllocator()->DisableAllocationOutOfMemory());
+    });
+#endif
     CUSTOM_PHASE_PRINT_TRACE1(GetRecyclerFlagsTable(), Js::RecyclerPhase, _u("EndMarkOnLowMemory iterations: %d\n"), iterations);
 
 #if ENABLE_PARTIAL_GC
@@ -2692,9 +2744,52 @@ Recycler::EndMarkOnLowMemory()
 bool
 Recycler::IsMarkStackEmpty()
 {
-    return (markContext.IsEmpty() && parallelMarkContext1.IsEmpty() && parallelMarkContext2.IsEmpty() && parallelMarkContext3.IsEmpty());
+    bool isEmpty = markContext.IsEmpty();
+    ForEachParallelMarkContext([&](MarkContext * parallelMarkContext)
+    {
+        isEmpty = parallelMarkContext->IsEmpty() && isEmpty;
+    });
+    return isEmpty && this->parallelMarkSharedStack.IsEmpty();
+}
+#endif
+
+bool
+Recycler::HasPendingMarkObjects() const
+{
+    if (markContext.HasPendingMarkObjects() || parallelMarkContext1.HasPendingMarkObjects())
+    {
+        return true;
+    }
+#if ENABLE_CONCURRENT_GC
+    for (uint i = 0; i < this->parallelMarkHelperCount; i++)
+    {
+        if (this->parallelMarkHelpers[i]->markContext.HasPendingMarkObjects())
+        {
+            return true;
+        }
+    }
+#endif
+    return false;
 }
+
+bool
+Recycler::HasPendingTrackObjects() const
+{
+    if (markContext.HasPendingTrackObjects() || parallelMarkContext1.HasPendingTrackObjects())
+    {
+        return true;
+    }
+#if ENABLE_CONCURRENT_GC
+    for (uint i = 0; i < this->parallelMarkHelperCount; i++)
+    {
+        if (this->parallelMarkHelpers[i]->markContext.HasPendingTrackObjects())
+        {
+            return true;
+        }
+    }
 #endif
+    return false;
+}
 
 #ifdef HEAP_ENUMERATION_VALIDATION
 void
@@ -2757,6 +2852,14 @@ Recycler::FindHeapObjectWithClearedAllocators(void* candidate, RecyclerHeapObjec
     return FindHeapObject(candidate, FindHeapObjectFlags_ClearedAllocators, heapObject);
 }
 
+bool
+Recycler::FindHeapObjectFromInterior(void* candidate, RecyclerHeapObjectInfo& heapObject)
+{
+    // Unlike FindHeapObjectFlags_AllowInterior, this doesn't require the candidate to be object aligned
+    void * objectAddress = GetRealAddressFromInterior(candidate);
+    return objectAddress != nullptr && FindHeapObject(objectAddress, FindHeapObjectFlags_NoFlags, heapObject);
+}
+
 void*
 Recycler::GetRealAddressFromInterior(void* candidate)
 {
@@ -2836,6 +2939,9 @@ Recycler::Sweep(bool concurrent)
     RECYCLER_PROFILE_EXEC_END(this, concurrent? Js::ConcurrentSweepPhase : Js::SweepPhase);
 
 #if ENABLE_CONCURRENT_GC
+    // Finalizers run by the in-thread part of the sweep may have queued callbacks for the finalize helper thread
+    StartBackgroundFinalize();
+
     if (concurrent)
     {
         if (!StartConcurrent(CollectionStateConcurrentSweep))
@@ -2909,9 +3015,47 @@ Recycler::SweepWeakReference()
     RECYCLER_PROFILE_EXEC_END(this, Js::SweepWeakPhase);
 }
 
+#if ENABLE_CONCURRENT_GC
+bool
+Recycler::DoParallelSweep()
+{
+    // Objects are swept one at a time when something is watching them being freed,
+    // and those notifications aren't safe to make from several threads.
+    return this->enableParallelSweep && this->parallelMarkHelperCount != 0 && !this->ForceSweepObject();
+}
+
+void
+Recycler::DoBackgroundParallelSweep(RecyclerSweep& recyclerSweep)
+{
+    Assert(this->enableParallelSweep);
+    Assert(this->collectionState == CollectionStateConcurrentSweep);
+    Assert(recyclerSweep.IsBackground());
+    Assert(this->maxParallelism > 2 && this->maxParallelism <= this->parallelMarkHelperCount + 2);
+
+    autoHeap.StartParallelSweep();
+
+    // Kick off sweeping on the parallel threads. Any that fail to start just don't take part;
+    // the buckets are claimed as we go, so this thread sweeps whatever is left.
+    const uint helperCount = this->maxParallelism - 2;
+    uint startedHelperCount = 0;
+    while (startedHelperCount < helperCount && this->parallelMarkHelpers[startedHelperCount]->parallelThread.StartConcurrent())
+    {
+        startedHelperCount++;
+    }
+
+    autoHeap.ParallelSweepSmallNonFinalizable(recyclerSweep);
+
+    for (uint i = 0; i < startedHelperCount; i++)
+    {
+        this->parallelMarkHelpers[i]->parallelThread.WaitForConcurrent();
+    }
+}
+#endif
+
 void
 Recycler::SweepHeap(bool concurrent, RecyclerSweep& recyclerSweep)
 {
+    AutoRecyclerGCPhaseTimer sweepTimer(&this->gcStatistics.sweepTime);
     Assert(!this->hasPendingDeleteGuestArena);
     Assert(!this->isHeapEnumInProgress);
 
@@ -3008,6 +3152,7 @@ Recycler::DisposeObjects()
 
     GCETW(GC_DISPOSE_START, (this));
     ASYNC_HOST_OPERATION_START(collectionWrapper);
+    AutoRecyclerGCPhaseTimer disposeTimer(&this->gcStatistics.disposeTime);
 
     this->inDispose = true;
 
@@ -3213,6 +3358,7 @@ template BOOL Recycler::CollectNow<CollectExhaustiveCandidate>();
 template BOOL Recycler::CollectNow<CollectNowConcurrent>();
 template BOOL Recycler::CollectNow<CollectNowExhaustive>();
 template BOOL Recycler::CollectNow<CollectNowDecommitNowExplicit>();
+template BOOL Recycler::CollectNow<CollectNowCompact>();
 template BOOL Recycler::CollectNow<CollectNowPartial>();
 template BOOL Recycler::CollectNow<CollectNowConcurrentPartial>();
 template BOOL Recycler::CollectNow<CollectNowForceInThread>();
@@ -3358,7 +3504,7 @@ Recycler::CollectWithHeuristic()
         Assert(enablePartialCollect);
         Assert(allocSize);
         Assert(this->uncollectedNewPageCountPartialCollect >= RecyclerSweep::MinPartialUncollectedNewPageCount
-            && this->uncollectedNewPageCountPartialCollect <= RecyclerHeuristic::Instance.MaxPartialUncollectedNewPageCount);
+            && this->uncollectedNewPageCountPartialCollect <= RecyclerHeuristic::PartialCollectNurseryPageCount(this->GetRecyclerFlagsTable()));
 
         // PARTIAL-GC-REVIEW: For now, we have only alloc size heuristic
         // Maybe improve this heuristic by looking at how many free pages are in the page allocator.
@@ -3376,7 +3522,7 @@ Recycler::CollectWithHeuristic()
     }
 
     // time heuristic, allocate every 1000 clock tick, or 64 MB is allocated in a short time
-    if (timed && (autoHeap.uncollectedAllocBytes < RecyclerHeuristic::Instance.MaxUncollectedAllocBytes))
+    if (timed && (autoHeap.uncollectedAllocBytes < RecyclerHeuristic::Instance.GetMaxUncollectedAllocBytes()))
     {
         uint currentTickCount = GetTickCount();
 #ifdef RECYCLER_TRACE
@@ -3451,6 +3597,7 @@ void Recycler::SetupPostCollectionFlags()
     const BOOL exhaustive = flags & CollectMode_Exhaustive;
     const BOOL decommitNow = flags & CollectMode_DecommitNow;
     const BOOL cacheCleanup = flags & CollectMode_CacheCleanup;
+    const BOOL compact = flags & CollectMode_Compact;
 
     if (decommitNow)
     {
@@ -3464,6 +3611,10 @@ void Recycler::SetupPostCollectionFlags()
     {
         this->inCacheCleanupCollection = true;
     }
+    if (compact && !CUSTOM_PHASE_OFF1(GetRecyclerFlagsTable(), Js::CompactPhase))
+    {
+        this->inCompactCollection = true;
+    }
 }
 
 BOOL
@@ -3475,6 +3626,7 @@ Recycler::DoCollectWrapped(CollectionFlags flags)
 #endif
 
     this->allowDispose = (flags & CollectOverride_AllowDispose) == CollectOverride_AllowDispose;
+    AutoRecyclerGCPauseTimer pauseTimer(&this->gcStatistics);
     BOOL collected = collectionWrapper->ExecuteRecyclerCollectionFunction(this, &Recycler::DoCollect, flags);
 
 #if ENABLE_CONCURRENT_GC
@@ -3591,6 +3743,10 @@ Recycler::DoCollect(CollectionFlags flags)
 
         hasExhaustiveCandidate = false;         // reset the candidate detection
 
+        this->gcStatistics.collectionCount++;
+        this->gcStatistics.heapSizeBeforeLastCollection = this->GetUsedBytes();
+        this->gcStatistics.peakHeapSize = max(this->gcStatistics.peakHeapSize, this->gcStatistics.heapSizeBeforeLastCollection);
+
 #ifdef RECYCLER_STATS
 #if ENABLE_PARTIAL_GC
         RecyclerCollectionStats oldCollectionStats = collectionStats;
@@ -3623,6 +3779,7 @@ Recycler::DoCollect(CollectionFlags flags)
 #endif
             Assert(enablePartialCollect && inPartialCollectMode);
 
+            this->gcStatistics.partialCollectionCount++;
             if (!this->PartialCollect(concurrent))
             {
                 return collected;
@@ -3669,6 +3826,7 @@ Recycler::DoCollect(CollectionFlags flags)
             {
                 if (StartBackgroundMarkCollect())
                 {
+                    this->gcStatistics.concurrentCollectionCount++;
                     // Tell the caller whether we have finish a collection and there maybe free object to reuse
                     return collected;
                 }
@@ -3755,6 +3913,7 @@ Recycler::EndCollection()
         ForRecyclerPageAllocator(DecommitNow());
         this->inDecommitNowCollection = false;
     }
+    this->inCompactCollection = false;
 
     RECORD_TIMESTAMP(lastCollectionEndTime);
 }
@@ -3956,9 +4115,12 @@ Recycler::BackgroundRescan(RescanFlags rescanFlags)
     GCETW(GC_BACKGROUNDRESCAN_START, (this, backgroundRescanCount));
     RECYCLER_PROFILE_EXEC_BACKGROUND_BEGIN(this, Js::BackgroundRescanPhase);
 
-    size_t rescannedPageCount = heapBlockMap.Rescan(this, ((rescanFlags & RescanFlags_ResetWriteWatch) != 0));
-
-    rescannedPageCount += autoHeap.Rescan(rescanFlags);
+    size_t rescannedPageCount;
+    {
+        AutoRecyclerGCPhaseTimer rescanTimer(&this->gcStatistics.rescanTime);
+        rescannedPageCount = heapBlockMap.Rescan(this, ((rescanFlags & RescanFlags_ResetWriteWatch) != 0));
+        rescannedPageCount += autoHeap.Rescan(rescanFlags);
+    }
 
     RECYCLER_PROFILE_EXEC_BACKGROUND_END(this, Js::BackgroundRescanPhase);
     GCETW(GC_BACKGROUNDRESCAN_STOP, (this, backgroundRescanCount));
@@ -4019,9 +4181,12 @@ Recycler::FinishMarkRescan(bool background)
 #endif
 
 #if ENABLE_CONCURRENT_GC
-    size_t scannedPageCount = heapBlockMap.Rescan(this, ((flags & RescanFlags_ResetWriteWatch) != 0));
-
-    scannedPageCount += autoHeap.Rescan(flags);
+    size_t scannedPageCount;
+    {
+        AutoRecyclerGCPhaseTimer rescanTimer(&this->gcStatistics.rescanTime);
+        scannedPageCount = heapBlockMap.Rescan(this, ((flags & RescanFlags_ResetWriteWatch) != 0));
+        scannedPageCount += autoHeap.Rescan(flags);
+    }
 #else
     size_t scannedPageCount = 0;
 #endif
@@ -4062,9 +4227,7 @@ Recycler::ProcessTrackedObjects()
 
     // If we did a parallel mark, we need to process any queued tracked objects from the parallel mark stack as well.
     // If we didn't, this will do nothing.
-    parallelMarkContext1.ProcessTracked();
-    parallelMarkContext2.ProcessTracked();
-    parallelMarkContext3.ProcessTracked();
+    ForEachParallelMarkContext([](MarkContext * parallelMarkContext) { parallelMarkContext->ProcessTracked(); });
 
     DebugOnly(this->isProcessingTrackedObjects = false);
 
@@ -4167,6 +4330,7 @@ template BOOL Recycler::FinishConcurrent<FinishConcurrentOnIdleAtRoot>();
 template BOOL Recycler::FinishConcurrent<FinishConcurrentOnExitScript>();
 template BOOL Recycler::FinishConcurrent<FinishConcurrentOnEnterScript>();
 template BOOL Recycler::FinishConcurrent<ForceFinishCollection>();
+template BOOL Recycler::FinishConcurrent<FinishConcurrentOnIdleDeadline>();
 
 template <CollectionFlags flags>
 BOOL
@@ -4219,6 +4383,90 @@ Recycler::FinishConcurrent()
 }
 
 
+DWORD
+Recycler::GetIdleDeadlineWaitTime(DWORD waitTime) const
+{
+    if (!this->hasIdleDeadline)
+    {
+        return waitTime;
+    }
+
+    // Use all the idle time left for the concurrent thread, but don't go past the deadline
+    const int remaining = (int)(this->idleDeadlineTick - ::GetTickCount());
+    return remaining > 0 ? (DWORD)remaining : 0;
+}
+
+bool
+Recycler::CanStartCollectionOnIdle() const
+{
+    // Only a collection that goes straight to the concurrent thread is bounded by the deadline.
+    // Without concurrent mark, or with a partial collection to finish first, the collection is
+    // (partly) done in thread; only start it if the longest pause seen so far fits in the idle time left.
+    bool inThread = !this->enableConcurrentMark;
+#if ENABLE_PARTIAL_GC
+    inThread = inThread || this->inPartialCollectMode;
+#endif
+    if (!inThread)
+    {
+        return true;
+    }
+
+    const uint64 maxPauseTime = this->gcStatistics.maxPauseTime;
+    return maxPauseTime != 0 && maxPauseTime / 1000 < this->GetIdleDeadlineWaitTime(INFINITE);
+}
+#endif
+
+// Spend up to idleTime milliseconds of the calling thread's idle time on garbage collection.
+// A concurrent collection is started if enough has been allocated since the last one, and the
+// in-thread parts of the current collection (rescan, transferring swept objects) are done once
+// the concurrent thread is ready for them. Waits for the concurrent thread are bounded by the
+// deadline, so a collection that isn't finished in time is resumed by the next call. A collection
+// that would block is only started if it is expected to fit in the idle time left.
+// Returns true if collection work is still pending.
+bool
+Recycler::CollectOnIdle(DWORD idleTime)
+{
+#if ENABLE_CONCURRENT_GC
+    if (!this->IsConcurrentEnabled() || this->IsHeapEnumInProgress() || this->isShuttingDown)
+    {
+        return false;
+    }
+
+    Assert(!this->hasIdleDeadline);
+    this->idleDeadlineTick = ::GetTickCount() + idleTime;
+    this->hasIdleDeadline = true;
+
+    bool startedCollection = false;
+    while (this->GetIdleDeadlineWaitTime(INFINITE) != 0)
+    {
+        if (this->CollectionInProgress())
+        {
+            if (!this->FinishConcurrent<FinishConcurrentOnIdleDeadline>())
+            {
+                // The concurrent thread didn't finish before the deadline
+                break;
+            }
+        }
+        else if (!startedCollection && autoHeap.uncollectedAllocBytes >= RecyclerHeuristic::IdleUncollectedAllocBytesCollection
+            && this->CanStartCollectionOnIdle())
+        {
+            startedCollection = true;
+            this->CollectNow<CollectOnScriptIdle>();
+        }
+        else
+        {
+            break;
+        }
+    }
+
+    this->hasIdleDeadline = false;
+    return this->CollectionInProgress() != FALSE;
+#else
+    return false;
+#endif
+}
+
+#if ENABLE_CONCURRENT_GC
 template <CollectionFlags flags>
 BOOL
 Recycler::TryFinishConcurrentCollect()
@@ -4347,6 +4595,52 @@ Recycler::IsConcurrentFinishedState() const
 }
 #endif
 
+Recycler::ParallelMarkHelper::ParallelMarkHelper(Recycler * recycler, uint parallelId) :
+    markPagePool(recycler->GetRecyclerFlagsTable()),
+    markContext(recycler, &this->markPagePool),
+    parallelThread(recycler, &Recycler::ParallelWorkFunc, parallelId)
+{
+#ifdef RECYCLER_MARK_TRACK
+    markContext.SetMarkMap(recycler->markMap);
+#endif
+#ifdef ENABLE_DEBUG_CONFIG_OPTIONS
+    markContext.SetMaxPageCount(recycler->GetRecyclerFlagsTable().MaxMarkStackPageCount);
+#endif
+}
+
+bool
+Recycler::CreateParallelMarkHelpers()
+{
+    Assert(this->maxParallelism >= 2 && this->maxParallelism <= MaxParallelism);
+
+    while (this->parallelMarkHelperCount < this->maxParallelism - 2)
+    {
+        ParallelMarkHelper * helper = HeapNewNoThrow(ParallelMarkHelper, this, this->parallelMarkHelperCount);
+        if (helper == nullptr)
+        {
+            // Run with the helpers we have
+            this->maxParallelism = this->parallelMarkHelperCount + 2;
+            return false;
+        }
+
+        this->parallelMarkHelpers[this->parallelMarkHelperCount++] = helper;
+    }
+
+    return true;
+}
+
+void
+Recycler::DeleteParallelMarkHelpers()
+{
+    for (uint i = 0; i < this->parallelMarkHelperCount; i++)
+    {
+        this->parallelMarkHelpers[i]->markContext.Release();
+        HeapDelete(this->parallelMarkHelpers[i]);
+    }
+
+    this->parallelMarkHelperCount = 0;
+}
+
 bool
 Recycler::InitializeConcurrent(JsUtil::ThreadService *threadService)
 {
@@ -4548,8 +4842,14 @@ Recycler::FinalizeConcurrent(bool restoreState)
 
     // Shutdown parallel threads and return the handle for them so the caller can
     // close it.
-    parallelThread1.Shutdown();
-    parallelThread2.Shutdown();
+    for (uint i = 0; i < this->parallelMarkHelperCount; i++)
+    {
+        this->parallelMarkHelpers[i]->parallelThread.Shutdown();
+    }
+
+    // Let the finalize helper thread finish, and run whatever it didn't get to in thread
+    FinishBackgroundFinalize();
+    this->backgroundFinalizeThread.Shutdown();
 
 #ifdef IDLE_DECOMMIT_ENABLED
     if (concurrentIdleDecommitEvent != nullptr)
@@ -4575,6 +4875,7 @@ Recycler::FinalizeConcurrent(bool restoreState)
         this->enableConcurrentMark = false;
         this->enableParallelMark = false;
         this->enableConcurrentSweep = false;
+        this->enableParallelSweep = false;
     }
 
     this->threadService = nullptr;
@@ -4598,18 +4899,32 @@ Recycler::EnableConcurrent(JsUtil::ThreadService *threadService, bool startAllTh
     this->enableConcurrentMark = !CUSTOM_PHASE_OFF1(GetRecyclerFlagsTable(), Js::ConcurrentMarkPhase);
     this->enableParallelMark = !CUSTOM_PHASE_OFF1(GetRecyclerFlagsTable(), Js::ParallelMarkPhase);
     this->enableConcurrentSweep = !CUSTOM_PHASE_OFF1(GetRecyclerFlagsTable(), Js::ConcurrentSweepPhase);
+    this->enableParallelSweep = this->enableConcurrentSweep && !CUSTOM_PHASE_OFF1(GetRecyclerFlagsTable(), Js::ParallelSweepPhase);
 #else
     this->enableConcurrentMark = true;
     this->enableParallelMark = true;
     this->enableConcurrentSweep = true;
+    this->enableParallelSweep = true;
 #endif
 
+    if ((this->enableParallelMark || this->enableParallelSweep) && this->maxParallelism > 2)
+    {
+        // Allocate the helpers up front; if we can't get all of them, CreateParallelMarkHelpers lowers maxParallelism.
+        this->CreateParallelMarkHelpers();
+    }
+
     if (this->enableParallelMark && this->maxParallelism == 1)
     {
         // Disable parallel mark if only 1 CPU
         this->enableParallelMark = false;
     }
 
+    if (this->enableParallelSweep && this->maxParallelism <= 2)
+    {
+        // The concurrent thread sweeps alone unless there are helpers
+        this->enableParallelSweep = false;
+    }
+
     if (threadService->HasCallback())
     {
         this->threadService = threadService;
@@ -4618,30 +4933,18 @@ Recycler::EnableConcurrent(JsUtil::ThreadService *threadService, bool startAllTh
     else
     {
         bool startConcurrentThread = true;
-        bool startedParallelThread1 = false;
-        bool startedParallelThread2 = false;
+        uint startedParallelThreadCount = 0;
 
         if (startAllThreads)
         {
-            if (this->enableParallelMark && this->maxParallelism > 2)
+            if ((this->enableParallelMark || this->enableParallelSweep) && this->maxParallelism > 2)
             {
-                if (!parallelThread1.EnableConcurrent(true))
+                for (; startedParallelThreadCount < this->maxParallelism - 2; startedParallelThreadCount++)
                 {
-                    startConcurrentThread = false;
-                }
-                else
-                {
-                    startedParallelThread1 = true;
-                    if (this->maxParallelism > 3)
+                    if (!this->parallelMarkHelpers[startedParallelThreadCount]->parallelThread.EnableConcurrent(true))
                     {
-                        if (!parallelThread2.EnableConcurrent(true))
-                        {
-                            startConcurrentThread = false;
-                        }
-                        else
-                        {
-                            startedParallelThread2 = true;
-                        }
+                        startConcurrentThread = false;
+                        break;
                     }
                 }
             }
@@ -4666,13 +4969,9 @@ Recycler::EnableConcurrent(JsUtil::ThreadService *threadService, bool startAllTh
             }
         }
 
-        if (startedParallelThread1)
+        for (uint i = 0; i < startedParallelThreadCount; i++)
         {
-            parallelThread1.Shutdown();
-            if (startedParallelThread2)
-            {
-                parallelThread2.Shutdown();
-            }
+            this->parallelMarkHelpers[i]->parallelThread.Shutdown();
         }
     }
 
@@ -4680,6 +4979,7 @@ Recycler::EnableConcurrent(JsUtil::ThreadService *threadService, bool startAllTh
     this->enableConcurrentMark = false;
     this->enableParallelMark = false;
     this->enableConcurrentSweep = false;
+    this->enableParallelSweep = false;
 
     if (concurrentWorkReadyEvent)
     {
@@ -4953,6 +5253,7 @@ Recycler::BackgroundScanStack()
 void
 Recycler::BackgroundMark()
 {
+    AutoRecyclerGCPhaseTimer markTimer(&this->gcStatistics.markTime);
     Assert(this->DoQueueTrackedObject());
     this->backgroundRescanCount = 0;
 
@@ -5177,6 +5478,7 @@ Recycler::FinishConcurrentCollectWrapped(CollectionFlags flags)
     this->skipStack = ((flags & CollectOverride_SkipStack) != 0);
     DebugOnly(this->isConcurrentGCOnIdle = (flags == CollectOnScriptIdle));
 #endif
+    AutoRecyclerGCPauseTimer pauseTimer(&this->gcStatistics);
     BOOL collected = collectionWrapper->ExecuteRecyclerCollectionFunction(this, &Recycler::FinishConcurrentCollect, flags);
     return collected;
 }
@@ -5298,7 +5600,7 @@ Recycler::FinishConcurrentCollect(CollectionFlags flags)
     collectionParam.priorityBoostConcurrentSweepOverride = priorityBoost;
 #endif
 
-    const DWORD waitTime = forceInThread? INFINITE : RecyclerHeuristic::FinishConcurrentCollectWaitTime(this->GetRecyclerFlagsTable());
+    const DWORD waitTime = forceInThread? INFINITE : GetIdleDeadlineWaitTime(RecyclerHeuristic::FinishConcurrentCollectWaitTime(this->GetRecyclerFlagsTable()));
     GCETW(GC_FINISHCONCURRENTWAIT_START, (this, waitTime));
     const BOOL waited = WaitForConcurrentThread(waitTime);
     GCETW(GC_FINISHCONCURRENTWAIT_STOP, (this, !waited));
@@ -5334,7 +5636,12 @@ Recycler::FinishConcurrentCollect(CollectionFlags flags)
 #endif
 
         const bool backgroundFinishMark = !forceInThread && concurrent && ((flags & CollectOverride_BackgroundFinishMark) != 0);
-        const DWORD finishMarkWaitTime = RecyclerHeuristic::BackgroundFinishMarkWaitTime(backgroundFinishMark, GetRecyclerFlagsTable());
+        DWORD finishMarkWaitTime = RecyclerHeuristic::BackgroundFinishMarkWaitTime(backgroundFinishMark, GetRecyclerFlagsTable());
+        if (finishMarkWaitTime != INFINITE)
+        {
+            // INFINITE means the rescan is done in-thread, which can't be bounded
+            finishMarkWaitTime = GetIdleDeadlineWaitTime(finishMarkWaitTime);
+        }
         size_t rescanRootBytes = FinishMark(finishMarkWaitTime);
 
         if (rescanRootBytes == Recycler::InvalidScanRootBytes)
@@ -5568,7 +5875,10 @@ Recycler::DoBackgroundWork(bool forceForeground)
         GCETW(GC_BACKGROUNDSWEEP_START, (this));
 
         Assert(this->recyclerSweep != nullptr);
-        this->recyclerSweep->BackgroundSweep();
+        {
+            AutoRecyclerGCPhaseTimer sweepTimer(&this->gcStatistics.sweepTime);
+            this->recyclerSweep->BackgroundSweep();
+        }
         uint sweptBytes = 0;
 #ifdef RECYCLER_STATS
         sweptBytes = (uint)collectionStats.objectSweptBytes;
@@ -5782,6 +6092,8 @@ Recycler::FinishCollection()
 
     RECYCLER_SLOW_CHECK(autoHeap.Check());
 
+    this->gcStatistics.heapSizeAfterLastCollection = this->GetUsedBytes();
+
 #ifdef RECYCLER_MEMORY_VERIFY
     this->Verify(Js::RecyclerPhase);
 #endif
@@ -6063,13 +6375,12 @@ RecyclerParallelThread::EnableConcurrent(bool waitForThread)
 }
 
 
-template <uint parallelId>
 void
-Recycler::ParallelWorkFunc()
+Recycler::ParallelWorkFunc(uint parallelId)
 {
-    Assert(parallelId == 0 || parallelId == 1);
+    Assert(parallelId < this->parallelMarkHelperCount);
 
-    MarkContext * markContext = (parallelId == 0 ? &this->parallelMarkContext2 : &this->parallelMarkContext3);
+    MarkContext * markContext = &this->parallelMarkHelpers[parallelId]->markContext;
 
     switch (this->collectionState)
     {
@@ -6081,11 +6392,128 @@ Recycler::ParallelWorkFunc()
             this->ProcessParallelMark(true, markContext);
             break;
 
+        case CollectionStateConcurrentSweep:
+            Assert(this->recyclerSweep != nullptr);
+            this->autoHeap.ParallelSweepSmallNonFinalizable(*this->recyclerSweep);
+            break;
+
         default:
             Assert(false);
     }
 }
 
+bool
+Recycler::TryQueueBackgroundFinalizeCallback(BackgroundFinalizeCallback callback, void * data)
+{
+    Assert(callback != nullptr);
+
+    if (!this->enableBackgroundFinalization || !this->IsConcurrentEnabled() || this->isShuttingDown)
+    {
+        return false;
+    }
+
+    // We are in the middle of a sweep, so the entry can't come from the recycler.
+    // If we can't get one, the caller runs the callback in thread as usual.
+    BackgroundFinalizeEntry * entry = HeapNewNoThrowStruct(BackgroundFinalizeEntry);
+    if (entry == nullptr)
+    {
+        return false;
+    }
+
+    entry->callback = callback;
+    entry->data = data;
+
+    AutoCriticalSection autoCs(&this->backgroundFinalizeCriticalSection);
+    entry->next = this->backgroundFinalizeQueue;
+    this->backgroundFinalizeQueue = entry;
+    return true;
+}
+
+void
+Recycler::StartBackgroundFinalize()
+{
+    {
+        AutoCriticalSection autoCs(&this->backgroundFinalizeCriticalSection);
+        if (this->backgroundFinalizeQueue == nullptr || this->isBackgroundFinalizing)
+        {
+            // Either there is nothing to do, or the helper thread is still draining the queue
+            // and will pick up the new entries before it stops.
+            return;
+        }
+        this->isBackgroundFinalizing = true;
+    }
+
+    if (this->hasBackgroundFinalizeWork)
+    {
+        // The previous batch is done with the queue, but the helper thread signals completion
+        // after that. Consume the signal so that every start is paired with one completion.
+        this->backgroundFinalizeThread.WaitForConcurrent();
+        this->hasBackgroundFinalizeWork = false;
+    }
+
+    if (this->backgroundFinalizeThread.StartConcurrent())
+    {
+        this->hasBackgroundFinalizeWork = true;
+    }
+    else
+    {
+        // Failed to get the helper thread going, run the callbacks in thread instead
+        BackgroundFinalizeWorkFunc(0);
+    }
+}
+
+void
+Recycler::FinishBackgroundFinalize()
+{
+    if (this->hasBackgroundFinalizeWork)
+    {
+        this->backgroundFinalizeThread.WaitForConcurrent();
+        this->hasBackgroundFinalizeWork = false;
+    }
+
+    Assert(!this->isBackgroundFinalizing);
+
+    BackgroundFinalizeEntry * entries = this->backgroundFinalizeQueue;
+    this->backgroundFinalizeQueue = nullptr;
+    RunBackgroundFinalizeCallbacks(entries);
+}
+
+void
+Recycler::BackgroundFinalizeWorkFunc(uint parallelId)
+{
+    Assert(parallelId == 0);
+
+    while (true)
+    {
+        BackgroundFinalizeEntry * entries;
+        {
+            AutoCriticalSection autoCs(&this->backgroundFinalizeCriticalSection);
+            entries = this->backgroundFinalizeQueue;
+            if (entries == nullptr)
+            {
+                this->isBackgroundFinalizing = false;
+                return;
+            }
+            this->backgroundFinalizeQueue = nullptr;
+        }
+
+        RunBackgroundFinalizeCallbacks(entries);
+    }
+}
+
+// static
+void
+Recycler::RunBackgroundFinalizeCallbacks(BackgroundFinalizeEntry * entries)
+{
+    while (entries != nullptr)
+    {
+        BackgroundFinalizeEntry * next = entries->next;
+        entries->callback(entries->data);
+        HeapDelete(entries);
+        entries = next;
+    }
+}
+
 void
 RecyclerParallelThread::WaitForConcurrent()
 {
@@ -6185,7 +6613,7 @@ RecyclerParallelThread::StaticThreadProc(LPVOID lpParameter)
             }
 
             // Invoke the workFunc to do real work
-            (recycler->*workFunc)();
+            (recycler->*workFunc)(parallelThread->parallelId);
 
             // We always wait after the first time
             mustWait = true;
@@ -6222,7 +6650,7 @@ RecyclerParallelThread::StaticBackgroundWorkCallback(void * callbackData)
     Recycler * recycler = parallelThread->recycler;
     RecyclerParallelThread::WorkFunc workFunc = parallelThread->workFunc;
 
-    (recycler->*workFunc)();
+    (recycler->*workFunc)(parallelThread->parallelId);
 
     SetEvent(parallelThread->concurrentWorkDoneEvent);
 }
@@ -8194,4 +8622,20 @@ RecyclerHeapObjectInfo::GetSize() const
     return size;
 }
 
+uint
+RecyclerHeapObjectInfo::GetAllocatedObjectIndex() const
+{
+    Assert(m_heapBlock);
+
+    if (m_heapBlock->GetHeapBlockType() < HeapBlock::HeapBlockType::SmallAllocBlockTypeCount)
+    {
+        return ((SmallHeapBlock*)m_heapBlock)->GetAllocatedObjectIndex(m_address);
+    }
+    else if (!m_heapBlock->IsLargeHeapBlock())
+    {
+        return ((MediumHeapBlock*)m_heapBlock)->GetAllocatedObjectIndex(m_address);
+    }
+    return ((LargeHeapBlock*)m_heapBlock)->GetAllocatedObjectIndex(m_address);
+}
+
 template char* Recycler::AllocWithAttributesInlined<(Memory::ObjectInfoBits)32, false>(size_t);
@@ -230,6 +230,7 @@ struct InfoBitsWrapper{};
 #define RecyclerHeapDelete(recycler,heapInfo,addr) (static_cast<Recycler *>(recycler)->HeapFree(heapInfo,addr))
 
 typedef void (__cdecl* ExternalRootMarker)(void *);
+typedef void (CALLBACK * BackgroundFinalizeCallback)(void * data);
 
 enum CollectionFlags
 {
@@ -253,6 +254,8 @@ enum CollectionFlags
     CollectOverride_NoExhaustiveCollect = 0x00400000,
     CollectOverride_SkipStack           = 0x01000000,
 
+    CollectMode_Compact                 = 0x04000000,
+
     CollectMode_Partial                 = 0x08000000,
     CollectMode_Concurrent              = 0x10000000,
     CollectMode_Exhaustive              = 0x20000000,
@@ -265,6 +268,7 @@ enum CollectionFlags
     CollectNowDefault               = CollectOverride_FinishConcurrent,
     CollectNowDefaultLSCleanup      = CollectOverride_FinishConcurrent | CollectOverride_AllowDispose,
     CollectNowDecommitNowExplicit   = CollectNowDefault | CollectMode_DecommitNow | CollectMode_CacheCleanup | CollectOverride_Explicit | CollectOverride_AllowDispose,
+    CollectNowCompact               = CollectNowDecommitNowExplicit | CollectMode_Exhaustive | CollectMode_Compact,
     CollectNowConcurrent            = CollectOverride_FinishConcurrent | CollectMode_Concurrent,
     CollectNowExhaustive            = CollectOverride_FinishConcurrent | CollectMode_Exhaustive | CollectOverride_AllowDispose,
     CollectNowPartial               = CollectOverride_FinishConcurrent | CollectMode_Partial,
@@ -284,6 +288,7 @@ enum CollectionFlags
     FinishConcurrentOnExitScript    = CollectMode_Concurrent | CollectOverride_DisableIdleFinish | CollectOverride_BackgroundFinishMark,
     FinishConcurrentOnEnterScript   = CollectMode_Concurrent | CollectOverride_DisableIdleFinish | CollectOverride_BackgroundFinishMark,
     FinishConcurrentOnAllocation    = CollectMode_Concurrent | CollectOverride_DisableIdleFinish | CollectOverride_BackgroundFinishMark,
+    FinishConcurrentOnIdleDeadline  = CollectMode_Concurrent | CollectOverride_DisableIdleFinish | CollectOverride_BackgroundFinishMark | CollectOverride_ForceFinish,
     FinishDispose                   = CollectOverride_AllowDispose,
     FinishDisposeTimed              = CollectOverride_AllowDispose | CollectHeuristic_TimeIfScriptActive,
     ForceFinishCollection           = CollectOverride_ForceFinish | CollectOverride_ForceInThread,
@@ -544,11 +549,12 @@ struct CollectionParam
 class RecyclerParallelThread
 {
 public:
-    typedef void (Recycler::* WorkFunc)();
+    typedef void (Recycler::* WorkFunc)(uint parallelId);
 
-    RecyclerParallelThread(Recycler * recycler, WorkFunc workFunc) :
+    RecyclerParallelThread(Recycler * recycler, WorkFunc workFunc, uint parallelId) :
         recycler(recycler),
         workFunc(workFunc),
+        parallelId(parallelId),
         concurrentWorkReadyEvent(NULL),
         concurrentWorkDoneEvent(NULL),
         concurrentThread(NULL)
@@ -577,6 +583,7 @@ private:
 private:
     WorkFunc workFunc;
     Recycler * recycler;
+    uint parallelId;
     HANDLE concurrentWorkReadyEvent;// main thread uses this event to tell concurrent threads that the work is ready
     HANDLE concurrentWorkDoneEvent;// concurrent threads use this event to tell main thread that the work allocated is done
     HANDLE concurrentThread;
@@ -628,6 +635,9 @@ class Recycler
     friend struct ::XProcNumberPageSegmentManager;
 public:
     static const uint ConcurrentThreadStackSize = 300000;
+
+    // Limit on the number of threads marking in parallel (PageStack::MaxSplitTargets + 1)
+    static const uint MaxParallelism = 32;
     static const bool FakeZeroLengthArray = true;
 
 #ifdef RECYCLER_PAGE_HEAP
@@ -787,21 +797,24 @@ private:
 
     MarkContext markContext;
 
-    // Contexts for parallel marking.
-    // We support up to 4 way parallelism, main context + 3 additional parallel contexts.
+    // Context for parallel marking on the main thread.
+    // The concurrent thread marks with the main context and each parallel mark helper thread
+    // has its own context (see ParallelMarkHelper).
     MarkContext parallelMarkContext1;
-    MarkContext parallelMarkContext2;
-    MarkContext parallelMarkContext3;
 
     // Page pools for above markContexts
     PagePool markPagePool;
     PagePool parallelMarkPagePool1;
-    PagePool parallelMarkPagePool2;
-    PagePool parallelMarkPagePool3;
+
+    // Mark stack chunks traded between the threads while marking in parallel
+    MarkContext::SharedMarkStack parallelMarkSharedStack;
 
     bool IsMarkStackEmpty();
-    bool HasPendingMarkObjects() const { return markContext.HasPendingMarkObjects() || parallelMarkContext1.HasPendingMarkObjects() || parallelMarkContext2.HasPendingMarkObjects() || parallelMarkContext3.HasPendingMarkObjects(); }
-    bool HasPendingTrackObjects() const { return markContext.HasPendingTrackObjects() || parallelMarkContext1.HasPendingTrackObjects() || parallelMarkContext2.HasPendingTrackObjects() || parallelMarkContext3.HasPendingTrackObjects(); }
+    bool HasPendingMarkObjects() const;
+    bool HasPendingTrackObjects() const;
+
+    template <class Fn>
+    void ForEachParallelMarkContext(Fn fn);
 
     RecyclerCollectionWrapper * collectionWrapper;
 
@@ -862,6 +875,7 @@ private:
     bool hasExhaustiveCandidate;
     bool inCacheCleanupCollection;
     bool inDecommitNowCollection;
+    bool inCompactCollection;
     bool isScriptActive;
     bool isInScript;
     bool isShuttingDown;
@@ -915,8 +929,9 @@ private:
     bool enableConcurrentMark;
     bool enableParallelMark;
     bool enableConcurrentSweep;
+    bool enableParallelSweep;
 
-    uint maxParallelism;        // Max # of total threads to run in parallel
+    uint maxParallelism;        // Max # of total threads to run in parallel, including the main and concurrent threads
 
     byte backgroundRescanCount;             // for ETW events and stats
     byte backgroundFinishMarkCount;
@@ -925,11 +940,26 @@ private:
     HANDLE concurrentWorkDoneEvent; // concurrent threads use this event to tell main thread that the work allocated is done
     HANDLE concurrentThread;
 
-    template <uint parallelId>
-    void ParallelWorkFunc();
+    void ParallelWorkFunc(uint parallelId);
+
+    // Threads that mark along with the main and concurrent threads, up to maxParallelism - 2 of them.
+    // They also help the concurrent thread with the background sweep.
+    // They are created along with the concurrent thread.
+    class ParallelMarkHelper
+    {
+    public:
+        ParallelMarkHelper(Recycler * recycler, uint parallelId);
+
+        PagePool markPagePool;
+        MarkContext markContext;
+        RecyclerParallelThread parallelThread;
+    };
+
+    ParallelMarkHelper * parallelMarkHelpers[MaxParallelism - 2];
+    uint parallelMarkHelperCount;
 
-    RecyclerParallelThread parallelThread1;
-    RecyclerParallelThread parallelThread2;
+    bool CreateParallelMarkHelpers();
+    void DeleteParallelMarkHelpers();
 
 #if DBG
     // Variable indicating if the concurrent thread has exited or not
@@ -944,6 +974,30 @@ private:
     uint tickCountStartConcurrent;
 
     bool isAborting;
+
+    // Set while CollectOnIdle is running; waits for the concurrent thread are bounded by the deadline
+    bool hasIdleDeadline;
+    DWORD idleDeadlineTick;
+
+    // Thread-agnostic finalize callbacks queued during sweep, run on a helper thread instead of the main thread
+    struct BackgroundFinalizeEntry
+    {
+        BackgroundFinalizeCallback callback;
+        void * data;
+        BackgroundFinalizeEntry * next;
+    };
+
+    void StartBackgroundFinalize();
+    void FinishBackgroundFinalize();
+    void BackgroundFinalizeWorkFunc(uint parallelId);
+    static void RunBackgroundFinalizeCallbacks(BackgroundFinalizeEntry * entries);
+
+    RecyclerParallelThread backgroundFinalizeThread;
+    CriticalSection backgroundFinalizeCriticalSection;
+    BackgroundFinalizeEntry * backgroundFinalizeQueue;   // protected by backgroundFinalizeCriticalSection
+    bool isBackgroundFinalizing;                         // protected by backgroundFinalizeCriticalSection
+    bool hasBackgroundFinalizeWork;                      // main thread only; the helper thread has a completion to wait on
+    bool enableBackgroundFinalization;
 #endif
 
 #if DBG
@@ -1013,6 +1067,7 @@ private:
     RecyclerWatsonTelemetryBlock localTelemetryBlock;
     RecyclerWatsonTelemetryBlock * telemetryBlock;
 #endif
+    RecyclerGCStatistics gcStatistics;
 #ifdef RECYCLER_STATS
     RecyclerCollectionStats collectionStats;
     void PrintHeapBlockStats(char16 const * name, HeapBlock::HeapBlockType type);
@@ -1070,6 +1125,13 @@ public:
         return usedBytes;
     }
 
+    // Monotonic count of bytes handed out by the recycler, including reported external memory.
+    // Small object allocations are only accounted when the allocator retires its current block,
+    // so the value lags the actual allocation by at most a block per bucket.
+    size_t GetTotalAllocBytes() const { return autoHeap.totalAllocBytes; }
+
+    RecyclerGCStatistics const * GetGCStatistics() const { return &gcStatistics; }
+
     void LogMemProtectHeapSize(bool fromGC);
 
     char* Realloc(void* buffer, DECLSPEC_GUARD_OVERFLOW size_t existingBytes, DECLSPEC_GUARD_OVERFLOW size_t requestedBytes, bool truncate = true);
@@ -1092,14 +1154,7 @@ public:
         this->needOOMRescan = true;
     }
 
-    void ClearNeedOOMRescan()
-    {
-        this->needOOMRescan = false;
-        markContext.GetPageAllocator()->ResetDisableAllocationOutOfMemory();
-        parallelMarkContext1.GetPageAllocator()->ResetDisableAllocationOutOfMemory();
-        parallelMarkContext2.GetPageAllocator()->ResetDisableAllocationOutOfMemory();
-        parallelMarkContext3.GetPageAllocator()->ResetDisableAllocationOutOfMemory();
-    }
+    void ClearNeedOOMRescan();
 
     BOOL RequestConcurrentWrapperCallback();
 
@@ -1175,10 +1230,18 @@ public:
     template <CollectionFlags flags>
     BOOL FinishConcurrent();
     void ShutdownThread();
+#endif
+    bool CollectOnIdle(DWORD idleTime);
+#if ENABLE_CONCURRENT_GC
 
     bool EnableConcurrent(JsUtil::ThreadService *threadService, bool startAllThreads);
     void DisableConcurrent();
 
+    // Finalize callbacks queued with TryQueueBackgroundFinalizeCallback must not touch the recycler
+    // or any script state; they run on a helper thread while the script thread keeps going.
+    void EnableBackgroundFinalization() { this->enableBackgroundFinalization = true; }
+    bool TryQueueBackgroundFinalizeCallback(BackgroundFinalizeCallback callback, void * data);
+
     void StartQueueTrackedObject();
     bool DoQueueTrackedObject() const;
     void PrepareSweep();
@@ -1197,6 +1260,7 @@ public:
     void TryMarkInterior(void *candidate, void* parentReference = nullptr);
 
     bool InCacheCleanupCollection() { return inCacheCleanupCollection; }
+    bool InCompactCollection() const { return inCompactCollection; }
     void ClearCacheCleanupCollection() { Assert(inCacheCleanupCollection); inCacheCleanupCollection = false; }
 
     // Finalizer support
@@ -1627,6 +1691,10 @@ private:
     void SweepWeakReference();
     void SweepHeap(bool concurrent, RecyclerSweep& recyclerSweep);
     void FinishSweep(RecyclerSweep& recyclerSweep);
+#if ENABLE_CONCURRENT_GC
+    bool DoParallelSweep();
+    void DoBackgroundParallelSweep(RecyclerSweep& recyclerSweep);
+#endif
 
     bool FinishDisposeObjects();
     template <CollectionFlags flags>
@@ -1708,6 +1776,8 @@ private:
     template <CollectionFlags flags>
     BOOL TryFinishConcurrentCollect();
     BOOL WaitForConcurrentThread(DWORD waitTime);
+    DWORD GetIdleDeadlineWaitTime(DWORD waitTime) const;
+    bool CanStartCollectionOnIdle() const;
     void FlushBackgroundPages();
     BOOL FinishConcurrentCollect(CollectionFlags flags);
     BOOL FinishConcurrentCollectWrapped(CollectionFlags flags);
@@ -1899,9 +1969,22 @@ public:
     bool FindImplicitRootObject(void* candidate, RecyclerHeapObjectInfo& heapObject);
     bool FindHeapObject(void* candidate, FindHeapObjectFlags flags, RecyclerHeapObjectInfo& heapObject);
     bool FindHeapObjectWithClearedAllocators(void* candidate, RecyclerHeapObjectInfo& heapObject);
+    bool FindHeapObjectFromInterior(void* candidate, RecyclerHeapObjectInfo& heapObject);
     bool IsCollectionDisabled() const { return isCollectionDisabled; }
     bool IsHeapEnumInProgress() const { Assert(isHeapEnumInProgress ? isCollectionDisabled : true); return isHeapEnumInProgress; }
 
+    template <typename Fn>
+    void ForEachPinnedObject(Fn fn)
+    {
+        pinnedObjectMap.Map([&](void * object, PinRecord const& refCount)
+        {
+            if (refCount != 0)
+            {
+                fn(object);
+            }
+        });
+    }
+
 #if DBG
     // There are limited cases that we have to allow allocation during heap enumeration. GC is explicitly
     // disabled during heap enumeration for these limited cases. (See DefaultRecyclerCollectionWrapper)
@@ -2031,6 +2114,8 @@ public:
         m_address(address), m_recycler(recycler), m_heapBlock(heapBlock), m_attributes(attributes) { }
 
     void* GetObjectAddress() const { return m_address; }
+    HeapBlock* GetHeapBlock() const { return m_heapBlock; }
+    uint GetAllocatedObjectIndex() const;
 
 #ifdef RECYCLER_PAGE_HEAP
     bool IsPageHeapAlloc()
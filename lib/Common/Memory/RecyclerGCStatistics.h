@@ -0,0 +1,126 @@
+//-------------------------------------------------------------------------------------------------------
+// Copyright (C) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE.txt file in the project root for full license information.
+//-------------------------------------------------------------------------------------------------------
+#pragma once
+
+namespace Memory
+{
+    /*
+    * Collection statistics that are always maintained, unlike RECYCLER_STATS and the perf counters.
+    *
+    * Times are in microseconds and are cumulative since the recycler was created. Pauses are the time
+    * the allocating thread spends inside a collection call, including the dispose callbacks it runs.
+    * Phase times are measured on whichever thread does the work, so concurrent mark and sweep time is
+    * included even though it does not pause the allocating thread. Rescan time is part of mark time.
+    */
+    struct RecyclerGCStatistics
+    {
+        // Bucket 0 holds pauses under 1ms, bucket i holds [2^(i-1), 2^i) ms and the last bucket
+        // holds everything longer.
+        static const uint PauseHistogramBucketCount = 12;
+
+        uint collectionCount;
+        uint partialCollectionCount;
+        uint concurrentCollectionCount;
+
+        uint pauseCount;
+        uint64 pauseTime;
+        uint64 maxPauseTime;
+        uint pauseHistogram[PauseHistogramBucketCount];
+
+        uint64 markTime;
+        uint64 rescanTime;
+        uint64 sweepTime;
+        // Time in DisposeObjects only; finalizers run while sweeping are part of sweep time
+        uint64 disposeTime;
+
+        size_t heapSizeBeforeLastCollection;
+        size_t heapSizeAfterLastCollection;
+        size_t peakHeapSize;
+
+        // Nesting depth of the pause timers; collections started from dispose are part of the outer pause
+        uint pauseDepth;
+
+        RecyclerGCStatistics()
+        {
+            memset(this, 0, sizeof(RecyclerGCStatistics));
+        }
+
+        void RecordPause(uint64 time)
+        {
+            pauseCount++;
+            pauseTime += time;
+            maxPauseTime = max(maxPauseTime, time);
+
+            uint bucket = 0;
+            for (uint64 ms = time / 1000; ms != 0 && bucket < PauseHistogramBucketCount - 1; ms >>= 1)
+            {
+                bucket++;
+            }
+            pauseHistogram[bucket]++;
+        }
+
+        static uint64 GetTicksPerSecond()
+        {
+            // The frequency is fixed at boot, query it once. Racing threads store the same value.
+            static uint64 ticksPerSecond = 0;
+            if (ticksPerSecond == 0)
+            {
+                LARGE_INTEGER frequency;
+                if (QueryPerformanceFrequency(&frequency))
+                {
+                    ticksPerSecond = (uint64)frequency.QuadPart;
+                }
+            }
+            return ticksPerSecond;
+        }
+
+        static uint64 GetTimestamp()
+        {
+            LARGE_INTEGER counter;
+            uint64 ticksPerSecond = GetTicksPerSecond();
+            if (ticksPerSecond == 0 || !QueryPerformanceCounter(&counter))
+            {
+                return 0;
+            }
+
+            uint64 ticks = (uint64)counter.QuadPart;
+            return (ticks / ticksPerSecond) * 1000000 + (ticks % ticksPerSecond) * 1000000 / ticksPerSecond;
+        }
+    };
+
+    class AutoRecyclerGCPhaseTimer
+    {
+    public:
+        AutoRecyclerGCPhaseTimer(uint64 * phaseTime) : phaseTime(phaseTime), startTime(RecyclerGCStatistics::GetTimestamp())
+        {
+        }
+        ~AutoRecyclerGCPhaseTimer()
+        {
+            *phaseTime += RecyclerGCStatistics::GetTimestamp() - startTime;
+        }
+    private:
+        uint64 * phaseTime;
+        uint64 startTime;
+    };
+
+    class AutoRecyclerGCPauseTimer
+    {
+    public:
+        AutoRecyclerGCPauseTimer(RecyclerGCStatistics * statistics) : statistics(statistics), startTime(RecyclerGCStatistics::GetTimestamp())
+        {
+            statistics->pauseDepth++;
+        }
+        ~AutoRecyclerGCPauseTimer()
+        {
+            if (--statistics->pauseDepth == 0)
+            {
+                statistics->RecordPause(RecyclerGCStatistics::GetTimestamp() - startTime);
+            }
+        }
+    private:
+        RecyclerGCStatistics * statistics;
+        uint64 startTime;
+    };
+}
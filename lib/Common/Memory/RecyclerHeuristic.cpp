@@ -23,6 +23,7 @@ RecyclerHeuristic RecyclerHeuristic::Instance;
 
 // static
 RecyclerHeuristic::RecyclerHeuristic()
+    : memoryPressureLevel(0), memoryPressureSampled(false), tickCountNextMemoryPressureCheck(0)
 {
     ::MEMORYSTATUSEX mem;
     mem.dwLength = sizeof(mem);
@@ -30,8 +31,21 @@ RecyclerHeuristic::RecyclerHeuristic()
     Assert(isSuccess);
 
     DWORDLONG physicalMemoryBytes = mem.ullTotalPhys;
+    bool isMemoryLimited = false;
     uint baseFactor;
 
+#ifndef _WIN32
+    // In a container the physical memory is the host's, size the heuristics for the
+    // control group's memory limit instead so that we collect before we get OOM-killed.
+    size_t memoryLimit;
+    if (PlatformAgnostic::SystemInfo::GetMemoryLimit(&memoryLimit) && (!isSuccess || memoryLimit < physicalMemoryBytes))
+    {
+        physicalMemoryBytes = memoryLimit;
+        isMemoryLimited = true;
+        isSuccess = TRUE;
+    }
+#endif
+
     if (isSuccess && AutoSystemInfo::IsLowMemoryDevice() && physicalMemoryBytes <= 512 MEGABYTES)
     {
         // Low-end Apollo (512MB RAM) scenario.
@@ -56,7 +70,54 @@ RecyclerHeuristic::RecyclerHeuristic()
         this->DefaultMaxAllocPageCount = 256;
     }
 
+    if (isMemoryLimited)
+    {
+        // Let the uncollected allocations and the cached free pages each take at most an eighth
+        // of the limit, on top of the tier picked above.
+        uint limitMegabytes = (uint)min(physicalMemoryBytes / (1 MEGABYTES), (DWORDLONG)UINT_MAX);
+        baseFactor = min(baseFactor, max(limitMegabytes / 8, MinMemoryLimitedBaseFactor));
+        uint limitFreePageCount = max(limitMegabytes / 8, 1u) MEGABYTES_OF_PAGES;
+        this->DefaultMaxFreePageCount = min(this->DefaultMaxFreePageCount, limitFreePageCount);
+    }
+
     this->ConfigureBaseFactor(baseFactor);
+
+    if (isMemoryLimited)
+    {
+        // Keep the nursery at a quarter of the full GC budget (but not below RecyclerSweep::MinPartialUncollectedNewPageCount)
+        // so that partial collections stay cheap and partial collect mode isn't abandoned for nearing the full GC limit.
+        this->MaxPartialUncollectedNewPageCount = max(baseFactor / 4, 4u) MEGABYTES_OF_PAGES;
+    }
+}
+
+void
+RecyclerHeuristic::UpdateMemoryPressure()
+{
+    // Reading the pressure goes to the file system, sample it at most once per collection period.
+    // The tick count wraps, so the first sample can't be gated on the initial next check time.
+    DWORD currentTickCount = ::GetTickCount();
+    if (this->memoryPressureSampled && (int)(this->tickCountNextMemoryPressureCheck - currentTickCount) > 0)
+    {
+        return;
+    }
+    this->memoryPressureSampled = true;
+    this->tickCountNextMemoryPressureCheck = currentTickCount + TickCountCollection;
+
+    uint memoryPressure;
+    if (!PlatformAgnostic::SystemInfo::GetMemoryPressure(&memoryPressure))
+    {
+        this->memoryPressureLevel = 0;
+        return;
+    }
+
+    // Each level halves the allocation and time budgets between collections
+    static const uint MemoryPressureLevelThresholds[MaxMemoryPressureLevel] = { 5, 20, 50 };   // percent of time stalled
+    uint level = 0;
+    while (level < MaxMemoryPressureLevel && memoryPressure >= MemoryPressureLevelThresholds[level])
+    {
+        level++;
+    }
+    this->memoryPressureLevel = level;
 }
 
 void
@@ -153,6 +214,32 @@ RecyclerHeuristic::PriorityBoostTimeout(Js::ConfigFlagsTable& flags)
 #endif
     return TickCountConcurrentPriorityBoost;
 }
+
+uint
+RecyclerHeuristic::MaxParallelMarkThreadCount(Js::ConfigFlagsTable& flags)
+{
+#ifdef ENABLE_DEBUG_CONFIG_OPTIONS
+    if (flags.IsEnabled(Js::MaxParallelMarkThreadCountFlag))
+    {
+        // At least the main and concurrent threads, at most as many as a mark stack can be split for
+        return min(max((uint)flags.MaxParallelMarkThreadCount, 2u), (uint)Recycler::MaxParallelism);
+    }
+#endif
+    return DefaultMaxParallelMarkThreadCount;
+}
+#endif
+
+#if ENABLE_PARTIAL_GC
+size_t
+RecyclerHeuristic::PartialCollectNurseryPageCount(Js::ConfigFlagsTable& flags)
+{
+    // Release flag, so hosts can size the nursery for their workload
+    if (flags.RecyclerNurseryBytes > 0)
+    {
+        return max((size_t)RecyclerSweep::MinPartialUncollectedNewPageCount, (size_t)flags.RecyclerNurseryBytes / AutoSystemInfo::PageSize);
+    }
+    return RecyclerHeuristic::Instance.MaxPartialUncollectedNewPageCount;
+}
 #endif
 
 #if ENABLE_PARTIAL_GC && ENABLE_CONCURRENT_GC
@@ -21,6 +21,9 @@ public:
     // Heuristics that depend on hardware or environment (not constant).
     uint   MaxUncollectedAllocBytes;
     size_t UncollectedAllocBytesConcurrentPriorityBoost;
+
+    // Partial GC only sweeps the blocks allocated since the last collection, so the new page count
+    // it waits for is effectively the size of the nursery. This is the upper bound of that count.
     uint   MaxPartialUncollectedNewPageCount;
     uint   MaxUncollectedAllocBytesOnExit;
 
@@ -42,6 +45,10 @@ public:
     static size_t MinBackgroundRepeatMarkRescanBytes(Js::ConfigFlagsTable&);
     static DWORD FinishConcurrentCollectWaitTime(Js::ConfigFlagsTable&);
     static DWORD PriorityBoostTimeout(Js::ConfigFlagsTable&);
+    static uint MaxParallelMarkThreadCount(Js::ConfigFlagsTable&);
+#endif
+#if ENABLE_PARTIAL_GC
+    static size_t PartialCollectNurseryPageCount(Js::ConfigFlagsTable& flags);
 #endif
 #if ENABLE_PARTIAL_GC && ENABLE_CONCURRENT_GC
     static bool PartialConcurrentNextCollection(double ratio, Js::ConfigFlagsTable& flags);
@@ -55,6 +62,12 @@ public:
                                                                                             // This heuristic is currently used for dispose on stack probes
     void ConfigureBaseFactor(uint baseFactor);
 
+    // Memory pressure (PSI on Linux) of the process's control group, shared by all the recyclers
+    // in the process. Under pressure, collections are triggered after fewer allocations and sooner.
+    void UpdateMemoryPressure();
+    uint GetMaxUncollectedAllocBytes() const { return this->MaxUncollectedAllocBytes >> this->memoryPressureLevel; }
+    uint GetTickCountCollection() const { return TickCountCollection >> this->memoryPressureLevel; }
+
 #if ENABLE_CONCURRENT_GC
     static const uint MaxBackgroundRepeatMarkCount = 2;
 
@@ -63,6 +76,13 @@ public:
     static const uint BackgroundSecondRepeatMarkThreshold = 128;
 #endif
 private:
+    // Not synchronized: a stale level from another thread only delays the effect by a collection.
+    uint memoryPressureLevel;
+    bool memoryPressureSampled;
+    DWORD tickCountNextMemoryPressureCheck;
+
+    static const uint MaxMemoryPressureLevel = 3;
+    static const uint MinMemoryLimitedBaseFactor = 8;
 
 #ifndef RECYCLER_HEURISTIC_VERSION
 #define RECYCLER_HEURISTIC_VERSION 11
@@ -75,6 +95,7 @@ private:
     static const uint DefaultMaxBackgroundFinishMarkCount = 1;
     static const DWORD DefaultBackgroundFinishMarkWaitTime = 15; // ms
     static const size_t DefaultMinBackgroundRepeatMarkRescanBytes = 1 MEGABYTES;
+    static const uint DefaultMaxParallelMarkThreadCount = 8;                                // Including the main and concurrent threads
 #endif
 };
 }
@@ -29,6 +29,30 @@ bool RecyclerPageAllocator::IsMemProtectMode()
     return recycler->IsMemProtectMode();
 }
 
+#if ENABLE_HUGE_PAGES
+void
+RecyclerPageAllocator::EnableHugePages(bool hugePageSegments)
+{
+    Assert(segments.Empty());
+    Assert(fullSegments.Empty());
+    Assert(emptySegments.Empty());
+    Assert(decommitSegments.Empty());
+    Assert(largeSegments.Empty());
+    Assert((allocFlags & MEM_WRITE_WATCH) == 0);
+
+    // Huge pages only back whole, aligned huge pages of a segment. Guard pages would
+    // shift the segment pages off the huge page boundary, so leave them out.
+    allocFlags |= MEM_LARGE_PAGES;
+    excludeGuardPages = true;
+
+    if (hugePageSegments)
+    {
+        // Make each page segment exactly one huge page
+        this->maxAllocPageCount = PageSegment::MaxHugePageDataPageCount - this->secondaryAllocPageCount;
+    }
+}
+#endif
+
 #if ENABLE_CONCURRENT_GC
 void
 RecyclerPageAllocator::EnableWriteWatch()
@@ -39,13 +63,13 @@ RecyclerPageAllocator::EnableWriteWatch()
     Assert(decommitSegments.Empty());
     Assert(largeSegments.Empty());
 
-    allocFlags = MEM_WRITE_WATCH;
+    allocFlags |= MEM_WRITE_WATCH;
 }
 
 bool
 RecyclerPageAllocator::ResetWriteWatch()
 {
-    if (allocFlags != MEM_WRITE_WATCH)
+    if ((allocFlags & MEM_WRITE_WATCH) == 0)
     {
         return false;
     }
@@ -61,7 +85,7 @@ RecyclerPageAllocator::ResetWriteWatch()
         !ResetAllWriteWatch(&fullSegments) ||
         !ResetAllWriteWatch(&largeSegments))
     {
-        allocFlags = 0;
+        allocFlags &= ~MEM_WRITE_WATCH;
         success = false;
     }
 
@@ -131,7 +155,7 @@ RecyclerPageAllocator::ResetAllWriteWatch(DListBase<T> * segmentList)
 size_t
 RecyclerPageAllocator::GetWriteWatchPageCount()
 {
-    if (allocFlags != MEM_WRITE_WATCH)
+    if ((allocFlags & MEM_WRITE_WATCH) == 0)
     {
         return 0;
     }
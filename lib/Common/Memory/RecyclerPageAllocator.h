@@ -18,6 +18,9 @@ public:
     void EnableWriteWatch();
     bool ResetWriteWatch();
 #endif
+#if ENABLE_HUGE_PAGES
+    void EnableHugePages(bool hugePageSegments);
+#endif
 
     static uint const DefaultPrimePageCount = 0x1000; // 16MB
 
@@ -553,6 +553,16 @@ RecyclerSweep::StartPartialCollectMode()
 }
 #endif
 
+size_t
+RecyclerSweep::ExchangeAddCount(size_t * count, size_t value)
+{
+#if defined(_M_X64_OR_ARM64)
+    return (size_t)::InterlockedExchangeAdd64((volatile LONG64 *)count, (LONG64)value);
+#else
+    return (size_t)::InterlockedExchangeAdd((volatile LONG *)count, (LONG)value);
+#endif
+}
+
 // Called by prepare sweep to track the new allocated bytes on block that is not fully allocated yet.
 template <typename TBlockAttributes>
 void
@@ -565,8 +575,8 @@ RecyclerSweep::AddUnaccountedNewObjectAllocBytes(SmallHeapBlockT<TBlockAttribute
         uint unaccountedAllocBytes = heapBlock->GetAndClearUnaccountedAllocBytes();
         Assert(heapBlock->lastUncollectedAllocBytes == 0 || unaccountedAllocBytes == 0);
         DebugOnly(heapBlock->lastUncollectedAllocBytes += unaccountedAllocBytes);
-        recycler->partialUncollectedAllocBytes += unaccountedAllocBytes;
-        this->nextPartialUncollectedAllocBytes += unaccountedAllocBytes;
+        ExchangeAddCount(&recycler->partialUncollectedAllocBytes, unaccountedAllocBytes);
+        ExchangeAddCount(&this->nextPartialUncollectedAllocBytes, unaccountedAllocBytes);
     }
     else
 #endif
@@ -584,10 +594,11 @@ void
 RecyclerSweep::SubtractSweepNewObjectAllocBytes(size_t newObjectExpectSweepByteCount)
 {
     Assert(recycler->inPartialCollectMode);
+    DebugOnly(size_t lastNextPartialUncollectedAllocBytes =) ExchangeAddCount(&this->nextPartialUncollectedAllocBytes, (size_t)0 - newObjectExpectSweepByteCount);
+
     // We shouldn't free more then we allocated
-    Assert(this->nextPartialUncollectedAllocBytes >= newObjectExpectSweepByteCount);
-    Assert(this->nextPartialUncollectedAllocBytes >= this->lastPartialUncollectedAllocBytes + newObjectExpectSweepByteCount);
-    this->nextPartialUncollectedAllocBytes -= newObjectExpectSweepByteCount;
+    Assert(lastNextPartialUncollectedAllocBytes >= newObjectExpectSweepByteCount);
+    Assert(lastNextPartialUncollectedAllocBytes >= this->lastPartialUncollectedAllocBytes + newObjectExpectSweepByteCount);
 }
 
 
@@ -709,12 +720,13 @@ RecyclerSweep::AdjustPartialHeuristics()
     }
     Assert(0.0 <= ratio && ratio <= 1.0);
 
-    // Linear scale the partial GC new page heuristic using the ratio calculated
+    // Linear scale the partial GC new page heuristic between the minimum and the nursery size using the ratio calculated
+    const size_t nurseryPageCount = RecyclerHeuristic::PartialCollectNurseryPageCount(recycler->GetRecyclerFlagsTable());
     recycler->uncollectedNewPageCountPartialCollect = MinPartialUncollectedNewPageCount
-        + (size_t)((double)(RecyclerHeuristic::Instance.MaxPartialUncollectedNewPageCount - MinPartialUncollectedNewPageCount) * ratio);
+        + (size_t)((double)(nurseryPageCount - MinPartialUncollectedNewPageCount) * ratio);
 
     Assert(recycler->uncollectedNewPageCountPartialCollect >= MinPartialUncollectedNewPageCount &&
-        recycler->uncollectedNewPageCountPartialCollect <= RecyclerHeuristic::Instance.MaxPartialUncollectedNewPageCount);
+        recycler->uncollectedNewPageCountPartialCollect <= nurseryPageCount);
 
     // If the number of new page to reach the partial heuristics plus the existing uncollectedAllocBytes
     // and the memory we are going to reuse (assume we use it all) is greater then the full GC max size heuristic
@@ -764,11 +776,11 @@ template <typename TBlockAttributes>
 void
 RecyclerSweep::NotifyAllocableObjects(SmallHeapBlockT<TBlockAttributes> * heapBlock)
 {
-    this->reuseByteCount += heapBlock->GetExpectedFreeBytes();
+    ExchangeAddCount(&this->reuseByteCount, heapBlock->GetExpectedFreeBytes());
 
     if (!heapBlock->IsLeafBlock())
     {
-        this->reuseHeapBlockCount++;
+        ExchangeAddCount(&this->reuseHeapBlockCount, 1);
     }
 }
 
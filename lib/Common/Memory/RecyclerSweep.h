@@ -8,9 +8,6 @@ namespace Memory
 {
 // RecyclerSweep - Sweeping algorithm and state
 class RecyclerSweep
-#if DBG
-    : public RecyclerVerifyListConsistencyData
-#endif
 {
 public:
 #if ENABLE_PARTIAL_GC
@@ -138,6 +135,9 @@ private:
 private:
     bool IsMemProtectMode();
 
+    // Counters shared by all the buckets are updated with this, since buckets can be swept in parallel
+    static size_t ExchangeAddCount(size_t * count, size_t value);
+
     Recycler * recycler;
     Data<SmallLeafHeapBlock> leafData;
     Data<SmallNormalHeapBlock> normalData;
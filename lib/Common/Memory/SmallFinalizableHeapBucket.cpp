@@ -112,11 +112,11 @@ SmallFinalizableHeapBucketBaseT<TBlockType>::Sweep(RecyclerSweep& recyclerSweep)
 #if DBG
         if (TBlockType::HeapBlockAttributes::IsSmallBlock)
         {
-            recyclerSweep.SetupVerifyListConsistencyDataForSmallBlock(nullptr, false, true);
+            this->sweepVerifyListConsistencyData.SetupVerifyListConsistencyDataForSmallBlock(nullptr, false, true);
         }
         else if (TBlockType::HeapBlockAttributes::IsMediumBlock)
         {
-            recyclerSweep.SetupVerifyListConsistencyDataForMediumBlock(nullptr, false, true);
+            this->sweepVerifyListConsistencyData.SetupVerifyListConsistencyDataForMediumBlock(nullptr, false, true);
         }
         else
         {
@@ -103,7 +103,9 @@ SmallHeapBlockAllocator<TBlockType>::Clear()
         if (remainingFreeObjectList == nullptr)
         {
             uint lastFreeCount = heapBlock->GetAndClearLastFreeCount();
-            heapBlock->heapBucket->heapInfo->uncollectedAllocBytes += lastFreeCount * heapBlock->GetObjectSize();
+            HeapInfo * heapInfo = heapBlock->heapBucket->heapInfo;
+            heapInfo->uncollectedAllocBytes += lastFreeCount * heapBlock->GetObjectSize();
+            heapInfo->totalAllocBytes += lastFreeCount * heapBlock->GetObjectSize();
             Assert(heapBlock->lastUncollectedAllocBytes == 0);
             DebugOnly(heapBlock->lastUncollectedAllocBytes = lastFreeCount * heapBlock->GetObjectSize());
         }
@@ -0,0 +1,27 @@
+//-------------------------------------------------------------------------------------------------------
+// Copyright (C) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE.txt file in the project root for full license information.
+//-------------------------------------------------------------------------------------------------------
+
+#ifndef RUNTIME_PLATFORM_AGNOSTIC_COMMON_PERFTRACE
+#define RUNTIME_PLATFORM_AGNOSTIC_COMMON_PERFTRACE
+
+#ifdef PERF_JIT_PROFILING
+namespace PlatformAgnostic
+{
+    //
+    // Publishes dynamically generated code to the Linux perf profiler, either as a perf map
+    // (/tmp/perf-<pid>.map, symbols only) or as a jitdump file (/tmp/jit-<pid>.dump, symbols and
+    // code bytes, to be merged into a recording with "perf inject --jit").
+    //
+    class PerfTrace
+    {
+    public:
+        // Files are created on the first code load event, so that the outputs can be enabled after startup
+        static void LogCodeLoadEvent(bool perfMap, bool jitDump, const void * codeAddress, size_t codeSize, const char * utf8Name);
+        static void UnRegister();
+    };
+} // namespace PlatformAgnostic
+#endif
+
+#endif // RUNTIME_PLATFORM_AGNOSTIC_COMMON_PERFTRACE
@@ -31,6 +31,16 @@ namespace PlatformAgnostic
             *totalRam = SystemInfo::data.totalRam;
             return true;
         }
+
+        // Memory available to the process: the physical memory, or the memory limit of the
+        // control group the process runs in if that is lower (Linux only).
+        // Doesn't depend on static initialization, so it can be called from other static initializers.
+        static bool GetMemoryLimit(size_t *memoryLimit);
+
+        // Share of the last 10 seconds, in percent, in which some task of the process's control
+        // group (or of the system) was stalled on memory. Returns false where pressure stall
+        // information isn't available.
+        static bool GetMemoryPressure(uint *memoryPressure);
     };
 } // namespace PlatformAgnostic
 
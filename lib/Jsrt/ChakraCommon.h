@@ -424,7 +424,20 @@ typedef UINT32 DWORD;
         ///     Calling <c>JsSetException</c> will also dispatch the exception to the script debugger
         ///     (if any) giving the debugger a chance to break on the exception.
         /// </summary>
-        JsRuntimeAttributeDispatchSetExceptionsToDebugger = 0x00000040
+        JsRuntimeAttributeDispatchSetExceptionsToDebugger = 0x00000040,
+        /// <summary>
+        ///     Finalize callbacks that were marked thread-safe when their object was created are
+        ///     called on a background thread instead of the thread running the garbage collection.
+        ///     Has no effect together with <c>JsRuntimeAttributeDisableBackgroundWork</c>.
+        /// </summary>
+        JsRuntimeAttributeEnableBackgroundFinalization = 0x00000080,
+        /// <summary>
+        ///     Native code is generated by background threads shared with the other runtimes of the
+        ///     process that have this attribute, instead of threads owned by this runtime. The shared
+        ///     threads are bounded by the processor count and compile the hottest functions of all
+        ///     runtimes first. Has no effect together with <c>JsRuntimeAttributeDisableBackgroundWork</c>.
+        /// </summary>
+        JsRuntimeAttributeShareBackgroundNativeCodeGeneration = 0x00000100
     } JsRuntimeAttributes;
 
     /// <summary>
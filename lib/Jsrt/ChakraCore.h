@@ -552,5 +552,288 @@ CHAKRA_API
         _In_ JsSourceContext sourceContext,
         _In_ JsValueRef sourceUrl,
         _Out_ JsValueRef *result);
+
+/// <summary>
+///     Performs a full garbage collection and returns as much of the freed memory to the system
+///     as possible.
+/// </summary>
+/// <remarks>
+///     <para>
+///     Objects are never moved. Instead, after this collection new allocations are directed to the
+///     most occupied pages first so that sparsely used pages empty out over the following
+///     collections, and all free pages are decommitted immediately rather than kept for reuse.
+///     </para>
+///     <para>
+///     This is more expensive than <c>JsCollectGarbage</c> and is intended to be called by long
+///     running hosts when they are idle.
+///     </para>
+/// </remarks>
+/// <param name="runtime">The runtime in which the garbage collection will be performed.</param>
+/// <returns>
+///     The code <c>JsNoError</c> if the operation succeeded, a failure code otherwise.
+/// </returns>
+CHAKRA_API
+    JsCompactHeap(
+        _In_ JsRuntimeHandle runtime);
+
+/// <summary>
+///     Gets the number of bytes allocated by a script context.
+/// </summary>
+/// <remarks>
+///     <para>
+///     Garbage collected allocations are charged to whichever context is current when they are
+///     made, so calls from one context into another are charged to the caller. The count is
+///     cumulative and is updated at heap block granularity; hosts should sample it periodically
+///     and use the difference between samples as the allocation rate of the context.
+///     </para>
+///     <para>
+///     This is an allocation counter, not the context's retained memory: objects freed by a
+///     collection are not subtracted. Use <c>JsGetRuntimeMemoryUsage</c> for the live size of the
+///     runtime's heap.
+///     </para>
+///     <para>
+///     Requires the context's runtime to be either idle or active on the current thread.
+///     </para>
+/// </remarks>
+/// <param name="context">The context to query.</param>
+/// <param name="allocatedBytes">
+///     The total number of garbage collected bytes allocated while the context was current.
+/// </param>
+/// <param name="arenaBytes">
+///     The memory currently held by the context's internal allocators (inline caches, profile
+///     data, source and regex storage).
+/// </param>
+/// <returns>
+///     The code <c>JsNoError</c> if the operation succeeded, a failure code otherwise.
+/// </returns>
+CHAKRA_API
+    JsGetContextAllocatedBytes(
+        _In_ JsContextRef context,
+        _Out_ size_t *allocatedBytes,
+        _Out_ size_t *arenaBytes);
+
+/// <summary>
+///     Garbage collection statistics of a runtime.
+/// </summary>
+/// <remarks>
+///     Times are in microseconds and all values except the heap sizes are cumulative since the
+///     runtime was created. Phase times include work done on background threads; rescan time is
+///     also counted in mark time.
+/// </remarks>
+typedef struct _JsGCStatistics
+{
+    unsigned int collectionCount;
+    unsigned int partialCollectionCount;
+    unsigned int concurrentCollectionCount;
+
+    /// <summary>
+    ///     Number and total time of the pauses of the runtime's thread spent collecting, including
+    ///     dispose callbacks.
+    /// </summary>
+    unsigned int pauseCount;
+    uint64_t pauseTime;
+    uint64_t maxPauseTime;
+
+    /// <summary>
+    ///     Pause histogram. Element 0 counts pauses under 1ms, element i counts pauses in
+    ///     [2^(i-1), 2^i) ms and the last element counts longer pauses.
+    /// </summary>
+    unsigned int pauseHistogram[12];
+
+    uint64_t markTime;
+    uint64_t rescanTime;
+    uint64_t sweepTime;
+
+    /// <summary>
+    ///     Time spent running dispose callbacks after collections. Finalizers that run while
+    ///     sweeping are counted in sweep time.
+    /// </summary>
+    uint64_t disposeTime;
+
+    /// <summary>
+    ///     Total bytes allocated by the runtime, and the size of the heap at the start and end of
+    ///     the last collection and the largest size seen at the start of a collection.
+    /// </summary>
+    size_t allocatedBytes;
+    size_t heapSizeBeforeLastCollection;
+    size_t heapSizeAfterLastCollection;
+    size_t peakHeapSize;
+} JsGCStatistics;
+
+/// <summary>
+///     Gets the garbage collection statistics of a runtime.
+/// </summary>
+/// <remarks>
+///     The statistics are always maintained and are cheap to read, so hosts can poll them to
+///     detect regressions in production. The values are read without synchronizing with an
+///     in-progress concurrent collection, so the phase times may be slightly behind.
+/// </remarks>
+/// <param name="runtime">The runtime to query.</param>
+/// <param name="statistics">The garbage collection statistics.</param>
+/// <returns>
+///     The code <c>JsNoError</c> if the operation succeeded, a failure code otherwise.
+/// </returns>
+CHAKRA_API
+    JsGetRuntimeGCStatistics(
+        _In_ JsRuntimeHandle runtime,
+        _Out_ JsGCStatistics *statistics);
+
+/// <summary>
+///     Gives the current runtime a bounded amount of idle time to do garbage collection work.
+/// </summary>
+/// <remarks>
+///     <para>
+///     Unlike <c>JsIdle</c>, this does not require <c>JsRuntimeAttributeEnableIdleProcessing</c>
+///     and is driven entirely by the host, e.g. from an event loop that knows how long it is until
+///     its next task. The runtime starts a concurrent collection if enough memory was allocated since
+///     the last one, lets the background thread mark and sweep, and does the in-thread parts of the
+///     collection when they are ready. Work that doesn't fit in <paramref name="idleTime" /> is
+///     resumed by the next call, or by the next allocation triggered collection. A collection that
+///     would have to run on the calling thread is not started unless the longest collection pause
+///     seen so far fits in the idle time left.
+///     </para>
+///     <para>
+///     Requires an active script context. Has no effect on runtimes created with
+///     <c>JsRuntimeAttributeDisableBackgroundWork</c>.
+///     </para>
+/// </remarks>
+/// <param name="idleTime">The number of milliseconds the host is idle for.</param>
+/// <param name="workPending">
+///     [out] Whether there is collection work left that a later call can make progress on.
+/// </param>
+/// <returns>
+///     The code <c>JsNoError</c> if the operation succeeded, a failure code otherwise.
+/// </returns>
+CHAKRA_API
+    JsIdleWithDeadline(
+        _In_ unsigned int idleTime,
+        _Out_opt_ bool *workPending);
+
+/// <summary>
+///     A callback called by <c>JsWriteHeapSnapshot</c> with each chunk of the snapshot.
+/// </summary>
+/// <remarks>
+///     The callback must not call back into the runtime.
+/// </remarks>
+/// <param name="chunk">The next chunk of the snapshot. It is only valid during the call.</param>
+/// <param name="length">The length of the chunk in bytes.</param>
+/// <param name="callbackState">The state passed to <c>JsWriteHeapSnapshot</c>.</param>
+typedef void (CHAKRA_CALLBACK * JsHeapSnapshotWriteCallback)(_In_reads_(length) const char *chunk, _In_ size_t length, _In_opt_ void *callbackState);
+
+/// <summary>
+///     Writes a snapshot of the garbage collected heap of a runtime.
+/// </summary>
+/// <remarks>
+///     <para>
+///     The snapshot is in the JSON .heapsnapshot format read by the Chrome developer tools. It lists
+///     every allocated object with its size and a name derived from its type, the contents of flat
+///     strings, and a reference from each object to every object it holds a pointer to. Retained sizes
+///     are computed by the tools from the graph. References from the stack are not included.
+///     </para>
+///     <para>
+///     The snapshot is streamed to <paramref name="writeCallback" /> as it is produced and the heap is
+///     walked several times instead of being copied, so the memory used is proportional to the number
+///     of heap pages rather than the number of objects. Collection is disabled while the snapshot is
+///     written.
+///     </para>
+///     <para>
+///     Requires the runtime to be either idle or active on the current thread.
+///     </para>
+/// </remarks>
+/// <param name="runtime">The runtime whose heap is written.</param>
+/// <param name="writeCallback">The callback the snapshot is written to.</param>
+/// <param name="callbackState">User provided state that will be passed to the callback.</param>
+/// <returns>
+///     The code <c>JsNoError</c> if the operation succeeded, a failure code otherwise.
+/// </returns>
+CHAKRA_API
+    JsWriteHeapSnapshot(
+        _In_ JsRuntimeHandle runtime,
+        _In_ JsHeapSnapshotWriteCallback writeCallback,
+        _In_opt_ void *callbackState);
+
+/// <summary>
+///     Flags describing the finalize callback of an external object.
+/// </summary>
+typedef enum _JsFinalizeCallbackFlags
+{
+    /// <summary>
+    ///     The finalize callback is called on the thread running the garbage collection.
+    /// </summary>
+    JsFinalizeCallbackFlagNone = 0x00000000,
+    /// <summary>
+    ///     The finalize callback only releases the external data and does not call back into the
+    ///     runtime, so it may be called on any thread.
+    /// </summary>
+    JsFinalizeCallbackFlagThreadSafe = 0x00000001
+} JsFinalizeCallbackFlags;
+
+/// <summary>
+///     Creates a new object that stores some external data, with flags for its finalize callback.
+/// </summary>
+/// <remarks>
+///     <para>
+///     Behaves like <c>JsCreateExternalObject</c>. In a runtime created with
+///     <c>JsRuntimeAttributeEnableBackgroundFinalization</c>, a finalize callback marked with
+///     <c>JsFinalizeCallbackFlagThreadSafe</c> is called on a background thread, after the collection
+///     that found the object unreachable, so that it doesn't add to the garbage collection pause.
+///     Callbacks are still called on the collecting thread when the runtime is disposed.
+///     </para>
+///     <para>
+///     Requires an active script context.
+///     </para>
+/// </remarks>
+/// <param name="data">External data that the object will represent. May be null.</param>
+/// <param name="finalizeCallback">
+///     A callback for when the object is finalized. May be null.
+/// </param>
+/// <param name="flags">Flags describing the finalize callback.</param>
+/// <param name="object">The new object.</param>
+/// <returns>
+///     The code <c>JsNoError</c> if the operation succeeded, a failure code otherwise.
+/// </returns>
+CHAKRA_API
+    JsCreateExternalObjectWithFinalizeFlags(
+        _In_opt_ void *data,
+        _In_opt_ JsFinalizeCallback finalizeCallback,
+        _In_ JsFinalizeCallbackFlags flags,
+        _Out_ JsValueRef *object);
+
+/// <summary>
+///     Enables the persistent dynamic profile cache of the process.
+/// </summary>
+/// <remarks>
+///     <para>
+///     The type and execution profiles collected for scripts run with <c>JsRun</c>, <c>JsParse</c> and
+///     their variants are written to one file per script in the given directory when the script's
+///     context is released. The files are keyed by a hash of the script source and tied to the engine
+///     build. When the same source runs again in this or a later process, its profile is loaded before
+///     the script executes, so that the functions that were hot in the earlier run can be queued for
+///     full JIT right away instead of being profiled again.
+///     </para>
+///     <para>
+///     Scripts run from a buffer produced by <c>JsSerialize</c> are keyed by a hash of the buffer. Combined
+///     with a bytecode cache, functions that reached full JIT in an earlier run are queued for full JIT
+///     as soon as the script is loaded. The machine code itself is not cached. It is regenerated from
+///     the profile in the background and guarded like any other profile-based code.
+///     </para>
+///     <para>
+///     Must be called before any runtime is created. Files written by other builds, and corrupted
+///     or partial files, are ignored. Several processes can share the same directory.
+///     </para>
+///     <para>
+///     The files are only checked for accidental corruption, not for tampering: profile data steers
+///     the JIT, so the directory must only be writable by the host.
+///     </para>
+/// </remarks>
+/// <param name="directory">The directory to store the profiles in, created if it doesn't exist.</param>
+/// <returns>
+///     The code <c>JsNoError</c> if the operation succeeded, a failure code otherwise.
+///     <c>JsErrorInvalidArgument</c> if the directory can't be used or the cache was already enabled
+///     with a different directory.
+/// </returns>
+CHAKRA_API
+    JsSetDynamicProfileCacheDirectory(
+        _In_z_ const char *directory);
 #endif // NTBUILD
 #endif // _CHAKRACORE_H_
@@ -14,6 +14,10 @@
 #include "Library/DataView.h"
 #include "Library/JavascriptSymbol.h"
 #include "Base/ThreadContextTlsEntry.h"
+#include "Base/HeapSnapshotWriter.h"
+#ifdef DYNAMIC_PROFILE_STORAGE
+#include "Language/DynamicProfileStorage.h"
+#endif
 #include "Codex/Utf8Helper.h"
 
 // Parser Includes
@@ -106,7 +110,9 @@ JsErrorCode CreateRuntimeCore(_In_ JsRuntimeAttributes attributes, _In_opt_ cons
             JsRuntimeAttributeDisableEval |
             JsRuntimeAttributeDisableNativeCodeGeneration |
             JsRuntimeAttributeEnableExperimentalFeatures |
-            JsRuntimeAttributeDispatchSetExceptionsToDebugger
+            JsRuntimeAttributeDispatchSetExceptionsToDebugger |
+            JsRuntimeAttributeEnableBackgroundFinalization |
+            JsRuntimeAttributeShareBackgroundNativeCodeGeneration
 #ifdef ENABLE_DEBUG_CONFIG_OPTIONS
             | JsRuntimeAttributeSerializeLibraryByteCode
 #endif
@@ -158,6 +164,18 @@ JsErrorCode CreateRuntimeCore(_In_ JsRuntimeAttributes attributes, _In_opt_ cons
             threadContext->SetThreadContextFlag(ThreadContextFlagNoJIT);
         }
 
+        if (attributes & JsRuntimeAttributeEnableBackgroundFinalization)
+        {
+            threadContext->SetThreadContextFlag(ThreadContextFlagBackgroundFinalization);
+        }
+
+#if ENABLE_NATIVE_CODEGEN
+        if (attributes & JsRuntimeAttributeShareBackgroundNativeCodeGeneration)
+        {
+            threadContext->ShareBgJit(true);
+        }
+#endif
+
 #ifdef ENABLE_DEBUG_CONFIG_OPTIONS
         if (Js::Configuration::Global.flags.PrimeRecycler)
         {
@@ -1131,13 +1149,23 @@ CHAKRA_API JsCreateObject(_Out_ JsValueRef *object)
 }
 
 CHAKRA_API JsCreateExternalObject(_In_opt_ void *data, _In_opt_ JsFinalizeCallback finalizeCallback, _Out_ JsValueRef *object)
+{
+    return JsCreateExternalObjectWithFinalizeFlags(data, finalizeCallback, JsFinalizeCallbackFlagNone, object);
+}
+
+CHAKRA_API JsCreateExternalObjectWithFinalizeFlags(_In_opt_ void *data, _In_opt_ JsFinalizeCallback finalizeCallback, _In_ JsFinalizeCallbackFlags flags, _Out_ JsValueRef *object)
 {
     return ContextAPINoScriptWrapper([&](Js::ScriptContext *scriptContext) -> JsErrorCode {
         PARAM_NOT_NULL(object);
+        if ((flags & ~JsFinalizeCallbackFlagThreadSafe) != 0)
+        {
+            return JsErrorInvalidArgument;
+        }
 
         PERFORM_JSRT_TTD_RECORD_ACTION_STD_NOSCRIPTWRAPPER(RecordJsRTAllocateExternalObject);
 
-        *object = RecyclerNewFinalized(scriptContext->GetRecycler(), JsrtExternalObject, RecyclerNew(scriptContext->GetRecycler(), JsrtExternalType, scriptContext, finalizeCallback), data);
+        bool isFinalizeCallbackThreadSafe = (flags & JsFinalizeCallbackFlagThreadSafe) != 0;
+        *object = RecyclerNewFinalized(scriptContext->GetRecycler(), JsrtExternalObject, RecyclerNew(scriptContext->GetRecycler(), JsrtExternalType, scriptContext, finalizeCallback, isFinalizeCallbackThreadSafe), data);
 
         PERFORM_JSRT_TTD_RECORD_ACTION_RESULT(object);
 
@@ -2795,7 +2823,17 @@ JsErrorCode RunScriptCore(JsValueRef scriptSource, const byte *script, size_t cb
 
         if (sourceContextInfo == nullptr)
         {
-            sourceContextInfo = scriptContext->CreateSourceContextInfo(sourceContext, sourceUrl, wcslen(sourceUrl), nullptr);
+            char16 const * profileCacheKey = nullptr;
+#ifdef DYNAMIC_PROFILE_STORAGE
+            char16 sourceCacheKey[DynamicProfileStorage::SourceCacheKeyLength];
+            if (DynamicProfileStorage::UsesSourceCache())
+            {
+                DynamicProfileStorage::GetSourceCacheKey(script, cb, sourceCacheKey);
+                profileCacheKey = sourceCacheKey;
+            }
+#endif
+            sourceContextInfo = scriptContext->CreateSourceContextInfo(sourceContext, sourceUrl, wcslen(sourceUrl), nullptr,
+                nullptr, 0, profileCacheKey);
         }
 
         const int chsize = (loadScriptFlag & LoadScriptFlag_Utf8Source) ?
@@ -3165,8 +3203,21 @@ JsErrorCode RunSerializedScriptCore(
 
         if (sourceContextInfo == nullptr)
         {
+            char16 const * profileCacheKey = nullptr;
+#ifdef DYNAMIC_PROFILE_STORAGE
+            // The source is only loaded on demand here, key the profile by the serialized buffer instead.
+            // It is produced from the source by this build of the engine, so it identifies the script as well.
+            char16 sourceCacheKey[DynamicProfileStorage::SourceCacheKeyLength];
+            uint32 serializedSize;
+            if (DynamicProfileStorage::UsesSourceCache() &&
+                Js::ByteCodeSerializer::GetSerializedSize(buffer, &serializedSize))
+            {
+                DynamicProfileStorage::GetSourceCacheKey(buffer, serializedSize, sourceCacheKey);
+                profileCacheKey = sourceCacheKey;
+            }
+#endif
             sourceContextInfo = scriptContext->CreateSourceContextInfo(sourceContext, sourceUrl,
-                wcslen(sourceUrl), nullptr);
+                wcslen(sourceUrl), nullptr, nullptr, 0, profileCacheKey);
         }
 
         SRCINFO si = {
@@ -4604,4 +4655,175 @@ CHAKRA_API JsRunSerialized(
         sourceContext, // use the same user provided sourceContext as scriptLoadSourceContext
         buffer, sourceContext, url, false, result);
 }
+
+CHAKRA_API JsCompactHeap(_In_ JsRuntimeHandle runtimeHandle)
+{
+    return JsCollectGarbageCommon<CollectNowCompact>(runtimeHandle);
+}
+
+CHAKRA_API JsGetContextAllocatedBytes(_In_ JsContextRef context, _Out_ size_t *allocatedBytes, _Out_ size_t *arenaBytes)
+{
+    VALIDATE_JSREF(context);
+    PARAM_NOT_NULL(allocatedBytes);
+    PARAM_NOT_NULL(arenaBytes);
+
+    BEGIN_JSRT_NO_EXCEPTION
+    {
+        if (!JsrtContext::Is(context))
+        {
+            RETURN_NO_EXCEPTION(JsErrorInvalidArgument);
+        }
+
+        JsrtContext * jsrtContext = static_cast<JsrtContext *>(context);
+        Js::ScriptContext * scriptContext = jsrtContext->GetScriptContext();
+
+        // The arenas are only safe to walk from the thread the runtime is running on
+        ThreadContextScope scope(scriptContext->GetThreadContext());
+        if (!scope.IsValid())
+        {
+            RETURN_NO_EXCEPTION(JsErrorWrongThread);
+        }
+
+        *allocatedBytes = jsrtContext->GetAllocatedBytes();
+        *arenaBytes = scriptContext->GetArenaAllocatedBytes();
+    }
+    END_JSRT_NO_EXCEPTION
+}
+
+CHAKRA_API JsGetRuntimeGCStatistics(_In_ JsRuntimeHandle runtimeHandle, _Out_ JsGCStatistics *statistics)
+{
+    VALIDATE_INCOMING_RUNTIME_HANDLE(runtimeHandle);
+    PARAM_NOT_NULL(statistics);
+    memset(statistics, 0, sizeof(JsGCStatistics));
+
+    ThreadContext * threadContext = JsrtRuntime::FromHandle(runtimeHandle)->GetThreadContext();
+    Recycler * recycler = threadContext->GetRecycler();
+    if (recycler == nullptr)
+    {
+        // No allocation has happened yet
+        return JsNoError;
+    }
+
+    CompileAssert(_countof(statistics->pauseHistogram) == RecyclerGCStatistics::PauseHistogramBucketCount);
+    RecyclerGCStatistics const * gcStatistics = recycler->GetGCStatistics();
+
+    statistics->collectionCount = gcStatistics->collectionCount;
+    statistics->partialCollectionCount = gcStatistics->partialCollectionCount;
+    statistics->concurrentCollectionCount = gcStatistics->concurrentCollectionCount;
+    statistics->pauseCount = gcStatistics->pauseCount;
+    statistics->pauseTime = gcStatistics->pauseTime;
+    statistics->maxPauseTime = gcStatistics->maxPauseTime;
+    for (uint i = 0; i < RecyclerGCStatistics::PauseHistogramBucketCount; i++)
+    {
+        statistics->pauseHistogram[i] = gcStatistics->pauseHistogram[i];
+    }
+    statistics->markTime = gcStatistics->markTime;
+    statistics->rescanTime = gcStatistics->rescanTime;
+    statistics->sweepTime = gcStatistics->sweepTime;
+    statistics->disposeTime = gcStatistics->disposeTime;
+    statistics->allocatedBytes = recycler->GetTotalAllocBytes();
+    statistics->heapSizeBeforeLastCollection = gcStatistics->heapSizeBeforeLastCollection;
+    statistics->heapSizeAfterLastCollection = gcStatistics->heapSizeAfterLastCollection;
+    statistics->peakHeapSize = gcStatistics->peakHeapSize;
+
+    return JsNoError;
+}
+
+CHAKRA_API JsIdleWithDeadline(_In_ unsigned int idleTime, _Out_opt_ bool *workPending)
+{
+    return ContextAPINoScriptWrapper(
+        [&] (Js::ScriptContext * scriptContext) -> JsErrorCode {
+
+            if (workPending != nullptr)
+            {
+                *workPending = false;
+            }
+
+            ThreadContext * threadContext = scriptContext->GetThreadContext();
+            Recycler * recycler = scriptContext->GetRecycler();
+            if (recycler->IsHeapEnumInProgress())
+            {
+                return JsErrorHeapEnumInProgress;
+            }
+            else if (threadContext->IsInThreadServiceCallback())
+            {
+                return JsErrorInThreadServiceCallback;
+            }
+
+            bool pending = recycler->CollectOnIdle(idleTime);
+            if (workPending != nullptr)
+            {
+                *workPending = pending;
+            }
+
+            return JsNoError;
+    });
+}
+
+struct HeapSnapshotWriteState
+{
+    JsHeapSnapshotWriteCallback writeCallback;
+    void * callbackState;
+};
+
+static void WriteHeapSnapshotChunk(const char * chunk, size_t length, void * state)
+{
+    HeapSnapshotWriteState * writeState = (HeapSnapshotWriteState *)state;
+    writeState->writeCallback(chunk, length, writeState->callbackState);
+}
+
+CHAKRA_API JsWriteHeapSnapshot(_In_ JsRuntimeHandle runtimeHandle, _In_ JsHeapSnapshotWriteCallback writeCallback, _In_opt_ void *callbackState)
+{
+    return GlobalAPIWrapper([&]() -> JsErrorCode {
+        VALIDATE_INCOMING_RUNTIME_HANDLE(runtimeHandle);
+        PARAM_NOT_NULL(writeCallback);
+
+        ThreadContext * threadContext = JsrtRuntime::FromHandle(runtimeHandle)->GetThreadContext();
+
+        if (threadContext->GetRecycler() && threadContext->GetRecycler()->IsHeapEnumInProgress())
+        {
+            return JsErrorHeapEnumInProgress;
+        }
+        else if (threadContext->IsInThreadServiceCallback())
+        {
+            return JsErrorInThreadServiceCallback;
+        }
+
+        ThreadContextScope scope(threadContext);
+
+        if (!scope.IsValid())
+        {
+            return JsErrorWrongThread;
+        }
+
+        Recycler * recycler = threadContext->EnsureRecycler();
+        HeapSnapshotWriteState writeState = { writeCallback, callbackState };
+
+        // The writer's buffer is too large for the stack
+        AutoPtr<Js::HeapSnapshotWriter> writer(HeapNew(Js::HeapSnapshotWriter, recycler, WriteHeapSnapshotChunk, &writeState));
+
+        Recycler::AutoSetupRecyclerForNonCollectingMark autoSetupRecycler(*recycler, true);
+        autoSetupRecycler.SetupForHeapEnumeration();
+        writer->Write();
+
+        return JsNoError;
+    });
+}
+
+CHAKRA_API JsSetDynamicProfileCacheDirectory(_In_z_ const char *directory)
+{
+    PARAM_NOT_NULL(directory);
+
+#ifdef DYNAMIC_PROFILE_STORAGE
+    utf8::NarrowToWide wideDirectory((LPCSTR)directory);
+    if (!wideDirectory)
+    {
+        return JsErrorOutOfMemory;
+    }
+
+    return DynamicProfileStorage::EnableSourceCache(wideDirectory) ? JsNoError : JsErrorInvalidArgument;
+#else
+    return JsErrorNotImplemented;
+#endif
+}
 #endif // NTBUILD
@@ -102,13 +102,36 @@ bool JsrtContext::TrySetCurrent(JsrtContext * context)
     JsrtContext* originalContext = s_tlvSlot;
     if (originalContext != nullptr)
     {
+        originalContext->UpdateAllocatedBytes();
         originalContext->GetScriptContext()->GetRecycler()->RootRelease((LPVOID) originalContext);
     }
 
     s_tlvSlot = context;
+    if (context != nullptr)
+    {
+        context->lastTotalAllocBytes = context->GetScriptContext()->GetRecycler()->GetTotalAllocBytes();
+    }
     return true;
 }
 
+void JsrtContext::UpdateAllocatedBytes()
+{
+    // Everything the recycler handed out since this context became current is charged to it,
+    // including allocation made on behalf of other contexts reached through cross-context calls.
+    size_t totalAllocBytes = this->GetScriptContext()->GetRecycler()->GetTotalAllocBytes();
+    this->allocatedBytes += totalAllocBytes - this->lastTotalAllocBytes;
+    this->lastTotalAllocBytes = totalAllocBytes;
+}
+
+size_t JsrtContext::GetAllocatedBytes()
+{
+    if (s_tlvSlot == this)
+    {
+        UpdateAllocatedBytes();
+    }
+    return this->allocatedBytes;
+}
+
 void JsrtContext::Finalize(bool isShutdown)
 {
 }
@@ -48,6 +48,7 @@ public:
     JsrtRuntime * GetRuntime() const { return this->runtime; }
     void* GetExternalData() const { return this->externalData; }
     void SetExternalData(void * data) { this->externalData = data; }
+    size_t GetAllocatedBytes();
 
     static JsrtContext * GetCurrent();
     static bool TrySetCurrent(JsrtContext * context);
@@ -67,11 +68,16 @@ protected:
     void Unlink();
     void SetJavascriptLibrary(Js::JavascriptLibrary * library);
     void PinCurrentJsrtContext();
+    void UpdateAllocatedBytes();
 private:
     Js::JavascriptLibrary * javascriptLibrary;
 
     JsrtRuntime * runtime;
     void* externalData = nullptr;
+    // Recycler allocation attributed to this context while it was current, and the recycler's
+    // total allocation count at the point it last became current.
+    size_t allocatedBytes = 0;
+    size_t lastTotalAllocBytes = 0;
     GC_MARKED_OBJECT<JsrtContext> previous;
     GC_MARKED_OBJECT<JsrtContext> next;
 };
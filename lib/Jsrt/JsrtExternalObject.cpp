@@ -7,7 +7,7 @@
 #include "JsrtExternalObject.h"
 #include "Types/PathTypeHandler.h"
 
-JsrtExternalType::JsrtExternalType(Js::ScriptContext* scriptContext, JsFinalizeCallback finalizeCallback)
+JsrtExternalType::JsrtExternalType(Js::ScriptContext* scriptContext, JsFinalizeCallback finalizeCallback, bool isFinalizeCallbackThreadSafe)
     : Js::DynamicType(
         scriptContext,
         Js::TypeIds_Object,
@@ -17,6 +17,7 @@ JsrtExternalType::JsrtExternalType(Js::ScriptContext* scriptContext, JsFinalizeC
         true,
         true)
         , jsFinalizeCallback(finalizeCallback)
+        , isFinalizeCallbackThreadSafe(isFinalizeCallbackThreadSafe)
 {
     this->flags |= TypeFlagMask_JsrtExternal;
 }
@@ -46,9 +47,21 @@ JsrtExternalObject * JsrtExternalObject::FromVar(Js::Var value)
 
 void JsrtExternalObject::Finalize(bool isShutdown)
 {
-    JsFinalizeCallback finalizeCallback = this->GetExternalType()->GetJsFinalizeCallback();
+    JsrtExternalType * externalType = this->GetExternalType();
+    JsFinalizeCallback finalizeCallback = externalType->GetJsFinalizeCallback();
     if (nullptr != finalizeCallback)
     {
+#if ENABLE_CONCURRENT_GC
+        if (!isShutdown && externalType->IsFinalizeCallbackThreadSafe())
+        {
+            // The recycler hands the callback to its finalize helper thread if the runtime opted in
+            if (this->GetRecycler()->TryQueueBackgroundFinalizeCallback((BackgroundFinalizeCallback)finalizeCallback, this->slot))
+            {
+                return;
+            }
+        }
+#endif
+
         JsrtCallbackState scope(nullptr);
         finalizeCallback(this->slot);
     }
@@ -27,14 +27,16 @@
 class JsrtExternalType sealed : public Js::DynamicType
 {
 public:
-    JsrtExternalType(JsrtExternalType *type) : Js::DynamicType(type), jsFinalizeCallback(type->jsFinalizeCallback) {}
-    JsrtExternalType(Js::ScriptContext* scriptContext, JsFinalizeCallback finalizeCallback);
+    JsrtExternalType(JsrtExternalType *type) : Js::DynamicType(type), jsFinalizeCallback(type->jsFinalizeCallback), isFinalizeCallbackThreadSafe(type->isFinalizeCallbackThreadSafe) {}
+    JsrtExternalType(Js::ScriptContext* scriptContext, JsFinalizeCallback finalizeCallback, bool isFinalizeCallbackThreadSafe = false);
 
     //Js::PropertyId GetNameId() const { return ((Js::PropertyRecord *)typeDescription.className)->GetPropertyId(); }
     JsFinalizeCallback GetJsFinalizeCallback() const { return this->jsFinalizeCallback; }
+    bool IsFinalizeCallbackThreadSafe() const { return this->isFinalizeCallbackThreadSafe; }
 
 private:
     JsFinalizeCallback jsFinalizeCallback;
+    bool isFinalizeCallbackThreadSafe;
 };
 AUTO_REGISTER_RECYCLER_OBJECT_DUMPER(JsrtExternalType, &Js::Type::DumpObjectFunction);
 
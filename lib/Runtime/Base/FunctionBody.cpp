@@ -15,6 +15,9 @@
 #ifdef VTUNE_PROFILING
 #include "Base/VTuneChakraProfile.h"
 #endif
+#ifdef PERF_JIT_PROFILING
+#include "Base/PerfChakraProfile.h"
+#endif
 
 #ifdef DYNAMIC_PROFILE_MUTATOR
 #include "Language/DynamicProfileMutator.h"
@@ -3248,6 +3251,9 @@ namespace Js
 #ifdef VTUNE_PROFILING
         VTuneChakraProfile::LogMethodNativeLoadEvent(this, entryPointInfo);
 #endif
+#ifdef PERF_JIT_PROFILING
+        PerfChakraProfile::LogMethodNativeLoadEvent(this, entryPointInfo);
+#endif
 
 #ifdef _M_ARM
         // For ARM we need to make sure that pipeline is synchronized with memory/cache for newly jitted code.
@@ -3307,6 +3313,9 @@ namespace Js
         JS_ETW(EtwTrace::LogLoopBodyLoadEvent(this, loopHeader, ((LoopEntryPointInfo*)entryPointInfo), ((uint16)loopNum)));
 #ifdef VTUNE_PROFILING
         VTuneChakraProfile::LogLoopBodyLoadEvent(this, loopHeader, ((LoopEntryPointInfo*)entryPointInfo), ((uint16)loopNum));
+#endif
+#ifdef PERF_JIT_PROFILING
+        PerfChakraProfile::LogLoopBodyLoadEvent(this, ((LoopEntryPointInfo*)entryPointInfo), ((uint16)loopNum));
 #endif
     }
 #endif
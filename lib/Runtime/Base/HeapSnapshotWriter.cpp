@@ -0,0 +1,591 @@
+//-------------------------------------------------------------------------------------------------------
+// Copyright (C) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE.txt file in the project root for full license information.
+//-------------------------------------------------------------------------------------------------------
+#include "RuntimeBasePch.h"
+#include "Base/HeapSnapshotWriter.h"
+
+namespace Js
+{
+    // Recycler::EnumerateObjects takes a plain function pointer, so the writer doing the walk is kept per thread
+    static THREAD_LOCAL HeapSnapshotWriter * s_currentWriter = nullptr;
+
+    // Fixed entries at the start of the strings table. The TypeId names follow them, and the contents of
+    // string nodes follow those, in heap enumeration order.
+    enum HeapSnapshotStringIndex
+    {
+        StringIndex_Empty,
+        StringIndex_Roots,
+        StringIndex_Internal,
+        StringIndex_Leaf,
+        StringIndex_FirstTypeName,
+        StringIndex_FirstStringNode = StringIndex_FirstTypeName + TypeIds_Limit
+    };
+
+    HeapSnapshotWriter::HeapSnapshotWriter(Recycler * recycler, WriteCallback writeCallback, void * callbackState) :
+        recycler(recycler),
+        writeCallback(writeCallback),
+        callbackState(callbackState),
+        blockOrdinals(&HeapAllocator::Instance),
+        walkMode(WalkMode_Blocks),
+        nodeCount(0),
+        stringNodeCount(0),
+        rootEdgeCount(0),
+        edgeCount(0),
+        currentBlock(nullptr),
+        currentOrdinal(RootOrdinal),
+        currentIndex(0),
+        currentStringIndex(StringIndex_FirstStringNode),
+        needSeparator(false),
+        bufferLength(0)
+    {
+    }
+
+    void HeapSnapshotWriter::Write()
+    {
+        Assert(recycler->IsHeapEnumInProgress());
+        Assert(s_currentWriter == nullptr);
+
+        // Number the objects and count the edges first, the header needs both
+        Walk(WalkMode_Blocks);
+        ForEachPinnedRoot([&](RecyclerHeapObjectInfo const& heapObject)
+        {
+            rootEdgeCount++;
+        });
+        Walk(WalkMode_CountEdges);
+        edgeCount += rootEdgeCount;
+
+        WriteHeader();
+
+        WriteRaw(",\n\"nodes\":[");
+        needSeparator = false;
+        WriteNode(NodeType_Synthetic, StringIndex_Roots, 1, 0, rootEdgeCount);
+        Walk(WalkMode_Nodes);
+        Assert(currentStringIndex == StringIndex_FirstStringNode + stringNodeCount);
+
+        // Edges are listed in the order of their source nodes, so the root's come first
+        WriteRaw("],\n\"edges\":[");
+        needSeparator = false;
+        currentIndex = 0;
+        ForEachPinnedRoot([&](RecyclerHeapObjectInfo const& heapObject)
+        {
+            WriteEdge(currentIndex++, GetOrdinal(heapObject));
+        });
+        Walk(WalkMode_RootEdges);
+        Assert(currentIndex == rootEdgeCount);
+        Walk(WalkMode_Edges);
+
+        WriteRaw("],\n\"trace_function_infos\":[],\n\"trace_tree\":[],\n\"samples\":[],\n\"locations\":[],\n\"strings\":[");
+        needSeparator = false;
+        WriteStrings();
+        WriteRaw("]}\n");
+        Flush();
+    }
+
+    void HeapSnapshotWriter::WalkCallback(void * address, size_t size)
+    {
+        s_currentWriter->WalkObject(address, size);
+    }
+
+    void HeapSnapshotWriter::Walk(WalkMode mode)
+    {
+        walkMode = mode;
+        currentBlock = nullptr;
+        currentOrdinal = RootOrdinal;
+
+        {
+            AutoRestoreValue<HeapSnapshotWriter *> autoRestoreCurrentWriter(&s_currentWriter, this);
+            recycler->EnumerateObjects(EnumerateAllObjectsBit, &HeapSnapshotWriter::WalkCallback);
+        }
+
+        Assert(currentOrdinal == nodeCount);
+    }
+
+    void HeapSnapshotWriter::WalkObject(void * address, size_t size)
+    {
+        RecyclerHeapObjectInfo heapObject;
+        AssertVerify(recycler->FindHeapObject(address, FindHeapObjectFlags_NoFlags, heapObject));
+
+        uint ordinal = ++currentOrdinal;
+
+        switch (walkMode)
+        {
+        case WalkMode_Blocks:
+        {
+            // EnumerateObjects reports the objects of a block together, so a block's objects are numbered
+            // from its first ordinal in the order GetAllocatedObjectIndex counts them.
+            if (heapObject.GetHeapBlock() != currentBlock)
+            {
+                currentBlock = heapObject.GetHeapBlock();
+                Assert(!blockOrdinals.ContainsKey(currentBlock));
+                blockOrdinals.Add(currentBlock, ordinal);
+            }
+            Assert(GetOrdinal(heapObject) == ordinal);
+
+            nodeCount++;
+            if (heapObject.IsImplicitRoot())
+            {
+                rootEdgeCount++;
+            }
+            if (GetFlatString(address, size, GetTypeId(address, size)) != nullptr)
+            {
+                stringNodeCount++;
+            }
+            break;
+        }
+        case WalkMode_CountEdges:
+            if (!heapObject.IsLeaf())
+            {
+                ForEachEdge(address, size, [&](uint index, RecyclerHeapObjectInfo const& target)
+                {
+                    edgeCount++;
+                });
+            }
+            break;
+
+        case WalkMode_Nodes:
+        {
+            uint objectEdgeCount = 0;
+            if (!heapObject.IsLeaf())
+            {
+                ForEachEdge(address, size, [&](uint index, RecyclerHeapObjectInfo const& target)
+                {
+                    objectEdgeCount++;
+                });
+            }
+
+            NodeType type;
+            uint name;
+            TypeId typeId = GetTypeId(address, size);
+            if (typeId == TypeIds_Limit)
+            {
+                type = NodeType_Hidden;
+                name = heapObject.IsLeaf() ? StringIndex_Leaf : StringIndex_Internal;
+            }
+            else if (GetFlatString(address, size, typeId) != nullptr)
+            {
+                type = NodeType_String;
+                name = currentStringIndex++;
+            }
+            else
+            {
+                type = GetNodeType(typeId);
+                name = StringIndex_FirstTypeName + typeId;
+            }
+
+            // Objects don't move, so an id derived from the address identifies the object across snapshots
+            // for as long as it is alive. Ids are odd, and 1 is the root's.
+            uint64 id = ((uint64)(uintptr_t)address >> 3) | 1;
+            WriteNode(type, name, id, size, objectEdgeCount);
+            break;
+        }
+        case WalkMode_RootEdges:
+            if (heapObject.IsImplicitRoot())
+            {
+                WriteEdge(currentIndex++, ordinal);
+            }
+            break;
+
+        case WalkMode_Edges:
+            if (!heapObject.IsLeaf())
+            {
+                ForEachEdge(address, size, [&](uint index, RecyclerHeapObjectInfo const& target)
+                {
+                    WriteEdge(index, GetOrdinal(target));
+                });
+            }
+            break;
+
+        case WalkMode_Strings:
+        {
+            JavascriptString * str = GetFlatString(address, size, GetTypeId(address, size));
+            if (str != nullptr)
+            {
+                WriteSeparator();
+                WriteJsonString(str->UnsafeGetBuffer(), GetWrittenLength(str));
+            }
+            break;
+        }
+        default:
+            Assert(false);
+        }
+    }
+
+    bool HeapSnapshotWriter::FindObject(void * candidate, RecyclerHeapObjectInfo& heapObject, size_t minimumSize)
+    {
+        // IsValidObject rejects addresses that aren't the start of an object before FindHeapObject asserts on them
+        return recycler->IsValidObject(candidate, minimumSize)
+            && recycler->FindHeapObject(candidate, FindHeapObjectFlags_NoFlags, heapObject);
+    }
+
+    bool HeapSnapshotWriter::FindEdgeTarget(void * candidate, RecyclerHeapObjectInfo& heapObject)
+    {
+        return FindObject(candidate, heapObject) && blockOrdinals.ContainsKey(heapObject.GetHeapBlock());
+    }
+
+    uint HeapSnapshotWriter::GetOrdinal(RecyclerHeapObjectInfo const& heapObject)
+    {
+        return blockOrdinals.Item(heapObject.GetHeapBlock()) + heapObject.GetAllocatedObjectIndex();
+    }
+
+    template <typename Fn>
+    void HeapSnapshotWriter::ForEachEdge(void * address, size_t size, Fn fn)
+    {
+        void ** slots = (void **)address;
+        size_t slotCount = size / sizeof(void *);
+        for (size_t i = 0; i < slotCount; i++)
+        {
+            RecyclerHeapObjectInfo target;
+            if (FindEdgeTarget(slots[i], target))
+            {
+                fn((uint)i, target);
+            }
+        }
+    }
+
+    template <typename Fn>
+    void HeapSnapshotWriter::ForEachPinnedRoot(Fn fn)
+    {
+        recycler->ForEachPinnedObject([&](void * object)
+        {
+            RecyclerHeapObjectInfo heapObject;
+            if (FindEdgeTarget(object, heapObject))
+            {
+                fn(heapObject);
+            }
+        });
+    }
+
+    TypeId HeapSnapshotWriter::GetTypeId(void * address, size_t size)
+    {
+        // Any object can hold anything where a RecyclableObject keeps its type, so only trust it if it leads to a
+        // Type that points to a JavascriptLibrary. Everything read here is validated to be inside a heap object.
+        if (size < sizeof(RecyclableObject))
+        {
+            return TypeIds_Limit;
+        }
+
+        RecyclerHeapObjectInfo heapObject;
+        Type * type = ((RecyclableObject *)address)->GetType();
+        if (!FindObject(type, heapObject, sizeof(Type)) || !FindObject(type->GetLibrary(), heapObject, sizeof(JavascriptLibrary)))
+        {
+            return TypeIds_Limit;
+        }
+
+        TypeId typeId = type->GetTypeId();
+        if ((uint)typeId >= TypeIds_Limit)
+        {
+            return TypeIds_Limit;
+        }
+        return typeId;
+    }
+
+    JavascriptString * HeapSnapshotWriter::GetFlatString(void * address, size_t size, TypeId typeId)
+    {
+        if (typeId != TypeIds_String || size < sizeof(JavascriptString))
+        {
+            return nullptr;
+        }
+
+        JavascriptString * str = (JavascriptString *)address;
+        const char16 * buffer = str->UnsafeGetBuffer();
+        if (buffer == nullptr)
+        {
+            // Not flattened yet; flattening would allocate
+            return nullptr;
+        }
+
+        // The buffer may be outside the recycler (e.g. in the source of a script that is being unloaded);
+        // only read it when it is part of a heap object.
+        RecyclerHeapObjectInfo heapObject;
+        if (!recycler->FindHeapObjectFromInterior((void *)buffer, heapObject))
+        {
+            return nullptr;
+        }
+
+        char * objectEnd = (char *)heapObject.GetObjectAddress() + heapObject.GetSize();
+        if ((char *)(buffer + GetWrittenLength(str)) > objectEnd)
+        {
+            return nullptr;
+        }
+        return str;
+    }
+
+    charcount_t HeapSnapshotWriter::GetWrittenLength(JavascriptString * str)
+    {
+        // Long strings are truncated, the way the tools display them anyway
+        charcount_t length = str->GetLength();
+        return length < MaxStringLength ? length : MaxStringLength;
+    }
+
+    HeapSnapshotWriter::NodeType HeapSnapshotWriter::GetNodeType(TypeId typeId)
+    {
+        switch (typeId)
+        {
+        case TypeIds_String:
+            return NodeType_String;
+        case TypeIds_Integer:
+        case TypeIds_Number:
+        case TypeIds_Int64Number:
+        case TypeIds_UInt64Number:
+            return NodeType_Number;
+        case TypeIds_Function:
+            return NodeType_Closure;
+        case TypeIds_RegEx:
+            return NodeType_RegExp;
+        case TypeIds_HostDispatch:
+        case TypeIds_HostObject:
+            return NodeType_Native;
+        default:
+            return NodeType_Object;
+        }
+    }
+
+    const char * HeapSnapshotWriter::GetTypeName(TypeId typeId)
+    {
+        switch (typeId)
+        {
+        case TypeIds_Undefined:                     return "undefined";
+        case TypeIds_Null:                          return "null";
+        case TypeIds_Boolean:                       return "boolean";
+        case TypeIds_Integer:                       return "Integer";
+        case TypeIds_Number:                        return "Number";
+        case TypeIds_Int64Number:                   return "Int64Number";
+        case TypeIds_UInt64Number:                  return "UInt64Number";
+        case TypeIds_String:                        return "String";
+        case TypeIds_Symbol:                        return "Symbol";
+        case TypeIds_Enumerator:                    return "Enumerator";
+        case TypeIds_VariantDate:                   return "VariantDate";
+        case TypeIds_SIMDFloat32x4:                 return "SIMD.Float32x4";
+        case TypeIds_SIMDFloat64x2:                 return "SIMD.Float64x2";
+        case TypeIds_SIMDInt32x4:                   return "SIMD.Int32x4";
+        case TypeIds_SIMDInt16x8:                   return "SIMD.Int16x8";
+        case TypeIds_SIMDInt8x16:                   return "SIMD.Int8x16";
+        case TypeIds_SIMDUint32x4:                  return "SIMD.Uint32x4";
+        case TypeIds_SIMDUint16x8:                  return "SIMD.Uint16x8";
+        case TypeIds_SIMDUint8x16:                  return "SIMD.Uint8x16";
+        case TypeIds_SIMDBool32x4:                  return "SIMD.Bool32x4";
+        case TypeIds_SIMDBool16x8:                  return "SIMD.Bool16x8";
+        case TypeIds_SIMDBool8x16:                  return "SIMD.Bool8x16";
+        case TypeIds_HostDispatch:                  return "HostDispatch";
+        case TypeIds_WithScopeObject:               return "WithScopeObject";
+        case TypeIds_UndeclBlockVar:                return "UndeclBlockVar";
+        case TypeIds_Proxy:                         return "Proxy";
+        case TypeIds_Function:                      return "Function";
+        case TypeIds_Object:                        return "Object";
+        case TypeIds_Array:                         return "Array";
+        case TypeIds_NativeIntArray:                return "NativeIntArray";
+#if ENABLE_COPYONACCESS_ARRAY
+        case TypeIds_CopyOnAccessNativeIntArray:    return "CopyOnAccessNativeIntArray";
+#endif
+        case TypeIds_NativeFloatArray:              return "NativeFloatArray";
+        case TypeIds_Date:                          return "Date";
+        case TypeIds_RegEx:                         return "RegExp";
+        case TypeIds_Error:                         return "Error";
+        case TypeIds_BooleanObject:                 return "Boolean";
+        case TypeIds_NumberObject:                  return "NumberObject";
+        case TypeIds_StringObject:                  return "StringObject";
+        case TypeIds_SIMDObject:                    return "SIMDObject";
+        case TypeIds_Arguments:                     return "Arguments";
+        case TypeIds_ES5Array:                      return "ES5Array";
+        case TypeIds_ArrayBuffer:                   return "ArrayBuffer";
+        case TypeIds_Int8Array:                     return "Int8Array";
+        case TypeIds_Uint8Array:                    return "Uint8Array";
+        case TypeIds_Uint8ClampedArray:             return "Uint8ClampedArray";
+        case TypeIds_Int16Array:                    return "Int16Array";
+        case TypeIds_Uint16Array:                   return "Uint16Array";
+        case TypeIds_Int32Array:                    return "Int32Array";
+        case TypeIds_Uint32Array:                   return "Uint32Array";
+        case TypeIds_Float32Array:                  return "Float32Array";
+        case TypeIds_Float64Array:                  return "Float64Array";
+        case TypeIds_Int64Array:                    return "Int64Array";
+        case TypeIds_Uint64Array:                   return "Uint64Array";
+        case TypeIds_CharArray:                     return "CharArray";
+        case TypeIds_BoolArray:                     return "BoolArray";
+        case TypeIds_EngineInterfaceObject:         return "EngineInterfaceObject";
+        case TypeIds_DataView:                      return "DataView";
+        case TypeIds_WinRTDate:                     return "WinRTDate";
+        case TypeIds_Map:                           return "Map";
+        case TypeIds_Set:                           return "Set";
+        case TypeIds_WeakMap:                       return "WeakMap";
+        case TypeIds_WeakSet:                       return "WeakSet";
+        case TypeIds_SymbolObject:                  return "SymbolObject";
+        case TypeIds_ArrayIterator:                 return "Array Iterator";
+        case TypeIds_MapIterator:                   return "Map Iterator";
+        case TypeIds_SetIterator:                   return "Set Iterator";
+        case TypeIds_StringIterator:                return "String Iterator";
+        case TypeIds_JavascriptEnumeratorIterator:  return "EnumeratorIterator";
+        case TypeIds_Generator:                     return "Generator";
+        case TypeIds_Promise:                       return "Promise";
+        case TypeIds_SharedArrayBuffer:             return "SharedArrayBuffer";
+        case TypeIds_WebAssemblyModule:             return "WebAssembly.Module";
+        case TypeIds_WebAssemblyInstance:           return "WebAssembly.Instance";
+        case TypeIds_WebAssemblyMemory:             return "WebAssembly.Memory";
+        case TypeIds_WebAssemblyTable:              return "WebAssembly.Table";
+        case TypeIds_GlobalObject:                  return "GlobalObject";
+        case TypeIds_ModuleRoot:                    return "ModuleRoot";
+        case TypeIds_HostObject:                    return "HostObject";
+        case TypeIds_ActivationObject:              return "ActivationObject";
+        case TypeIds_SpreadArgument:                return "SpreadArgument";
+        case TypeIds_ModuleNamespace:               return "ModuleNamespace";
+        case TypeIds_ListIterator:                  return "ListIterator";
+        default:                                    return "(unknown)";
+        }
+    }
+
+    void HeapSnapshotWriter::WriteHeader()
+    {
+        WriteRaw("{\"snapshot\":{\"meta\":{"
+            "\"node_fields\":[\"type\",\"name\",\"id\",\"self_size\",\"edge_count\",\"trace_node_id\"],"
+            "\"node_types\":[[\"hidden\",\"array\",\"string\",\"object\",\"code\",\"closure\",\"regexp\",\"number\",\"native\",\"synthetic\"],"
+            "\"string\",\"number\",\"number\",\"number\",\"number\"],"
+            "\"edge_fields\":[\"type\",\"name_or_index\",\"to_node\"],"
+            "\"edge_types\":[[\"context\",\"element\",\"property\",\"internal\",\"hidden\",\"shortcut\",\"weak\"],\"string_or_number\",\"node\"],"
+            "\"trace_function_info_fields\":[\"function_id\",\"name\",\"script_name\",\"script_id\",\"line\",\"column\"],"
+            "\"trace_node_fields\":[\"id\",\"function_info_index\",\"count\",\"size\",\"children\"],"
+            "\"sample_fields\":[\"timestamp_us\",\"last_assigned_id\"],"
+            "\"location_fields\":[\"object_index\",\"script_id\",\"line\",\"column\"]},"
+            "\"node_count\":");
+        // The synthetic root node isn't part of the heap walk
+        WriteNumber(nodeCount + 1);
+        WriteRaw(",\"edge_count\":");
+        WriteNumber(edgeCount);
+        WriteRaw(",\"trace_function_count\":0}");
+    }
+
+    void HeapSnapshotWriter::WriteNode(NodeType type, uint name, uint64 id, size_t selfSize, uint edgeCount)
+    {
+        WriteSeparator();
+        WriteNumber(type);
+        WriteChar(',');
+        WriteNumber(name);
+        WriteChar(',');
+        WriteNumber(id);
+        WriteChar(',');
+        WriteNumber(selfSize);
+        WriteChar(',');
+        WriteNumber(edgeCount);
+        WriteRaw(",0");
+    }
+
+    void HeapSnapshotWriter::WriteEdge(uint index, uint toOrdinal)
+    {
+        // Pointers found by scanning have no name; they are written as elements indexed by their slot
+        const uint EdgeType_Element = 1;
+
+        WriteSeparator();
+        WriteNumber(EdgeType_Element);
+        WriteChar(',');
+        WriteNumber(index);
+        WriteChar(',');
+        WriteNumber((uint64)toOrdinal * NodeFieldCount);
+    }
+
+    void HeapSnapshotWriter::WriteStrings()
+    {
+        WriteSeparator();
+        WriteJsonString("");
+        WriteSeparator();
+        WriteJsonString("(GC roots)");
+        WriteSeparator();
+        WriteJsonString("(internal)");
+        WriteSeparator();
+        WriteJsonString("(leaf)");
+        for (int typeId = 0; typeId < TypeIds_Limit; typeId++)
+        {
+            WriteSeparator();
+            WriteJsonString(GetTypeName((TypeId)typeId));
+        }
+
+        Walk(WalkMode_Strings);
+    }
+
+    void HeapSnapshotWriter::WriteJsonString(const char * str)
+    {
+        WriteChar('"');
+        WriteRaw(str);
+        WriteChar('"');
+    }
+
+    void HeapSnapshotWriter::WriteJsonString(const char16 * str, charcount_t length)
+    {
+        static const char hexDigits[] = "0123456789abcdef";
+
+        // Everything outside printable ASCII is escaped, so the output is ASCII regardless of the contents
+        WriteChar('"');
+        for (charcount_t i = 0; i < length; i++)
+        {
+            char16 c = str[i];
+            if (c == '"' || c == '\\')
+            {
+                WriteChar('\\');
+                WriteChar((char)c);
+            }
+            else if (c >= 0x20 && c < 0x7F)
+            {
+                WriteChar((char)c);
+            }
+            else
+            {
+                WriteRaw("\\u");
+                WriteChar(hexDigits[(c >> 12) & 0xF]);
+                WriteChar(hexDigits[(c >> 8) & 0xF]);
+                WriteChar(hexDigits[(c >> 4) & 0xF]);
+                WriteChar(hexDigits[c & 0xF]);
+            }
+        }
+        WriteChar('"');
+    }
+
+    void HeapSnapshotWriter::WriteSeparator()
+    {
+        if (needSeparator)
+        {
+            WriteRaw(",\n");
+        }
+        needSeparator = true;
+    }
+
+    void HeapSnapshotWriter::WriteNumber(uint64 value)
+    {
+        char digits[20];
+        uint count = 0;
+        do
+        {
+            digits[count++] = (char)('0' + value % 10);
+            value /= 10;
+        }
+        while (value != 0);
+
+        while (count != 0)
+        {
+            WriteChar(digits[--count]);
+        }
+    }
+
+    void HeapSnapshotWriter::WriteRaw(const char * str)
+    {
+        for (; *str != '\0'; str++)
+        {
+            WriteChar(*str);
+        }
+    }
+
+    void HeapSnapshotWriter::WriteChar(char c)
+    {
+        if (bufferLength == BufferSize)
+        {
+            Flush();
+        }
+        buffer[bufferLength++] = c;
+    }
+
+    void HeapSnapshotWriter::Flush()
+    {
+        if (bufferLength != 0)
+        {
+            writeCallback(buffer, bufferLength, callbackState);
+            bufferLength = 0;
+        }
+    }
+};
@@ -0,0 +1,115 @@
+//-------------------------------------------------------------------------------------------------------
+// Copyright (C) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE.txt file in the project root for full license information.
+//-------------------------------------------------------------------------------------------------------
+#pragma once
+
+namespace Js
+{
+    /*
+    * Writes the recycler heap as a heap snapshot in the JSON format read by the Chrome developer tools,
+    * streaming it to a caller supplied sink a chunk at a time.
+    *
+    * The object graph is never materialized. Instead the heap is walked once per section of the output,
+    * and a node's ordinal is computed from the first ordinal of its heap block plus its position within
+    * the block, so the extra memory used is the output buffer and one entry per heap block.
+    *
+    * Edges are found by scanning non-leaf objects for pointers to the start of heap objects, the same way
+    * the recycler marks. Objects that look like RecyclableObjects are named by their TypeId, and string
+    * contents are written for flat strings. Only self sizes are written; the tools compute retained sizes
+    * from the graph.
+    *
+    * The recycler must be set up for heap enumeration while the writer runs, so that the heap neither
+    * changes nor is collected between the walks.
+    */
+    class HeapSnapshotWriter
+    {
+    public:
+        typedef void (*WriteCallback)(const char * chunk, size_t length, void * callbackState);
+
+        HeapSnapshotWriter(Recycler * recycler, WriteCallback writeCallback, void * callbackState);
+
+        void Write();
+
+    private:
+        enum WalkMode
+        {
+            WalkMode_Blocks,
+            WalkMode_CountEdges,
+            WalkMode_Nodes,
+            WalkMode_RootEdges,
+            WalkMode_Edges,
+            WalkMode_Strings,
+        };
+
+        // Node types, in the order they are declared in the snapshot meta data
+        enum NodeType
+        {
+            NodeType_Hidden,
+            NodeType_Array,
+            NodeType_String,
+            NodeType_Object,
+            NodeType_Code,
+            NodeType_Closure,
+            NodeType_RegExp,
+            NodeType_Number,
+            NodeType_Native,
+            NodeType_Synthetic,
+        };
+
+        static const size_t NodeFieldCount = 6;
+        static const size_t EdgeFieldCount = 3;
+        static const uint RootOrdinal = 0;
+        static const charcount_t MaxStringLength = 1024;
+        static const size_t BufferSize = 64 * 1024;
+
+        static void WalkCallback(void * address, size_t size);
+        void Walk(WalkMode mode);
+        void WalkObject(void * address, size_t size);
+
+        bool FindObject(void * candidate, RecyclerHeapObjectInfo& heapObject, size_t minimumSize = 0);
+        bool FindEdgeTarget(void * candidate, RecyclerHeapObjectInfo& heapObject);
+        uint GetOrdinal(RecyclerHeapObjectInfo const& heapObject);
+        template <typename Fn> void ForEachEdge(void * address, size_t size, Fn fn);
+        template <typename Fn> void ForEachPinnedRoot(Fn fn);
+
+        TypeId GetTypeId(void * address, size_t size);
+        static const char * GetTypeName(TypeId typeId);
+        static NodeType GetNodeType(TypeId typeId);
+        JavascriptString * GetFlatString(void * address, size_t size, TypeId typeId);
+        static charcount_t GetWrittenLength(JavascriptString * str);
+
+        void WriteHeader();
+        void WriteNode(NodeType type, uint name, uint64 id, size_t selfSize, uint edgeCount);
+        void WriteEdge(uint index, uint toOrdinal);
+        void WriteStrings();
+        void WriteJsonString(const char * str);
+        void WriteJsonString(const char16 * str, charcount_t length);
+        void WriteSeparator();
+        void WriteNumber(uint64 value);
+        void WriteRaw(const char * str);
+        void WriteChar(char c);
+        void Flush();
+
+        Recycler * recycler;
+        WriteCallback writeCallback;
+        void * callbackState;
+
+        // First ordinal of the objects of each heap block, in enumeration order
+        JsUtil::BaseDictionary<HeapBlock *, uint, HeapAllocator> blockOrdinals;
+
+        WalkMode walkMode;
+        uint nodeCount;
+        uint stringNodeCount;
+        uint rootEdgeCount;
+        uint64 edgeCount;
+        HeapBlock * currentBlock;
+        uint currentOrdinal;
+        uint currentIndex;
+        uint currentStringIndex;
+        bool needSeparator;
+
+        size_t bufferLength;
+        char buffer[BufferSize];
+    };
+};
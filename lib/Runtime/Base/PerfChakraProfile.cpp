@@ -0,0 +1,91 @@
+//-------------------------------------------------------------------------------------------------------
+// Copyright (C) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE.txt file in the project root for full license information.
+//-------------------------------------------------------------------------------------------------------
+#include "RuntimeBasePch.h"
+
+#ifdef PERF_JIT_PROFILING
+
+#include "PerfChakraProfile.h"
+
+static const char DynamicCode[] = "Dynamic code";
+
+void PerfChakraProfile::UnRegister()
+{
+    PlatformAgnostic::PerfTrace::UnRegister();
+}
+
+bool PerfChakraProfile::IsEnabled()
+{
+    return CONFIG_FLAG_RELEASE(PerfMap) || CONFIG_FLAG_RELEASE(PerfJitDump);
+}
+
+//
+// Log JIT method native load event, full JIT code is marked with '*' and simple JIT code with '~'
+//
+void PerfChakraProfile::LogMethodNativeLoadEvent(Js::FunctionBody* body, Js::FunctionEntryPointInfo* entryPoint)
+{
+    if (IsEnabled())
+    {
+        LogCodeLoadEvent((void*)entryPoint->GetNativeAddress(), entryPoint->GetCodeSize(), body,
+            entryPoint->GetJitMode() == ExecutionMode::SimpleJit ? "~" : "*", "");
+    }
+}
+
+void PerfChakraProfile::LogLoopBodyLoadEvent(Js::FunctionBody* body, Js::LoopEntryPointInfo* entryPoint, uint16 loopNumber)
+{
+    if (IsEnabled())
+    {
+        char suffix[20];
+        sprintf_s(suffix, sizeof(suffix), " Loop %d", loopNumber + 1);
+        LogCodeLoadEvent((void*)entryPoint->GetNativeAddress(), entryPoint->GetCodeSize(), body, "*", suffix);
+    }
+}
+
+void PerfChakraProfile::LogInterpreterThunkLoadEvent(const void* address, size_t size, bool isAsmJs)
+{
+    if (IsEnabled())
+    {
+        PlatformAgnostic::PerfTrace::LogCodeLoadEvent(CONFIG_FLAG_RELEASE(PerfMap), CONFIG_FLAG_RELEASE(PerfJitDump), address, size,
+            isAsmJs ? "JS:AsmJsInterpreterThunks" : "JS:InterpreterThunks");
+    }
+}
+
+//
+// Names the code "JS:<tier><function name><suffix> <url>:<line>", which is close to what other engines report to perf
+//
+void PerfChakraProfile::LogCodeLoadEvent(const void* address, size_t size, Js::FunctionBody* body, const char* tier, const char* suffix)
+{
+    const char16* methodName = body->GetExternalDisplayName();
+    charcount_t methodLength = (charcount_t)min(wcslen(methodName), (size_t)_MAX_PATH);
+
+    const char16* url = body->GetSourceContextInfo()->IsDynamic() ? nullptr : body->GetSourceContextInfo()->url;
+    charcount_t urlLength = url ? (charcount_t)min(wcslen(url), (size_t)_MAX_PATH) : 0;
+
+    size_t length = /* JS: */ 3 + strlen(tier) + methodLength * 3 + strlen(suffix) + /* space */ 1 +
+        (url ? urlLength * 3 : _countof(DynamicCode)) + /* :line */ 12 + /* NULL */ 1;
+    char* name = HeapNewNoThrowArray(char, length);
+    if (name == nullptr)
+    {
+        return;
+    }
+
+    int written = sprintf_s(name, length, "JS:%s", tier);
+    written += (int)utf8::EncodeInto((LPUTF8)(name + written), methodName, methodLength);
+    written += sprintf_s(name + written, length - written, "%s ", suffix);
+    if (url)
+    {
+        written += (int)utf8::EncodeInto((LPUTF8)(name + written), url, urlLength);
+    }
+    else
+    {
+        written += sprintf_s(name + written, length - written, "%s", DynamicCode);
+    }
+    sprintf_s(name + written, length - written, ":%u", (uint)body->GetLineNumber());
+
+    PlatformAgnostic::PerfTrace::LogCodeLoadEvent(CONFIG_FLAG_RELEASE(PerfMap), CONFIG_FLAG_RELEASE(PerfJitDump), address, size, name);
+
+    HeapDeleteArray(length, name);
+}
+
+#endif /* PERF_JIT_PROFILING */
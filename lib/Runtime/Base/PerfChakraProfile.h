@@ -0,0 +1,27 @@
+//-------------------------------------------------------------------------------------------------------
+// Copyright (C) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE.txt file in the project root for full license information.
+//-------------------------------------------------------------------------------------------------------
+#pragma once
+
+#ifdef PERF_JIT_PROFILING
+
+//
+// Names jitted code for the Linux perf profiler, see PlatformAgnostic::PerfTrace.
+// Enabled with the -PerfMap and -PerfJitDump flags.
+//
+class PerfChakraProfile
+{
+public:
+    static void UnRegister();
+
+    static bool IsEnabled();
+    static void LogMethodNativeLoadEvent(Js::FunctionBody* body, Js::FunctionEntryPointInfo* entryPoint);
+    static void LogLoopBodyLoadEvent(Js::FunctionBody* body, Js::LoopEntryPointInfo* entryPoint, uint16 loopNumber);
+    static void LogInterpreterThunkLoadEvent(const void* address, size_t size, bool isAsmJs);
+
+private:
+    static void LogCodeLoadEvent(const void* address, size_t size, Js::FunctionBody* body, const char* tier, const char* suffix);
+};
+
+#endif
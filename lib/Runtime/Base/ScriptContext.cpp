@@ -1101,6 +1101,34 @@ namespace Js
         regexStacks = stacks;
     }
 
+    size_t ScriptContext::GetArenaAllocatedBytes()
+    {
+        size_t size = generalAllocator.AllocatedSize();
+        size += dynamicProfileInfoAllocator.AllocatedSize();
+        size += inlineCacheAllocator.AllocatedSize();
+        size += isInstInlineCacheAllocator.AllocatedSize();
+        size += forInCacheAllocator.AllocatedSize();
+#ifdef ENABLE_BASIC_TELEMETRY
+        size += telemetryAllocator.AllocatedSize();
+#endif
+#ifdef SEPARATE_ARENA
+        size += sourceCodeAllocator.AllocatedSize();
+        size += regexAllocator.AllocatedSize();
+#endif
+#ifdef NEED_MISC_ALLOCATOR
+        size += miscAllocator.AllocatedSize();
+#endif
+        if (interpreterArena != nullptr)
+        {
+            size += interpreterArena->AllocatedSize();
+        }
+        if (guestArena != nullptr)
+        {
+            size += guestArena->AllocatedSize();
+        }
+        return size;
+    }
+
     Js::TempArenaAllocatorObject* ScriptContext::GetTemporaryAllocator(LPCWSTR name)
     {
         return this->threadContext->GetTemporaryAllocator(name);
@@ -2282,7 +2310,8 @@ if (!sourceList)
     // Makes a copy of the URL to be stored in the map.
     //
     SourceContextInfo * ScriptContext::CreateSourceContextInfo(DWORD_PTR sourceContext, char16 const * url, size_t len,
-        IActiveScriptDataCache* profileDataCache, char16 const * sourceMapUrl /*= NULL*/, size_t sourceMapUrlLen /*= 0*/)
+        IActiveScriptDataCache* profileDataCache, char16 const * sourceMapUrl /*= NULL*/, size_t sourceMapUrlLen /*= 0*/,
+        char16 const * profileCacheKey /*= nullptr*/)
     {
         // Take etw rundown lock on this thread context. We are going to init/add to sourceContextInfoMap.
         AutoCriticalSection autocs(GetThreadContext()->GetEtwRundownCriticalSection());
@@ -2306,6 +2335,12 @@ if (!sourceList)
         {
             sourceContextInfo->sourceMapUrl = CopyString(sourceMapUrl, sourceMapUrlLen, this->SourceCodeAllocator());
         }
+#ifdef DYNAMIC_PROFILE_STORAGE
+        if (profileCacheKey != nullptr)
+        {
+            sourceContextInfo->profileCacheKey = CopyString(profileCacheKey, wcslen(profileCacheKey), this->SourceCodeAllocator());
+        }
+#endif
 
 #if ENABLE_PROFILE_INFO
         if (!this->startupComplete)
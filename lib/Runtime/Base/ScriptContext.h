@@ -1034,7 +1034,8 @@ private:
         SourceContextInfo * GetSourceContextInfo(uint hash);
         SourceContextInfo * CreateSourceContextInfo(uint hash, DWORD_PTR hostSourceContext);
         SourceContextInfo * CreateSourceContextInfo(DWORD_PTR hostSourceContext, char16 const * url, size_t len,
-            IActiveScriptDataCache* profileDataCache, char16 const * sourceMapUrl = nullptr, size_t sourceMapUrlLen = 0);
+            IActiveScriptDataCache* profileDataCache, char16 const * sourceMapUrl = nullptr, size_t sourceMapUrlLen = 0,
+            char16 const * profileCacheKey = nullptr);
 
 #if defined(LEAK_REPORT) || defined(CHECK_MEMORY_LEAK)
         void ClearSourceContextInfoMaps()
@@ -1313,6 +1314,9 @@ private:
         CacheAllocator * ForInCacheAllocator() { return &forInCacheAllocator; }
         ArenaAllocator* DynamicProfileInfoAllocator() { return &dynamicProfileInfoAllocator; }
 
+        // Memory currently held by the arenas owned by this script context
+        size_t GetArenaAllocatedBytes();
+
         ArenaAllocator* AllocatorForDiagnostics();
 
         Js::TempArenaAllocatorObject* GetTemporaryAllocator(LPCWSTR name);
@@ -107,6 +107,7 @@ ThreadContext::ThreadContext(AllocationPolicyManager * allocationPolicyManager,
     threadService(threadServiceCallback),
     isOptimizedForManyInstances(Js::Configuration::Global.flags.OptimizeForManyInstances),
     bgJit(Js::Configuration::Global.flags.BgJit),
+    shareBgJit(false),
     pageAllocator(allocationPolicyManager, PageAllocatorType_Thread, Js::Configuration::Global.flags, 0, PageAllocator::DefaultMaxFreePageCount,
         false
 #if ENABLE_BACKGROUND_PAGE_FREEING
@@ -765,6 +766,13 @@ Recycler* ThreadContext::EnsureRecycler()
             newRecycler->SetIsThreadBound();
         }
 
+#if ENABLE_CONCURRENT_GC
+        if (this->TestThreadContextFlag(ThreadContextFlagBackgroundFinalization))
+        {
+            newRecycler->EnableBackgroundFinalization();
+        }
+#endif
+
         // Assign the recycler to the ThreadContext after everything is initialized, because an OOM during initialization would
         // result in only partial initialization, so the 'recycler' member variable should remain null to cause full
         // reinitialization when requested later. Anything that happens after the Detach must have special cleanup code.
@@ -1385,7 +1393,7 @@ ThreadContext::ForceCleanPropertyMap()
 JsUtil::JobProcessor *
 ThreadContext::GetJobProcessor()
 {
-    if(bgJit && isOptimizedForManyInstances)
+    if(IsBgJitShared())
     {
         return ThreadBoundThreadContextManager::GetSharedJobProcessor();
     }
@@ -39,6 +39,7 @@ enum ThreadContextFlags
     ThreadContextFlagCanDisableExecution           = 0x00000001,
     ThreadContextFlagEvalDisabled                  = 0x00000002,
     ThreadContextFlagNoJIT                         = 0x00000004,
+    ThreadContextFlagBackgroundFinalization        = 0x00000008,
 };
 
 const int LS_MAX_STACK_SIZE_KB = 300;
@@ -722,6 +723,7 @@ private:
     bool hasCollectionCallBack;
     bool isOptimizedForManyInstances;
     bool bgJit;
+    bool shareBgJit;
 
     // We report library code to profiler only if called directly by user code. Not if called by library implementation.
     bool isProfilingUserCode;
@@ -1603,6 +1605,16 @@ public:
         Assert(!jobProcessor || enableBgJit == bgJit);
         bgJit = enableBgJit;
     }
+
+    // Background JIT uses the job processor shared by all thread contexts of the process, whose queue is ordered by the
+    // hotness of the work items
+    bool IsBgJitShared() const { return bgJit && (isOptimizedForManyInstances || shareBgJit); }
+
+    void ShareBgJit(const bool shareBgJit)
+    {
+        Assert(!jobProcessor || shareBgJit == this->shareBgJit);
+        this->shareBgJit = shareBgJit;
+    }
 #endif
 
     void* GetJSRTRuntime() const { return jsrtRuntime; }
@@ -4182,6 +4182,20 @@ HRESULT ByteCodeSerializer::DeserializeFromBufferInternal(ScriptContext * script
     return hr;
 }
 
+bool ByteCodeSerializer::GetSerializedSize(const byte * buffer, uint32 * size)
+{
+    // The header starts with the magic constant and the total size, see ByteCodeBufferReader::ReadHeader
+    int magic = *(const unaligned int *)buffer;
+    int totalSize = *(const unaligned int *)(buffer + sizeof(int));
+    if (magic != magicConstant || totalSize < (int)(2 * sizeof(int)))
+    {
+        return false;
+    }
+
+    *size = (uint32)totalSize;
+    return true;
+}
+
 void ByteCodeSerializer::ReadSourceInfo(const DeferDeserializeFunctionInfo* deferredFunction, int& lineNumber, int& columnNumber, bool& m_isEval, bool& m_isDynamicFunction)
 {
     ByteCodeCache* cache = deferredFunction->m_cache;
@@ -162,6 +162,9 @@ namespace Js
 
         static FunctionBody* DeserializeFunction(ScriptContext* scriptContext, DeferDeserializeFunctionInfo* deferredFunction);
 
+        // Get the size of a serialized buffer from its header. Returns false if the buffer wasn't produced by SerializeToBuffer
+        static bool GetSerializedSize(const byte * buffer, uint32 * size);
+
         // This lib doesn't directly depend on the generated interfaces. Ensure the same codes with a C_ASSERT
         static const HRESULT CantGenerate = 0x80020201L;
         static const HRESULT InvalidByteCode = 0x80020202L;
@@ -422,6 +422,7 @@ MACRO_BACKEND_ONLY(     LdArrViewElem,          ElementI,       OpCanCSE
 MACRO_BACKEND_ONLY(     LdArrViewElemWasm,      ElementI,       OpSideEffect        )       // Load from wasm array
 MACRO_BACKEND_ONLY(     Memset,                 ElementI,       OpSideEffect)
 MACRO_BACKEND_ONLY(     Memcopy,                ElementI,       OpSideEffect)
+MACRO_BACKEND_ONLY(     Memvector,              ElementI,       OpSideEffect)   // Element-wise typed array arithmetic, operands chained with ExtendArg_A
 MACRO_BACKEND_ONLY(     ArrayDetachedCheck,     Reg1,           None)   // ensures that an ArrayBuffer has not been detached
 MACRO_BACKEND_ONLY(     LdNativeCodeData,       Reg1,           OpSideEffect)   // load native code data buffer
 MACRO_WMS(              StArrItemI_CI4,         ElementUnsigned1,      OpSideEffect)
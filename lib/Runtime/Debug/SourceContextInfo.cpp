@@ -4,6 +4,9 @@
 //-------------------------------------------------------------------------------------------------------
 #include "RuntimeDebugPch.h"
 #include "Language/SourceDynamicProfileManager.h"
+#ifdef DYNAMIC_PROFILE_STORAGE
+#include "Language/DynamicProfileStorage.h"
+#endif
 
 using namespace Js;
 
@@ -55,16 +58,34 @@ SourceContextInfo* SourceContextInfo::Clone(Js::ScriptContext* scriptContext) co
     {
         char16 const * oldUrl = this->url;
         char16 const * oldSourceMapUrl = this->sourceMapUrl;
+        char16 const * oldProfileCacheKey = nullptr;
+#ifdef DYNAMIC_PROFILE_STORAGE
+        oldProfileCacheKey = this->profileCacheKey;
+#endif
         newSourceContextInfo = scriptContext->CreateSourceContextInfo(
             dwHostSourceContext,
             oldUrl,
             oldUrl? wcslen(oldUrl) : 0,
             NULL,
             oldSourceMapUrl,
-            oldSourceMapUrl ? wcslen(oldSourceMapUrl) : 0);
+            oldSourceMapUrl ? wcslen(oldSourceMapUrl) : 0,
+            oldProfileCacheKey);
         newSourceContextInfo->nextLocalFunctionId = this->nextLocalFunctionId;
         newSourceContextInfo->sourceContextId = this->sourceContextId;
         newSourceContextInfo->EnsureInitialized();
     }
     return newSourceContextInfo;
 }
+
+#ifdef DYNAMIC_PROFILE_STORAGE
+char16 const * SourceContextInfo::GetDynamicProfileStorageKey() const
+{
+    if (this->IsDynamic())
+    {
+        return nullptr;
+    }
+
+    // The source cache is keyed by the source text, the flag driven storage by url
+    return DynamicProfileStorage::UsesSourceCache() ? this->profileCacheKey : this->url;
+}
+#endif
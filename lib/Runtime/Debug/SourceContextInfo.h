@@ -38,9 +38,15 @@ public:
 #if ENABLE_PROFILE_INFO
     Js::SourceDynamicProfileManager * sourceDynamicProfileManager;
 #endif
+#ifdef DYNAMIC_PROFILE_STORAGE
+    char16 const * profileCacheKey;     // Key of the source text in the dynamic profile source cache, if the host provided the source
+#endif
 
     void EnsureInitialized();
     bool IsDynamic() const { return dwHostSourceContext == Js::Constants::NoHostSourceContext || isHostDynamicDocument; }
     bool IsSourceProfileLoaded() const;
     SourceContextInfo* Clone(Js::ScriptContext* scriptContext) const;
+#ifdef DYNAMIC_PROFILE_STORAGE
+    char16 const * GetDynamicProfileStorageKey() const;
+#endif
 };
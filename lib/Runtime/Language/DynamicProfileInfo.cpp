@@ -1077,14 +1077,20 @@ namespace Js
             Assert(!scriptContext->GetProfileInfoList() || scriptContext->GetProfileInfoList()->Empty() || scriptContext->GetNoContextSourceContextInfo()->nextLocalFunctionId != 0);
             return;
         }
+
+        if (scriptContext->GetProfileInfoList() == nullptr)
+        {
+            // The script context was created before the source cache was enabled and didn't track its profiles
+            return;
+        }
         DynamicProfileInfo::UpdateSourceDynamicProfileManagers(scriptContext);
 
         scriptContext->GetSourceContextInfoMap()->Map([&](DWORD_PTR dwHostSourceContext, SourceContextInfo * sourceContextInfo)
         {
-            if (sourceContextInfo->sourceDynamicProfileManager != nullptr && sourceContextInfo->url != nullptr
-                && !sourceContextInfo->IsDynamic())
+            char16 const * storageKey = sourceContextInfo->GetDynamicProfileStorageKey();
+            if (sourceContextInfo->sourceDynamicProfileManager != nullptr && storageKey != nullptr)
             {
-                sourceContextInfo->sourceDynamicProfileManager->SaveToDynamicProfileStorage(sourceContextInfo->url);
+                sourceContextInfo->sourceDynamicProfileManager->SaveToDynamicProfileStorage(storageKey);
             }
         });
 #endif
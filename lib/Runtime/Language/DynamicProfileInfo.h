@@ -513,6 +513,7 @@ namespace Js
             bool disableLoopImplicitCallInfo : 1;
             bool disableStackArgOpt : 1;
             bool disableTagCheck : 1;
+            bool reachedFullJit : 1; // Persisted so that a later run can full JIT the function speculatively
         } bits;
 
         uint32 m_recursiveInlineInfo; // Bit is set for each callsites where the function is called recursively
@@ -663,6 +664,8 @@ namespace Js
         void DisableCheckThis() { this->bits.disableCheckThis = true; }
         bool IsLoopImplicitCallInfoDisabled() const { return this->bits.disableLoopImplicitCallInfo; }
         void DisableLoopImplicitCallInfo() { this->bits.disableLoopImplicitCallInfo = true; }
+        bool HasReachedFullJit() const { return this->bits.reachedFullJit; }
+        void RecordReachedFullJit() { this->bits.reachedFullJit = true; }
 
         bool IsArrayCheckHoistDisabled(const bool isJitLoopBody) const
         {
@@ -10,6 +10,8 @@ bool DynamicProfileStorage::initialized = false;
 bool DynamicProfileStorage::uninitialized = false;
 bool DynamicProfileStorage::enabled = false;
 bool DynamicProfileStorage::useCacheDir = false;
+bool DynamicProfileStorage::useSourceCache = false;
+char16 DynamicProfileStorage::sourceCacheDir[_MAX_PATH];
 bool DynamicProfileStorage::collectInfo = false;
 HANDLE DynamicProfileStorage::mutex = nullptr;
 char16 DynamicProfileStorage::cacheDrive[_MAX_DRIVE];
@@ -20,7 +22,7 @@ DynamicProfileStorage::InfoMap DynamicProfileStorage::infoMap(&NoCheckHeapAlloca
 DynamicProfileStorage::TimeType DynamicProfileStorage::creationTime = DynamicProfileStorage::TimeType();
 int32 DynamicProfileStorage::lastOffset = 0;
 DWORD const DynamicProfileStorage::MagicNumber = 20100526;
-DWORD const DynamicProfileStorage::FileFormatVersion = 2;
+DWORD const DynamicProfileStorage::FileFormatVersion = 3;
 DWORD DynamicProfileStorage::nextFileId = 0;
 #if DBG
 bool DynamicProfileStorage::locked = false;
@@ -313,7 +315,7 @@ bool DynamicProfileStorage::Initialize()
         success = false;
     }
 
-#else
+#elif defined(ENABLE_DEBUG_CONFIG_OPTIONS)
     if (Js::Configuration::Global.flags.IsEnabled(Js::DynamicProfileCacheDirFlag))
     {
         enabled = true;
@@ -325,6 +327,7 @@ bool DynamicProfileStorage::Initialize()
     }
 #endif
 
+#ifdef ENABLE_DEBUG_CONFIG_OPTIONS
     // If -DynamicProfileInput is specified, the file specified in -DynamicProfileCache
     // will not be imported and will be overwritten
     if (Js::Configuration::Global.flags.IsEnabled(Js::DynamicProfileInputFlag))
@@ -391,6 +394,7 @@ bool DynamicProfileStorage::Initialize()
             }
         }
     }
+#endif
 
     return success;
 }
@@ -416,6 +420,7 @@ bool DynamicProfileStorage::Uninitialize()
 
     uninitialized = true;
     bool success = true;
+#ifdef ENABLE_DEBUG_CONFIG_OPTIONS
     if (Js::Configuration::Global.flags.DynamicProfileCache != nullptr)
     {
         Assert(enabled);
@@ -427,6 +432,7 @@ bool DynamicProfileStorage::Uninitialize()
         exportFile = true;
 #endif
     }
+#endif
 
     if (mutex != nullptr)
     {
@@ -504,6 +510,7 @@ bool DynamicProfileStorage::ImportFile(__in_z char16 const * filename, bool allo
         }
         else
         {
+#ifdef ENABLE_DEBUG_CONFIG_OPTIONS
             if (Js::Configuration::Global.flags.Verbose)
             {
                 Output::Print(_u("ERROR: DynamicProfileStorage: Unable to open file '%s' to import (%d)\n"), filename, e);
@@ -513,6 +520,7 @@ bool DynamicProfileStorage::ImportFile(__in_z char16 const * filename, bool allo
                 Output::Print(_u("ERROR:   For file '%s': %s (%d)\n"), filename, error_string, e);
                 Output::Flush();
             }
+#endif
             return false;
         }
     }
@@ -1044,6 +1052,13 @@ void DynamicProfileStorage::SaveRecord(__in_z char16 const * filename, __in_ecou
     Assert(enabled);
     AutoCriticalSection autocs(&cs);
 
+    if (useSourceCache)
+    {
+        WriteSourceCacheRecord(filename, record);
+        DeleteRecord(record);
+        return;
+    }
+
     StorageInfo * info;
 
     if (useCacheDir && AcquireLock())
@@ -1176,4 +1191,172 @@ void DynamicProfileStorage::DeleteRecord(__in_ecount(sizeof(DWORD) + *buffer) ch
     Assert(enabled);
     NoCheckHeapDeleteArray(GetRecordSize(buffer) + sizeof(DWORD), buffer);
 }
+
+bool DynamicProfileStorage::EnableSourceCache(__in_z char16 const * dirname)
+{
+    AutoCriticalSection autocs(&cs);
+    if (enabled)
+    {
+        // Either already enabled, or the flag driven storage is in use
+        return useSourceCache && wcscmp(sourceCacheDir, dirname) == 0;
+    }
+
+    size_t len = wcslen(dirname);
+    if (len == 0 || len + 1 >= _countof(sourceCacheDir) || wcscpy_s(sourceCacheDir, dirname) != 0)
+    {
+        return false;
+    }
+
+    if (!CreateDirectory(sourceCacheDir, NULL) && GetLastError() != ERROR_ALREADY_EXISTS)
+    {
+        return false;
+    }
+
+    useSourceCache = true;
+    collectInfo = true;
+    enabled = true;
+    return true;
+}
+
+void DynamicProfileStorage::GetSourceCacheKey(__in_bcount(length) byte const * source, size_t length, _Out_writes_z_(SourceCacheKeyLength) char16 * key)
+{
+    // 64-bit FNV-1a over the source bytes. The length is part of the key as well to make collisions
+    // between edited versions of a file less likely.
+    uint64 hash = 14695981039346656037ull;
+    for (size_t i = 0; i < length; i++)
+    {
+        hash = (hash ^ source[i]) * 1099511628211ull;
+    }
+
+    uint64 values[] = { hash, (uint64)length };
+    char16 * current = key;
+    for (uint i = 0; i < _countof(values); i++)
+    {
+        for (int shift = 60; shift >= 0; shift -= 4)
+        {
+            *current++ = _u("0123456789abcdef")[(values[i] >> shift) & 0xf];
+        }
+    }
+    *current = _u('\0');
+    Assert((size_t)(current - key) + 1 == SourceCacheKeyLength);
+}
+
+bool DynamicProfileStorage::GetSourceCacheFilename(__in_z char16 const * key, _Out_writes_z_(_MAX_PATH) char16 filename[_MAX_PATH])
+{
+    Assert(useSourceCache);
+    char16 name[_MAX_FNAME];
+    return wcscpy_s(name, _u("jsdpc_")) == 0
+        && wcscat_s(name, key) == 0
+        && _wmakepath_s(filename, _MAX_PATH, nullptr, sourceCacheDir, name, _u(".dpd")) == 0;
+}
+
+bool DynamicProfileStorage::GetSourceCacheVersion(DWORD version[4])
+{
+    // Profile records are raw profile data structures, only reuse them with the build that wrote them
+    return SUCCEEDED(AutoSystemInfo::GetJscriptFileVersion(&version[0], &version[1], &version[2], &version[3]));
+}
+
+// FNV-1a. Only detects accidental corruption (e.g. a file truncated by a crash); anyone who can write to the
+// cache directory can forge a record with a matching checksum.
+DWORD DynamicProfileStorage::GetRecordChecksum(__in_ecount(sizeof(DWORD) + *record) char const * record)
+{
+    DWORD checksum = 2166136261;
+    char const * buffer = GetRecordBuffer(record);
+    DWORD size = GetRecordSize(record);
+    for (DWORD i = 0; i < size; i++)
+    {
+        checksum = (checksum ^ (byte)buffer[i]) * 16777619;
+    }
+    return checksum;
+}
+
+// The record size comes from the file; check it against what is actually left in the file before allocating for it
+static bool IsRemainingFileSize(FILE * file, DWORD size)
+{
+    long current = ftell(file);
+    if (current < 0 || fseek(file, 0, SEEK_END) != 0)
+    {
+        return false;
+    }
+    long end = ftell(file);
+    return fseek(file, current, SEEK_SET) == 0 && end >= current && (unsigned long)(end - current) == size;
+}
+
+char const * DynamicProfileStorage::ReadSourceCacheRecord(__in_z char16 const * key)
+{
+    Assert(useSourceCache);
+    char16 cacheFilename[_MAX_PATH];
+    DWORD expectedVersion[4];
+    if (!GetSourceCacheFilename(key, cacheFilename) || !GetSourceCacheVersion(expectedVersion))
+    {
+        return nullptr;
+    }
+
+    FILE * file;
+    if (_wfopen_s(&file, cacheFilename, _u("rb")) != 0)
+    {
+        return nullptr;
+    }
+
+    // Header: magic, format version, engine version (4 DWORDs), record size, record checksum
+    DWORD header[8];
+    char * record = nullptr;
+    if (fread(header, sizeof(DWORD), _countof(header), file) == _countof(header)
+        && header[0] == MagicNumber
+        && header[1] == FileFormatVersion
+        && memcmp(&header[2], expectedVersion, sizeof(expectedVersion)) == 0
+        && header[6] <= MaxSourceCacheRecordSize
+        && IsRemainingFileSize(file, header[6]))
+    {
+        record = AllocRecord(header[6]);
+        if (record != nullptr
+            && (fread(GetRecordBuffer(record), 1, header[6], file) != header[6] || GetRecordChecksum(record) != header[7]))
+        {
+            DeleteRecord(record);
+            record = nullptr;
+        }
+    }
+    fclose(file);
+
+#if DBG_DUMP
+    if (DynamicProfileStorage::DoTrace())
+    {
+        Output::Print(_u("TRACE: DynamicProfileStorage: %s source cache file '%s'\n"), record ? _u("Loaded") : _u("Rejected"), cacheFilename);
+        Output::Flush();
+    }
+#endif
+    return record;
+}
+
+void DynamicProfileStorage::WriteSourceCacheRecord(__in_z char16 const * key, __in_ecount(sizeof(DWORD) + *record) char const * record)
+{
+    Assert(useSourceCache);
+    char16 cacheFilename[_MAX_PATH];
+    char16 tempFilename[_MAX_PATH];
+    DWORD version[4];
+    if (GetRecordSize(record) > MaxSourceCacheRecordSize
+        || !GetSourceCacheFilename(key, cacheFilename) || !GetSourceCacheVersion(version)
+        || swprintf_s(tempFilename, _countof(tempFilename), _u("%s.%u.tmp"), cacheFilename, GetCurrentProcessId()) < 0)
+    {
+        return;
+    }
+
+    // Write to a file of our own and move it in place, so that other processes using the same
+    // directory never see a partial file
+    FILE * file;
+    if (_wfopen_s(&file, tempFilename, _u("wb")) != 0)
+    {
+        return;
+    }
+
+    DWORD header[8] = { MagicNumber, FileFormatVersion, version[0], version[1], version[2], version[3], GetRecordSize(record), GetRecordChecksum(record) };
+    bool succeeded = fwrite(header, sizeof(DWORD), _countof(header), file) == _countof(header)
+        && fwrite(GetRecordBuffer(record), 1, GetRecordSize(record), file) == GetRecordSize(record);
+    succeeded = (fclose(file) == 0) && succeeded;
+
+    if (!succeeded || !MoveFileEx(tempFilename, cacheFilename, MOVEFILE_REPLACE_EXISTING))
+    {
+        _wunlink(tempFilename);
+    }
+}
 #endif
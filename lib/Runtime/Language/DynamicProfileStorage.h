@@ -23,6 +23,16 @@ public:
     static char const * GetRecordBuffer(__in_ecount(sizeof(DWORD) + *record) char const * record);
     static char * GetRecordBuffer(__in_ecount(sizeof(DWORD) + *record) char * record);
     static DWORD GetRecordSize(__in_ecount(sizeof(DWORD) + *record) char const * record);
+
+    // Source profile cache: one file per source in a directory, keyed by a hash of the source text
+    // instead of the url and tied to the engine build. Unlike the flag driven storage it is available
+    // in release builds. It needs to be enabled before any runtime is created.
+    static bool EnableSourceCache(__in_z char16 const * dirname);
+    static bool UsesSourceCache() { return useSourceCache; }
+
+    static const size_t SourceCacheKeyLength = 33;  // 16 hex digits each for the hash and the length, and the null
+    static const DWORD MaxSourceCacheRecordSize = 16 * 1024 * 1024;
+    static void GetSourceCacheKey(__in_bcount(length) byte const * source, size_t length, _Out_writes_z_(SourceCacheKeyLength) char16 * key);
 private:
     static char16 const * GetMessageType();
     static void ClearInfoMap(bool deleteFileStorage);
@@ -40,11 +50,19 @@ private:
     static bool ReleaseLock();
     static bool VerifyHeader();
 
+    static bool GetSourceCacheFilename(__in_z char16 const * key, _Out_writes_z_(_MAX_PATH) char16 filename[_MAX_PATH]);
+    static bool GetSourceCacheVersion(DWORD version[4]);
+    static DWORD GetRecordChecksum(__in_ecount(sizeof(DWORD) + *record) char const * record);
+    static char const * ReadSourceCacheRecord(__in_z char16 const * key);
+    static void WriteSourceCacheRecord(__in_z char16 const * key, __in_ecount(sizeof(DWORD) + *record) char const * record);
+
     static bool initialized;
     static bool uninitialized;
     static bool enabled;
     static bool collectInfo;
     static bool useCacheDir;
+    static bool useSourceCache;
+    static char16 sourceCacheDir[_MAX_PATH];
     static char16 cacheDrive[_MAX_DRIVE];
     static char16 cacheDir[_MAX_DIR];
     static char16 catalogFilename[_MAX_PATH];
@@ -91,6 +109,19 @@ DynamicProfileStorage::Load(char16 const * filename, Fn loadFn)
 {
     Assert(DynamicProfileStorage::IsEnabled());
     AutoCriticalSection autocs(&cs);
+    if (useSourceCache)
+    {
+        // A missing, stale or corrupted cache file just means we start without a profile
+        char const * sourceCacheRecord = ReadSourceCacheRecord(filename);
+        if (sourceCacheRecord == nullptr)
+        {
+            return nullptr;
+        }
+        Js::SourceDynamicProfileManager * sourceDynamicProfileManager = loadFn(GetRecordBuffer(sourceCacheRecord), GetRecordSize(sourceCacheRecord));
+        DeleteRecord(sourceCacheRecord);
+        return sourceDynamicProfileManager;
+    }
+
     if (useCacheDir && AcquireLock())
     {
         LoadCacheCatalog(); // refresh the cache catalog
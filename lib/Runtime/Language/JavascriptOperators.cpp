@@ -4711,6 +4711,242 @@ CommonNumber:
         return returnValue;
     }
 
+    // Resolves an operand of OP_Memvector, either a typed array of the destination's type covering [start, start + length)
+    // or a number. An array overlapping the destination at a different offset is rejected: the loop would read the
+    // elements it already wrote, which depends on its direction.
+    static bool GetMemvectorOperand(Var instance, TypedArrayBase* dstArray, TypeId arrayTypeId, uint32 start, uint32 length, const byte** elements, double* value)
+    {
+        TypeId typeId = JavascriptOperators::GetTypeId(instance);
+        if (typeId == TypeIds_Integer || typeId == TypeIds_Number)
+        {
+            *elements = nullptr;
+            *value = TaggedInt::Is(instance) ? TaggedInt::ToDouble(instance) : JavascriptNumber::GetValue(instance);
+            return true;
+        }
+
+        if (typeId != arrayTypeId)
+        {
+            return false;
+        }
+
+        TypedArrayBase* array = TypedArrayBase::FromVar(instance);
+        if (array->IsCrossSiteObject() || array->IsDetachedBuffer() || start + length > array->GetLength())
+        {
+            return false;
+        }
+
+        const uint32 elementSize = array->GetBytesPerElement();
+        const byte* first = array->GetByteBuffer() + (size_t)start * elementSize;
+        const byte* dstFirst = dstArray->GetByteBuffer() + (size_t)start * elementSize;
+        const size_t byteLength = (size_t)length * elementSize;
+        if (first != dstFirst && first < dstFirst + byteLength && dstFirst < first + byteLength)
+        {
+            return false;
+        }
+
+        *elements = first;
+        *value = 0;
+        return true;
+    }
+
+    template <typename T>
+    static T MemvectorOp(Js::OpCode opcode, T left, T right)
+    {
+        switch (opcode)
+        {
+        case Js::OpCode::Add_A:
+            return left + right;
+        case Js::OpCode::Sub_A:
+            return left - right;
+        case Js::OpCode::Mul_A:
+            return left * right;
+        default:
+            Assert(opcode == Js::OpCode::Div_A);
+            return left / right;
+        }
+    }
+
+#if _M_IX86 || _M_AMD64
+#if defined(__clang__) || defined(__GNUC__)
+#define MEMVECTOR_AVX2 __attribute__((target("avx2")))
+#else
+#define MEMVECTOR_AVX2
+#endif
+
+    // Eight elements at a time, returns how many elements are done. Only called if the CPU has AVX2.
+    MEMVECTOR_AVX2
+    static uint32 MemvectorFloat32Avx2(Js::OpCode opcode, float* dst, const float* left, const float* right, float leftValue, float rightValue, uint32 length)
+    {
+        const __m256 leftSplat = _mm256_set1_ps(leftValue);
+        const __m256 rightSplat = _mm256_set1_ps(rightValue);
+        uint32 i = 0;
+        for (; i + 8 <= length; i += 8)
+        {
+            __m256 x = left ? _mm256_loadu_ps(left + i) : leftSplat;
+            __m256 y = right ? _mm256_loadu_ps(right + i) : rightSplat;
+            switch (opcode)
+            {
+            case Js::OpCode::Add_A:
+                x = _mm256_add_ps(x, y);
+                break;
+            case Js::OpCode::Sub_A:
+                x = _mm256_sub_ps(x, y);
+                break;
+            case Js::OpCode::Mul_A:
+                x = _mm256_mul_ps(x, y);
+                break;
+            default:
+                x = _mm256_div_ps(x, y);
+                break;
+            }
+            _mm256_storeu_ps(dst + i, x);
+        }
+        // The SSE code that follows runs slowly while the upper halves of the ymm registers are dirty
+        _mm256_zeroupper();
+        return i;
+    }
+
+    MEMVECTOR_AVX2
+    static uint32 MemvectorInt32Avx2(Js::OpCode opcode, int32* dst, const int32* left, const int32* right, int32 leftValue, int32 rightValue, uint32 length)
+    {
+        const __m256i leftSplat = _mm256_set1_epi32(leftValue);
+        const __m256i rightSplat = _mm256_set1_epi32(rightValue);
+        uint32 i = 0;
+        for (; i + 8 <= length; i += 8)
+        {
+            __m256i x = left ? _mm256_loadu_si256((const __m256i*)(left + i)) : leftSplat;
+            __m256i y = right ? _mm256_loadu_si256((const __m256i*)(right + i)) : rightSplat;
+            x = opcode == Js::OpCode::Add_A ? _mm256_add_epi32(x, y) : _mm256_sub_epi32(x, y);
+            _mm256_storeu_si256((__m256i*)(dst + i), x);
+        }
+        _mm256_zeroupper();
+        return i;
+    }
+
+#undef MEMVECTOR_AVX2
+#endif
+
+    static void MemvectorFloat32(Js::OpCode opcode, float* dst, const float* left, const float* right, double leftValue, double rightValue, uint32 length)
+    {
+        uint32 i = 0;
+#if _M_IX86 || _M_AMD64
+        // Four (or eight, with AVX2) elements at a time. Rounding the double result JavaScript computes gives the single
+        // precision result, as long as a number operand is exact in single precision.
+        if ((left || (double)(float)leftValue == leftValue) && (right || (double)(float)rightValue == rightValue))
+        {
+            if (AutoSystemInfo::Data.AVX2Available())
+            {
+                i = MemvectorFloat32Avx2(opcode, dst, left, right, (float)leftValue, (float)rightValue, length);
+            }
+
+            const __m128 leftSplat = _mm_set1_ps((float)leftValue);
+            const __m128 rightSplat = _mm_set1_ps((float)rightValue);
+            for (; i + 4 <= length; i += 4)
+            {
+                __m128 x = left ? _mm_loadu_ps(left + i) : leftSplat;
+                __m128 y = right ? _mm_loadu_ps(right + i) : rightSplat;
+                switch (opcode)
+                {
+                case Js::OpCode::Add_A:
+                    x = _mm_add_ps(x, y);
+                    break;
+                case Js::OpCode::Sub_A:
+                    x = _mm_sub_ps(x, y);
+                    break;
+                case Js::OpCode::Mul_A:
+                    x = _mm_mul_ps(x, y);
+                    break;
+                default:
+                    x = _mm_div_ps(x, y);
+                    break;
+                }
+                _mm_storeu_ps(dst + i, x);
+            }
+        }
+#endif
+        for (; i < length; i++)
+        {
+            dst[i] = (float)MemvectorOp<double>(opcode, left ? left[i] : leftValue, right ? right[i] : rightValue);
+        }
+    }
+
+    static void MemvectorInt32(Js::OpCode opcode, int32* dst, const int32* left, const int32* right, int32 leftValue, int32 rightValue, uint32 length)
+    {
+        Assert(opcode == Js::OpCode::Add_A || opcode == Js::OpCode::Sub_A);
+        uint32 i = 0;
+#if _M_IX86 || _M_AMD64
+        if (AutoSystemInfo::Data.AVX2Available())
+        {
+            i = MemvectorInt32Avx2(opcode, dst, left, right, leftValue, rightValue, length);
+        }
+
+        const __m128i leftSplat = _mm_set1_epi32(leftValue);
+        const __m128i rightSplat = _mm_set1_epi32(rightValue);
+        for (; i + 4 <= length; i += 4)
+        {
+            __m128i x = left ? _mm_loadu_si128((const __m128i*)(left + i)) : leftSplat;
+            __m128i y = right ? _mm_loadu_si128((const __m128i*)(right + i)) : rightSplat;
+            x = opcode == Js::OpCode::Add_A ? _mm_add_epi32(x, y) : _mm_sub_epi32(x, y);
+            _mm_storeu_si128((__m128i*)(dst + i), x);
+        }
+#endif
+        // Wraps around like the ToInt32 of the store
+        for (; i < length; i++)
+        {
+            dst[i] = (int32)MemvectorOp<uint32>(opcode, (uint32)(left ? left[i] : leftValue), (uint32)(right ? right[i] : rightValue));
+        }
+    }
+
+    BOOL JavascriptOperators::OP_Memvector(Var dstInstance, int32 start, Var src1, Var src2, int32 length, int32 opcode, ScriptContext* scriptContext)
+    {
+        if (length <= 0 || start < 0)
+        {
+            return false;
+        }
+
+        TypeId instanceType = JavascriptOperators::GetTypeId(dstInstance);
+        if (instanceType != TypeIds_Float32Array && instanceType != TypeIds_Int32Array)
+        {
+            AssertMsg(false, "We don't support this type for memvector yet.");
+            return false;
+        }
+
+        // Everything is checked before the first store: the bailout runs the whole loop again in the interpreter
+        TypedArrayBase* dstArray = TypedArrayBase::FromVar(dstInstance);
+        if (dstArray->IsCrossSiteObject() || dstArray->IsDetachedBuffer() || (uint32)start + (uint32)length > dstArray->GetLength())
+        {
+            return false;
+        }
+
+        const byte* leftElements;
+        const byte* rightElements;
+        double leftValue;
+        double rightValue;
+        if (!GetMemvectorOperand(src1, dstArray, instanceType, start, length, &leftElements, &leftValue) ||
+            !GetMemvectorOperand(src2, dstArray, instanceType, start, length, &rightElements, &rightValue))
+        {
+            return false;
+        }
+
+        byte* dstElements = dstArray->GetByteBuffer() + (size_t)start * dstArray->GetBytesPerElement();
+        if (instanceType == TypeIds_Float32Array)
+        {
+            MemvectorFloat32((Js::OpCode)opcode, (float*)dstElements, (const float*)leftElements, (const float*)rightElements, leftValue, rightValue, length);
+        }
+        else
+        {
+            // The backend only passes int32 numbers with Int32Array
+            int32 leftInt = (int32)leftValue;
+            int32 rightInt = (int32)rightValue;
+            if ((!leftElements && leftInt != leftValue) || (!rightElements && rightInt != rightValue))
+            {
+                return false;
+            }
+            MemvectorInt32((Js::OpCode)opcode, (int32*)dstElements, (const int32*)leftElements, (const int32*)rightElements, leftInt, rightInt, length);
+        }
+        return true;
+    }
+
     BOOL JavascriptOperators::OP_Memset(Var instance, int32 start, Var value, int32 length, ScriptContext* scriptContext)
     {
         if (length <= 0)
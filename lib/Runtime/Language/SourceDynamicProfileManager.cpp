@@ -305,9 +305,10 @@ namespace Js
         Recycler* recycler = scriptContext->GetRecycler();
 
 #ifdef DYNAMIC_PROFILE_STORAGE
-        if(DynamicProfileStorage::IsEnabled() && info->url != nullptr)
+        char16 const * storageKey = DynamicProfileStorage::IsEnabled() ? info->GetDynamicProfileStorageKey() : nullptr;
+        if(storageKey != nullptr)
         {
-            manager = DynamicProfileStorage::Load(info->url, [recycler](char const * buffer, uint length) -> SourceDynamicProfileManager *
+            manager = DynamicProfileStorage::Load(storageKey, [recycler](char const * buffer, uint length) -> SourceDynamicProfileManager *
             {
                 BufferReader reader(buffer, length);
                 return SourceDynamicProfileManager::Deserialize(&reader, recycler);
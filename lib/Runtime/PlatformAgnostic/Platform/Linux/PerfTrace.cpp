@@ -0,0 +1,257 @@
+//-------------------------------------------------------------------------------------------------------
+// Copyright (C) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE.txt file in the project root for full license information.
+//-------------------------------------------------------------------------------------------------------
+
+#include "Common.h"
+#include "ChakraPlatform.h"
+
+#ifdef PERF_JIT_PROFILING
+#include <elf.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <time.h>
+#include <unistd.h>
+
+namespace PlatformAgnostic
+{
+    // See tools/perf/Documentation/jitdump-specification.txt in the Linux sources
+    static const uint32 JitDumpMagic = 0x4A695444;
+    static const uint32 JitDumpVersion = 1;
+    static const uint32 JitCodeLoad = 0;
+    static const uint32 JitCodeClose = 3;
+
+    struct JitDumpFileHeader
+    {
+        uint32 magic;
+        uint32 version;
+        uint32 totalSize;
+        uint32 elfMachine;
+        uint32 pad1;
+        uint32 pid;
+        uint64 timestamp;
+        uint64 flags;
+    };
+
+    struct JitDumpRecordHeader
+    {
+        uint32 id;
+        uint32 totalSize;
+        uint64 timestamp;
+    };
+
+    struct JitDumpCodeLoadRecord
+    {
+        JitDumpRecordHeader header;
+        uint32 pid;
+        uint32 tid;
+        uint64 vma;
+        uint64 codeAddress;
+        uint64 codeSize;
+        uint64 codeIndex;
+        // Followed by the null terminated name and the code bytes
+    };
+
+    static CriticalSection perfTraceLock;
+    static int perfMapFile = -1;
+    static int jitDumpFile = -1;
+    static void * jitDumpMarker = nullptr;
+    static size_t jitDumpMarkerSize = 0;
+    static uint64 jitDumpCodeIndex = 0;
+    static bool perfMapFailed = false;
+    static bool jitDumpFailed = false;
+
+    static bool WriteAll(int file, const void * buffer, size_t size)
+    {
+        const char * current = (const char *)buffer;
+        while (size != 0)
+        {
+            ssize_t written = write(file, current, size);
+            if (written <= 0)
+            {
+                if (written == -1 && errno == EINTR)
+                {
+                    continue;
+                }
+                return false;
+            }
+            current += written;
+            size -= (size_t)written;
+        }
+        return true;
+    }
+
+    // perf expects the jitdump timestamps from the same clock as the samples, "perf record -k mono"
+    static uint64 GetTimestamp()
+    {
+        struct timespec time;
+        if (clock_gettime(CLOCK_MONOTONIC, &time) != 0)
+        {
+            return 0;
+        }
+        return (uint64)time.tv_sec * 1000000000ull + (uint64)time.tv_nsec;
+    }
+
+    static uint32 GetElfMachine()
+    {
+#if defined(_M_X64)
+        return EM_X86_64;
+#elif defined(_M_IX86)
+        return EM_386;
+#elif defined(_M_ARM64)
+        return EM_AARCH64;
+#elif defined(_M_ARM)
+        return EM_ARM;
+#else
+        return EM_NONE;
+#endif
+    }
+
+    static bool EnsurePerfMap()
+    {
+        if (perfMapFile != -1 || perfMapFailed)
+        {
+            return perfMapFile != -1;
+        }
+
+        char path[64];
+        if (sprintf_s(path, sizeof(path), "/tmp/perf-%d.map", (int)getpid()) <= 0 ||
+            (perfMapFile = open(path, O_CREAT | O_TRUNC | O_WRONLY | O_CLOEXEC, 0644)) == -1)
+        {
+            perfMapFailed = true;
+            return false;
+        }
+        return true;
+    }
+
+    static bool EnsureJitDump()
+    {
+        if (jitDumpFile != -1 || jitDumpFailed)
+        {
+            return jitDumpFile != -1;
+        }
+
+        jitDumpFailed = true;
+
+        char path[64];
+        if (sprintf_s(path, sizeof(path), "/tmp/jit-%d.dump", (int)getpid()) <= 0)
+        {
+            return false;
+        }
+
+        int file = open(path, O_CREAT | O_TRUNC | O_RDWR | O_CLOEXEC, 0644);
+        if (file == -1)
+        {
+            return false;
+        }
+
+        // perf finds the file through the mmap event of this mapping, it has to be executable to be recorded
+        size_t markerSize = (size_t)sysconf(_SC_PAGESIZE);
+        void * marker = mmap(nullptr, markerSize, PROT_READ | PROT_EXEC, MAP_PRIVATE, file, 0);
+        if (marker == MAP_FAILED)
+        {
+            close(file);
+            return false;
+        }
+
+        JitDumpFileHeader header;
+        header.magic = JitDumpMagic;
+        header.version = JitDumpVersion;
+        header.totalSize = sizeof(header);
+        header.elfMachine = GetElfMachine();
+        header.pad1 = 0;
+        header.pid = (uint32)getpid();
+        header.timestamp = GetTimestamp();
+        header.flags = 0;
+        if (!WriteAll(file, &header, sizeof(header)))
+        {
+            munmap(marker, markerSize);
+            close(file);
+            return false;
+        }
+
+        jitDumpFile = file;
+        jitDumpMarker = marker;
+        jitDumpMarkerSize = markerSize;
+        jitDumpFailed = false;
+        return true;
+    }
+
+    void PerfTrace::LogCodeLoadEvent(bool perfMap, bool jitDump, const void * codeAddress, size_t codeSize, const char * utf8Name)
+    {
+        AutoCriticalSection autoLock(&perfTraceLock);
+
+        if (perfMap && EnsurePerfMap())
+        {
+            char address[48];
+            int addressLength = sprintf_s(address, sizeof(address), "%llx %llx ",
+                (unsigned long long)(uintptr_t)codeAddress, (unsigned long long)codeSize);
+
+            // Write each line with a single call, so that the map stays readable if the process dies
+            size_t nameLength = strlen(utf8Name);
+            size_t lineLength = (size_t)addressLength + nameLength + 1;
+            char * line = addressLength > 0 ? HeapNewNoThrowArray(char, lineLength) : nullptr;
+            if (line != nullptr)
+            {
+                memcpy(line, address, addressLength);
+                memcpy(line + addressLength, utf8Name, nameLength);
+                line[lineLength - 1] = '\n';
+                WriteAll(perfMapFile, line, lineLength);
+                HeapDeleteArray(lineLength, line);
+            }
+        }
+
+        if (jitDump && EnsureJitDump())
+        {
+            size_t nameSize = strlen(utf8Name) + 1;
+            JitDumpCodeLoadRecord record;
+            record.header.id = JitCodeLoad;
+            record.header.totalSize = (uint32)(sizeof(record) + nameSize + codeSize);
+            record.header.timestamp = GetTimestamp();
+            record.pid = (uint32)getpid();
+            record.tid = (uint32)syscall(SYS_gettid);
+            record.vma = (uint64)(uintptr_t)codeAddress;
+            record.codeAddress = (uint64)(uintptr_t)codeAddress;
+            record.codeSize = codeSize;
+            record.codeIndex = jitDumpCodeIndex++;
+
+            if (!WriteAll(jitDumpFile, &record, sizeof(record)) ||
+                !WriteAll(jitDumpFile, utf8Name, nameSize) ||
+                !WriteAll(jitDumpFile, codeAddress, codeSize))
+            {
+                // A partial record would corrupt the rest of the file, stop writing to it
+                munmap(jitDumpMarker, jitDumpMarkerSize);
+                close(jitDumpFile);
+                jitDumpFile = -1;
+                jitDumpFailed = true;
+            }
+        }
+    }
+
+    void PerfTrace::UnRegister()
+    {
+        AutoCriticalSection autoLock(&perfTraceLock);
+
+        if (perfMapFile != -1)
+        {
+            close(perfMapFile);
+            perfMapFile = -1;
+        }
+
+        if (jitDumpFile != -1)
+        {
+            JitDumpRecordHeader record;
+            record.id = JitCodeClose;
+            record.totalSize = sizeof(record);
+            record.timestamp = GetTimestamp();
+            WriteAll(jitDumpFile, &record, sizeof(record));
+
+            munmap(jitDumpMarker, jitDumpMarkerSize);
+            close(jitDumpFile);
+            jitDumpFile = -1;
+        }
+    }
+} // namespace PlatformAgnostic
+#endif
@@ -6,6 +6,8 @@
 #include "Common.h"
 #include "ChakraPlatform.h"
 #include <sys/sysinfo.h>
+#include <fcntl.h>
+#include <unistd.h>
 
 namespace PlatformAgnostic
 {
@@ -23,4 +25,196 @@ namespace PlatformAgnostic
             totalRam = systemInfo.totalram;
         }
     }
+
+    // Control group files are small, single read is enough. Returns the number of characters read.
+    static size_t ReadControlFile(const char *path, char *buffer, size_t bufferSize)
+    {
+        int fd = open(path, O_RDONLY);
+        if (fd == -1)
+        {
+            return 0;
+        }
+
+        ssize_t length = read(fd, buffer, bufferSize - 1);
+        close(fd);
+        if (length <= 0)
+        {
+            return 0;
+        }
+
+        buffer[length] = '\0';
+        return (size_t)length;
+    }
+
+    static bool ParseUnsigned(const char *text, size_t *value)
+    {
+        if (*text < '0' || *text > '9')
+        {
+            return false;
+        }
+
+        size_t result = 0;
+        for (; *text >= '0' && *text <= '9'; text++)
+        {
+            size_t digit = *text - '0';
+            if (result > (SIZE_MAX - digit) / 10)
+            {
+                // Overflow, cgroup v1 reports "no limit" as a value near the maximum anyway
+                result = SIZE_MAX;
+                break;
+            }
+            result = result * 10 + digit;
+        }
+
+        *value = result;
+        return true;
+    }
+
+    // Finds the path of the process's control group from /proc/self/cgroup, relative to the
+    // hierarchy's mount point. For cgroup v2 the line is "0::<path>", for cgroup v1 it is
+    // "<id>:<controllers>:<path>" with "memory" among the controllers.
+    static bool GetControlGroupPath(bool isV2, char *path, size_t pathSize)
+    {
+        char buffer[4096];
+        if (ReadControlFile("/proc/self/cgroup", buffer, sizeof(buffer)) == 0)
+        {
+            return false;
+        }
+
+        for (char *line = buffer; *line != '\0';)
+        {
+            char *lineEnd = line;
+            while (*lineEnd != '\0' && *lineEnd != '\n')
+            {
+                lineEnd++;
+            }
+            char *nextLine = (*lineEnd == '\0') ? lineEnd : lineEnd + 1;
+            *lineEnd = '\0';
+
+            char *controllers = strchr(line, ':');
+            char *groupPath = controllers ? strchr(controllers + 1, ':') : nullptr;
+            if (groupPath != nullptr)
+            {
+                *groupPath++ = '\0';
+                controllers++;
+
+                bool found;
+                if (isV2)
+                {
+                    found = (strcmp(line, "0") == 0 && *controllers == '\0');
+                }
+                else
+                {
+                    found = false;
+                    for (char *controller = controllers; controller != nullptr && !found;)
+                    {
+                        char *comma = strchr(controller, ',');
+                        size_t controllerLength = comma ? (size_t)(comma - controller) : strlen(controller);
+                        found = (controllerLength == 6 && strncmp(controller, "memory", 6) == 0);
+                        controller = comma ? comma + 1 : nullptr;
+                    }
+                }
+
+                if (found)
+                {
+                    if (strlen(groupPath) >= pathSize)
+                    {
+                        return false;
+                    }
+                    strcpy_s(path, pathSize, groupPath);
+                    return true;
+                }
+            }
+
+            line = nextLine;
+        }
+
+        return false;
+    }
+
+    // Reads a file of the process's memory control group. Falls back to the root of the hierarchy,
+    // which is what a container with its own cgroup namespace sees as its group.
+    static size_t ReadMemoryControlFile(bool isV2, const char *fileName, char *buffer, size_t bufferSize)
+    {
+        const char *mountPoint = isV2 ? "/sys/fs/cgroup" : "/sys/fs/cgroup/memory";
+        char groupPath[1024];
+        char path[1024 + 128];
+
+        if (GetControlGroupPath(isV2, groupPath, sizeof(groupPath)) &&
+            sprintf_s(path, sizeof(path), "%s%s/%s", mountPoint, groupPath, fileName) > 0)
+        {
+            size_t length = ReadControlFile(path, buffer, bufferSize);
+            if (length != 0)
+            {
+                return length;
+            }
+        }
+
+        if (sprintf_s(path, sizeof(path), "%s/%s", mountPoint, fileName) <= 0)
+        {
+            return 0;
+        }
+        return ReadControlFile(path, buffer, bufferSize);
+    }
+
+    static bool GetControlGroupMemoryLimit(size_t *memoryLimit)
+    {
+        char buffer[64];
+
+        // cgroup v2 reports "max" when there is no limit
+        if (ReadMemoryControlFile(true, "memory.max", buffer, sizeof(buffer)) != 0)
+        {
+            return ParseUnsigned(buffer, memoryLimit);
+        }
+
+        // cgroup v1 reports a page-rounded LLONG_MAX when there is no limit, which the caller
+        // ignores for being above the physical memory
+        if (ReadMemoryControlFile(false, "memory.limit_in_bytes", buffer, sizeof(buffer)) != 0)
+        {
+            return ParseUnsigned(buffer, memoryLimit);
+        }
+
+        return false;
+    }
+
+    bool SystemInfo::GetMemoryLimit(size_t *memoryLimit)
+    {
+        struct sysinfo systemInfo;
+        if (sysinfo(&systemInfo) == -1 || systemInfo.totalram == 0)
+        {
+            return false;
+        }
+
+        size_t limit = (size_t)systemInfo.totalram * systemInfo.mem_unit;
+        size_t controlGroupLimit;
+        if (GetControlGroupMemoryLimit(&controlGroupLimit) && controlGroupLimit != 0 && controlGroupLimit < limit)
+        {
+            limit = controlGroupLimit;
+        }
+
+        *memoryLimit = limit;
+        return true;
+    }
+
+    bool SystemInfo::GetMemoryPressure(uint *memoryPressure)
+    {
+        // Pressure stall information: "some avg10=1.23 avg60=0.45 avg300=0.06 total=12345".
+        // Prefer the process's cgroup v2 group, then the system-wide numbers.
+        char buffer[256];
+        if (ReadMemoryControlFile(true, "memory.pressure", buffer, sizeof(buffer)) == 0 &&
+            ReadControlFile("/proc/pressure/memory", buffer, sizeof(buffer)) == 0)
+        {
+            return false;
+        }
+
+        const char *average = strstr(buffer, "some avg10=");
+        size_t percent;
+        if (average == nullptr || !ParseUnsigned(average + sizeof("some avg10=") - 1, &percent))
+        {
+            return false;
+        }
+
+        *memoryPressure = (uint)min(percent, (size_t)100);
+        return true;
+    }
 }
@@ -22,4 +22,17 @@ namespace PlatformAgnostic
             totalRam = 0;
         }
     }
+
+    bool SystemInfo::GetMemoryLimit(size_t *memoryLimit)
+    {
+        int totalRamHW [] = { CTL_HW, HW_MEMSIZE };
+
+        size_t length = sizeof(size_t);
+        return sysctl(totalRamHW, 2, memoryLimit, &length, NULL, 0) != -1 && *memoryLimit != 0;
+    }
+
+    bool SystemInfo::GetMemoryPressure(uint *memoryPressure)
+    {
+        return false;
+    }
 }
@@ -19,4 +19,21 @@ namespace PlatformAgnostic
             totalRam = static_cast<size_t>(ram) * 1024;
         }
     }
+
+    bool SystemInfo::GetMemoryLimit(size_t *memoryLimit)
+    {
+        ULONGLONG ram;
+        if (GetPhysicallyInstalledSystemMemory(&ram) != TRUE)
+        {
+            return false;
+        }
+
+        *memoryLimit = static_cast<size_t>(ram) * 1024;
+        return true;
+    }
+
+    bool SystemInfo::GetMemoryPressure(uint *memoryPressure)
+    {
+        return false;
+    }
 }
@@ -32,6 +32,7 @@ Abstract:
 #include "pal/init.h"
 #include "pal/process.h"
 #include "pal/debug.h"
+#include "pal/virtual.h"
 
 #include <signal.h>
 #include <errno.h>
@@ -267,6 +268,13 @@ Parameters :
 --*/
 static void sigsegv_handler(int code, siginfo_t *siginfo, void *context)
 {
+    // First write to a clean page of a write watch region; the page has been
+    // made writable again, so just restart the faulting instruction.
+    if (siginfo->si_code == SEGV_ACCERR && VIRTUALHandleWriteWatchFault(siginfo->si_addr))
+    {
+        return;
+    }
+
     if (PALIsInitialized())
     {
         EXCEPTION_RECORD record;
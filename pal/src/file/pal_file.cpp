@@ -30,6 +30,7 @@ Abstract:
 #include "pal/file.h"
 #include "pal/filetime.h"
 #include "pal/utils.h"
+#include "pal/virtual.h"
 
 #include <time.h>
 #include <stdio.h>
@@ -2260,6 +2261,7 @@ CorUnix::InternalReadFile(
     
     LONG readOffsetStartLow = 0, readOffsetStartHigh = 0;
     int res;
+    BOOL fRetriedWriteWatch = FALSE;
 
     if (NULL != lpNumberOfBytesRead)
     {
@@ -2393,6 +2395,14 @@ Read:
         // Try to read again.
         goto Read;
     }
+    else if (errno == EFAULT && !fRetriedWriteWatch &&
+             VIRTUALUnprotectWriteWatchRange(lpBuffer, nNumberOfBytesToRead))
+    {
+        // The buffer had write protected pages of a write watch region;
+        // they are writable (and reported as written) now.
+        fRetriedWriteWatch = TRUE;
+        goto Read;
+    }
     else
     {
         palError = FILEGetLastErrorFromErrno();
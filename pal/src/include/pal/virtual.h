@@ -102,6 +102,34 @@ Function :
 --*/
 BOOL VIRTUALOwnedRegion( IN UINT_PTR address );
 
+/*++
+Function :
+    VIRTUALHandleWriteWatchFault
+
+    Called by the SIGSEGV handler for write faults. If the faulting page is a
+    clean page of a MEM_WRITE_WATCH region, records the write and makes the
+    page writable again.
+
+Return value:
+    TRUE  if the faulting instruction can simply be restarted
+    FALSE if the fault is not related to write watch
+--*/
+BOOL VIRTUALHandleWriteWatchFault( IN LPVOID address );
+
+/*++
+Function :
+    VIRTUALUnprotectWriteWatchRange
+
+    System calls fail with EFAULT instead of faulting when they write into a
+    clean page of a MEM_WRITE_WATCH region. Makes the watched pages of the
+    buffer writable and marks them dirty, so that the call can be retried.
+
+Return value:
+    TRUE  if any page of the buffer was made writable
+    FALSE otherwise
+--*/
+BOOL VIRTUALUnprotectWriteWatchRange( IN LPVOID address, IN SIZE_T size );
+
 
 #ifdef __cplusplus
 }
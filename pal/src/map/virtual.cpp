@@ -32,10 +32,12 @@ Abstract:
 
 #include <sys/types.h>
 #include <sys/mman.h>
+#include <fcntl.h>
 #include <errno.h>
 #include <string.h>
 #include <unistd.h>
 #include <limits.h>
+#include <sched.h>
 
 #if HAVE_VM_ALLOCATE
 #include <mach/vm_map.h>
@@ -48,6 +50,13 @@ SET_DEFAULT_DEBUG_CHANNEL(VIRTUAL);
 
 CRITICAL_SECTION virtual_critsec PAL_GLOBAL;
 
+// MEM_LARGE_PAGES regions are backed with transparent huge pages where the
+// kernel offers them. Elsewhere the flag is accepted and ignored.
+#if defined(MADV_HUGEPAGE) && !MMAP_IGNORES_HINT && !HAVE_VM_ALLOCATE
+#define VIRTUAL_HUGE_PAGES 1
+static const SIZE_T VIRTUAL_HUGE_PAGE_SIZE = 0x200000;
+#endif
+
 #if MMAP_IGNORES_HINT
 typedef struct FREE_BLOCK {
     char *startBoundary;
@@ -105,6 +114,14 @@ static LPVOID ReserveVirtualMemory(
                 IN LPVOID lpAddress,        /* Region to reserve or commit */
                 IN SIZE_T dwSize);          /* Size of Region */
 
+static void VIRTUALInitializeWriteWatchBudget();
+
+#if VIRTUAL_HUGE_PAGES
+static LPVOID VIRTUALReserveHugePageAlignedMemory(
+                IN CPalThread *pthrCurrent, /* Currently executing thread */
+                IN SIZE_T dwSize);          /* Size of Region */
+#endif // VIRTUAL_HUGE_PAGES
+
 
 // A memory allocator that allocates memory from a pre-reserved region
 // of virtual memory that is located near the coreclr library.
@@ -131,6 +148,8 @@ VIRTUALInitialize(bool initializeExecutableMemoryAllocator)
 
     pVirtualMemory = NULL;
 
+    VIRTUALInitializeWriteWatchBudget();
+
     if (initializeExecutableMemoryAllocator)
     {
         g_executableMemoryAllocator.Initialize();
@@ -526,6 +545,548 @@ static BOOL VIRTUALSetDirtyPages( UINT nStatus, SIZE_T nStartingBit,
 }
 #endif // MMAP_DOESNOT_ALLOW_REMAP
 
+/*
+ * Software write watch
+ *
+ * MEM_WRITE_WATCH regions are emulated by write protecting the clean pages
+ * of the region and catching the first write to each of them in the SIGSEGV
+ * handler. The state of every watched page is kept in a lazily populated,
+ * two level map indexed by address, so that the signal handler can find it
+ * without taking any lock. Transitions between the states are done with
+ * interlocked operations; the fault handler and ResetWriteWatch each own a
+ * transient state while they change the protection of a page.
+ */
+enum WRITE_WATCH_STATE
+{
+    WRITE_WATCH_UNTRACKED = 0,      /* Not watched, not committed or not read-write. */
+    WRITE_WATCH_CLEAN,              /* Write protected, not written since the last reset. */
+    WRITE_WATCH_DIRTY,              /* Written to (or committed) since the last reset. */
+    WRITE_WATCH_RESETTING,          /* Being write protected by a reset. */
+    WRITE_WATCH_UNPROTECTING        /* Being made writable by the fault handler. */
+};
+
+/* Every chunk of the state map covers 4GB of address space, one byte per page. */
+#define WRITE_WATCH_CHUNK_SHIFT 32
+static const SIZE_T WRITE_WATCH_CHUNK_SIZE = ((UINT64)1 << WRITE_WATCH_CHUNK_SHIFT) / VIRTUAL_PAGE_SIZE;
+#ifdef BIT64
+static const SIZE_T WRITE_WATCH_CHUNK_COUNT = (SIZE_T)1 << (47 - WRITE_WATCH_CHUNK_SHIFT);
+#else
+static const SIZE_T WRITE_WATCH_CHUNK_COUNT = 1;
+#endif
+
+static BYTE * volatile g_writeWatchChunks[WRITE_WATCH_CHUNK_COUNT] PAL_GLOBAL;
+
+/*
+ * Every run of read-only pages inside a read-write mapping is a separate
+ * VMA, and the kernel caps their number at vm.max_map_count. Resets protect
+ * whole runs of watched pages with one mprotect, so a reset region is a
+ * single VMA again. The fault handler makes an aligned group of clean pages
+ * writable at a time, and the group grows with the size of the watched
+ * address space so that faults add at most a quarter of the map count.
+ * Past WRITE_WATCH_MAX_GRANULARITY, or if mprotect still runs out of
+ * mappings, the whole run of watched pages around the fault is made
+ * writable and reported dirty.
+ */
+#define WRITE_WATCH_DEFAULT_MAX_MAP_COUNT 65530
+static const SIZE_T WRITE_WATCH_MAX_GRANULARITY = 512;
+static SIZE_T g_writeWatchMapBudget PAL_GLOBAL = WRITE_WATCH_DEFAULT_MAX_MAP_COUNT / 4;
+static volatile SIZE_T g_writeWatchReservedPages PAL_GLOBAL;
+
+/****
+ *
+ * VIRTUALGetWriteWatchState
+ *
+ *  IN UINT_PTR address - An address in the page to look up.
+ *  IN BOOL allocate - Populate the state map chunk if it doesn't exist yet.
+ *                     The caller must own virtual_critsec in that case.
+ *
+ *  Returns a pointer to the write watch state of the page, NULL if the
+ *  page has never been part of a write watch region.
+ *
+ */
+static BYTE * VIRTUALGetWriteWatchState( UINT_PTR address, BOOL allocate )
+{
+    UINT64 chunkIndex = (UINT64)address >> WRITE_WATCH_CHUNK_SHIFT;
+    if ( chunkIndex >= WRITE_WATCH_CHUNK_COUNT )
+    {
+        return NULL;
+    }
+
+    BYTE * chunk = g_writeWatchChunks[chunkIndex];
+    if ( chunk == NULL )
+    {
+        if ( !allocate )
+        {
+            return NULL;
+        }
+
+        /* Untouched pages of the chunk read as WRITE_WATCH_UNTRACKED. */
+        void * pChunk = mmap( NULL, WRITE_WATCH_CHUNK_SIZE, PROT_READ | PROT_WRITE,
+                              MAP_ANON | MAP_PRIVATE, -1, 0 );
+        if ( pChunk == MAP_FAILED )
+        {
+            ERROR( "Unable to allocate the write watch state map.\n" );
+            return NULL;
+        }
+
+        chunk = (BYTE *)pChunk;
+        __sync_synchronize();
+        g_writeWatchChunks[chunkIndex] = chunk;
+    }
+
+    return chunk + (SIZE_T)(((UINT64)address & ((UINT64)-1 >> (64 - WRITE_WATCH_CHUNK_SHIFT))) / VIRTUAL_PAGE_SIZE);
+}
+
+/****
+ *
+ * VIRTUALIsWriteWatchRegion
+ *
+ *  Returns TRUE if the region was reserved with MEM_WRITE_WATCH.
+ *
+ */
+static BOOL VIRTUALIsWriteWatchRegion( CONST PCMI pInformation )
+{
+    return pInformation != NULL && ( pInformation->allocationType & MEM_WRITE_WATCH ) != 0;
+}
+
+#if VIRTUAL_HUGE_PAGES
+/****
+ *
+ * VIRTUALIsHugePageRegion
+ *
+ *  Returns TRUE if the region was reserved with MEM_LARGE_PAGES.
+ *
+ */
+static BOOL VIRTUALIsHugePageRegion( CONST PCMI pInformation )
+{
+    return pInformation != NULL && ( pInformation->allocationType & MEM_LARGE_PAGES ) != 0;
+}
+#endif // VIRTUAL_HUGE_PAGES
+
+/****
+ *
+ * VIRTUALInitializeWriteWatchState
+ *
+ *  Populates the state map for a newly reserved write watch region.
+ *  NOTE: The caller must own the critical section.
+ *
+ */
+static BOOL VIRTUALInitializeWriteWatchState( UINT_PTR startBoundary, SIZE_T memSize )
+{
+    UINT64 firstChunk = (UINT64)startBoundary >> WRITE_WATCH_CHUNK_SHIFT;
+    UINT64 lastChunk = (UINT64)( startBoundary + memSize - 1 ) >> WRITE_WATCH_CHUNK_SHIFT;
+    UINT64 chunkIndex;
+
+    for ( chunkIndex = firstChunk; chunkIndex <= lastChunk; chunkIndex++ )
+    {
+        UINT_PTR address = (UINT_PTR)( chunkIndex << WRITE_WATCH_CHUNK_SHIFT );
+        if ( VIRTUALGetWriteWatchState( address, TRUE ) == NULL )
+        {
+            return FALSE;
+        }
+    }
+    return TRUE;
+}
+
+/****
+ *
+ * VIRTUALSetWriteWatchState
+ *
+ *  Sets the write watch state of a range of pages. Used when the pages are
+ *  committed, decommitted or have their protection changed. Waits for
+ *  pending resets and fault handlers, so that the protection they are
+ *  applying can't override the one the caller is about to set.
+ *  NOTE: The caller must own the critical section.
+ *
+ */
+static void VIRTUALSetWriteWatchState( UINT_PTR startBoundary, SIZE_T numberOfPages, BYTE newState )
+{
+    SIZE_T index;
+    for ( index = 0; index < numberOfPages; index++ )
+    {
+        BYTE * state = VIRTUALGetWriteWatchState( startBoundary + index * VIRTUAL_PAGE_SIZE, FALSE );
+        _ASSERTE( state != NULL );
+
+        for (;;)
+        {
+            BYTE oldState = *(volatile BYTE *)state;
+            if ( oldState == WRITE_WATCH_UNPROTECTING || oldState == WRITE_WATCH_RESETTING )
+            {
+                /* A fault handler or a reset is changing the protection of this page. */
+                sched_yield();
+                continue;
+            }
+            if ( __sync_bool_compare_and_swap( state, oldState, newState ) )
+            {
+                break;
+            }
+        }
+    }
+}
+
+/****
+ *
+ * VIRTUALInitializeWriteWatchBudget
+ *
+ *  Reads vm.max_map_count, which bounds the number of read-only runs the
+ *  write watch regions can be split into.
+ *
+ */
+static void VIRTUALInitializeWriteWatchBudget()
+{
+    SIZE_T maxMapCount = WRITE_WATCH_DEFAULT_MAX_MAP_COUNT;
+#if defined(__LINUX__)
+    int fd = open( "/proc/sys/vm/max_map_count", O_RDONLY );
+    if ( fd != -1 )
+    {
+        char buf[32];
+        ssize_t numRead = read( fd, buf, sizeof(buf) - 1 );
+        if ( numRead > 0 )
+        {
+            buf[numRead] = '\0';
+            int value = atoi( buf );
+            if ( value > 0 )
+            {
+                maxMapCount = (SIZE_T)value;
+            }
+        }
+        close( fd );
+    }
+#endif
+    g_writeWatchMapBudget = maxMapCount / 4 > 0 ? maxMapCount / 4 : 1;
+}
+
+/****
+ *
+ * VIRTUALGetWriteWatchGranularity
+ *
+ *  Returns the number of pages, a power of two, the fault handler makes
+ *  writable at once. Each such group splits a read-only run in at most
+ *  three, so faults add at most two mappings per group.
+ *
+ */
+static SIZE_T VIRTUALGetWriteWatchGranularity()
+{
+    SIZE_T reservedPages = g_writeWatchReservedPages;
+    SIZE_T granularity = 1;
+    while ( granularity < WRITE_WATCH_MAX_GRANULARITY &&
+            reservedPages / granularity * 2 > g_writeWatchMapBudget )
+    {
+        granularity <<= 1;
+    }
+    return granularity;
+}
+
+/****
+ *
+ * VIRTUALProtectWriteWatchRun
+ *
+ *  Write protects a run of pages that the caller moved to
+ *  WRITE_WATCH_RESETTING and marks them clean. If mprotect fails the pages
+ *  are marked dirty, which reports them (again) on the next call instead
+ *  of losing writes; running out of mappings (ENOMEM) is not an error.
+ *
+ */
+static BOOL VIRTUALProtectWriteWatchRun( UINT_PTR startBoundary, SIZE_T numberOfPages )
+{
+    BOOL bProtected = mprotect( (LPVOID)startBoundary, numberOfPages * VIRTUAL_PAGE_SIZE, PROT_READ ) == 0;
+    BOOL bRetVal = bProtected;
+    if ( !bProtected )
+    {
+        WARN( "mprotect() failed! Error(%d)=%s\n", errno, strerror( errno ) );
+        bRetVal = ( errno == ENOMEM );
+    }
+
+    SIZE_T index;
+    for ( index = 0; index < numberOfPages; index++ )
+    {
+        BYTE * state = VIRTUALGetWriteWatchState( startBoundary + index * VIRTUAL_PAGE_SIZE, FALSE );
+        __sync_val_compare_and_swap( state, WRITE_WATCH_RESETTING,
+                                     bProtected ? WRITE_WATCH_CLEAN : WRITE_WATCH_DIRTY );
+    }
+    return bRetVal;
+}
+
+/****
+ *
+ * VIRTUALGetWriteWatchPages
+ *
+ *  Collects (and optionally resets) the dirty pages of a range. The pages
+ *  a reset is working on are held in WRITE_WATCH_RESETTING, which the
+ *  write fault handler (which can't take the critical section) waits for.
+ *  A reset also holds the clean pages it comes across, so that it can
+ *  protect each run of watched pages with a single mprotect.
+ *
+ *  NOTE: The caller must own the critical section.
+ *
+ *  IN UINT_PTR startBoundary - First page of the range.
+ *  IN SIZE_T numberOfPages - Number of pages in the range.
+ *  IN BOOL reset - Write protect the reported pages again.
+ *  OUT PVOID * lpAddresses - Receives the dirty pages. NULL to visit the
+ *                            whole range without reporting the pages.
+ *  IN SIZE_T maxCount - Capacity of lpAddresses.
+ *
+ *  Returns the number of reported pages, or (SIZE_T)-1 on failure.
+ *
+ */
+static SIZE_T VIRTUALGetWriteWatchPages( UINT_PTR startBoundary, SIZE_T numberOfPages, BOOL reset,
+                                         PVOID * lpAddresses, SIZE_T maxCount )
+{
+    SIZE_T count = 0;
+    SIZE_T runStart = 0;
+    SIZE_T runLength = 0;
+    BOOL success = TRUE;
+    BOOL reportOnly = ( lpAddresses == NULL );
+    SIZE_T index;
+
+    for ( index = 0; index <= numberOfPages; index++ )
+    {
+        BOOL acquired = FALSE;
+        if ( index < numberOfPages && ( reportOnly || count < maxCount ) )
+        {
+            UINT_PTR page = startBoundary + index * VIRTUAL_PAGE_SIZE;
+            BYTE * state = VIRTUALGetWriteWatchState( page, FALSE );
+            BOOL dirty;
+
+            if ( reset && __sync_bool_compare_and_swap( state, WRITE_WATCH_DIRTY, WRITE_WATCH_RESETTING ) )
+            {
+                acquired = TRUE;
+                dirty = TRUE;
+            }
+            else if ( reset && __sync_bool_compare_and_swap( state, WRITE_WATCH_CLEAN, WRITE_WATCH_RESETTING ) )
+            {
+                acquired = TRUE;
+                dirty = FALSE;
+            }
+            else
+            {
+                /* A page that is being unprotected is about to be written. */
+                BYTE currentState = *(volatile BYTE *)state;
+                dirty = ( currentState == WRITE_WATCH_DIRTY || currentState == WRITE_WATCH_UNPROTECTING );
+            }
+
+            if ( dirty && !reportOnly )
+            {
+                lpAddresses[count] = (PVOID)page;
+            }
+            count += dirty ? 1 : 0;
+        }
+        else if ( index < numberOfPages )
+        {
+            /* The output buffer is full; stop after flushing the current run. */
+            numberOfPages = index;
+        }
+
+        if ( acquired )
+        {
+            if ( runLength == 0 )
+            {
+                runStart = index;
+            }
+            runLength++;
+        }
+        else if ( runLength != 0 )
+        {
+            success = VIRTUALProtectWriteWatchRun( startBoundary + runStart * VIRTUAL_PAGE_SIZE, runLength ) && success;
+            runLength = 0;
+        }
+    }
+
+    return success ? count : (SIZE_T)-1;
+}
+
+/****
+ *
+ * VIRTUALUnprotectWriteWatchPages
+ *
+ *  Makes the clean pages of a range writable and marks them dirty. The
+ *  pages of the target subrange are taken even if they are already dirty,
+ *  since a reset that failed may have left them read-only. The pages are
+ *  held in WRITE_WATCH_UNPROTECTING while their protection changes. If
+ *  mprotect fails they are still marked dirty: the kernel may have applied
+ *  part of the change, and a dirty read-only page only costs another fault.
+ *
+ *  Returns the number of target pages that were made writable.
+ *
+ */
+static SIZE_T VIRTUALUnprotectWriteWatchPages( UINT_PTR startBoundary, SIZE_T numberOfPages,
+                                               UINT_PTR targetStart, SIZE_T targetPages )
+{
+    SIZE_T unprotectedCount = 0;
+    SIZE_T runStart = 0;
+    SIZE_T runLength = 0;
+    UINT_PTR targetEnd = targetStart + targetPages * VIRTUAL_PAGE_SIZE;
+    SIZE_T index;
+
+    for ( index = 0; index <= numberOfPages; index++ )
+    {
+        BOOL acquired = FALSE;
+        if ( index < numberOfPages )
+        {
+            UINT_PTR page = startBoundary + index * VIRTUAL_PAGE_SIZE;
+            BYTE * state = VIRTUALGetWriteWatchState( page, FALSE );
+            acquired = __sync_bool_compare_and_swap( state, WRITE_WATCH_CLEAN, WRITE_WATCH_UNPROTECTING ) ||
+                ( page >= targetStart && page < targetEnd &&
+                  __sync_bool_compare_and_swap( state, WRITE_WATCH_DIRTY, WRITE_WATCH_UNPROTECTING ) );
+        }
+
+        if ( acquired )
+        {
+            if ( runLength == 0 )
+            {
+                runStart = index;
+            }
+            runLength++;
+        }
+        else if ( runLength != 0 )
+        {
+            UINT_PTR runBoundary = startBoundary + runStart * VIRTUAL_PAGE_SIZE;
+            BOOL success = mprotect( (LPVOID)runBoundary, runLength * VIRTUAL_PAGE_SIZE, PROT_READ | PROT_WRITE ) == 0;
+
+            SIZE_T runIndex;
+            for ( runIndex = 0; runIndex < runLength; runIndex++ )
+            {
+                UINT_PTR page = runBoundary + runIndex * VIRTUAL_PAGE_SIZE;
+                __sync_val_compare_and_swap( VIRTUALGetWriteWatchState( page, FALSE ),
+                                             WRITE_WATCH_UNPROTECTING, WRITE_WATCH_DIRTY );
+                unprotectedCount += ( success && page >= targetStart && page < targetEnd ) ? 1 : 0;
+            }
+            runLength = 0;
+        }
+    }
+
+    return unprotectedCount;
+}
+
+/****
+ *
+ * VIRTUALGetWriteWatchRun
+ *
+ *  Finds the run of watched pages around a page, within its state map
+ *  chunk.
+ *
+ */
+static void VIRTUALGetWriteWatchRun( UINT_PTR page, UINT_PTR * pRunStart, SIZE_T * pRunPages )
+{
+    UINT_PTR chunkStart = page & ~(UINT_PTR)( ( (UINT64)1 << WRITE_WATCH_CHUNK_SHIFT ) - 1 );
+    UINT_PTR chunkLast = chunkStart + ( WRITE_WATCH_CHUNK_SIZE - 1 ) * VIRTUAL_PAGE_SIZE;
+    UINT_PTR runStart = page;
+    UINT_PTR runLast = page;
+
+    while ( runStart > chunkStart &&
+            *VIRTUALGetWriteWatchState( runStart - VIRTUAL_PAGE_SIZE, FALSE ) != WRITE_WATCH_UNTRACKED )
+    {
+        runStart -= VIRTUAL_PAGE_SIZE;
+    }
+    while ( runLast < chunkLast &&
+            *VIRTUALGetWriteWatchState( runLast + VIRTUAL_PAGE_SIZE, FALSE ) != WRITE_WATCH_UNTRACKED )
+    {
+        runLast += VIRTUAL_PAGE_SIZE;
+    }
+
+    *pRunStart = runStart;
+    *pRunPages = ( runLast - runStart ) / VIRTUAL_PAGE_SIZE + 1;
+}
+
+/*++
+Function :
+    VIRTUALHandleWriteWatchFault
+
+    Called from the SIGSEGV handler. If the fault is the first write to a
+    clean write watch page, marks the page dirty and makes it writable again,
+    along with the clean pages of its group (see VIRTUALGetWriteWatchGranularity).
+
+    Returns TRUE if the faulting instruction should simply be restarted.
+--*/
+extern "C"
+BOOL VIRTUALHandleWriteWatchFault( IN LPVOID address )
+{
+    BYTE * state = VIRTUALGetWriteWatchState( (UINT_PTR)address, FALSE );
+    if ( state == NULL )
+    {
+        return FALSE;
+    }
+
+    UINT_PTR page = (UINT_PTR)address & ~VIRTUAL_PAGE_MASK;
+    switch ( *(volatile BYTE *)state )
+    {
+    case WRITE_WATCH_CLEAN:
+    case WRITE_WATCH_DIRTY:
+        {
+            /* A dirty page faults if another thread is just unprotecting it, or
+               if a failed reset left it read-only; unprotecting it again is harmless. */
+            SIZE_T granularity = VIRTUALGetWriteWatchGranularity();
+            UINT_PTR groupStart = page & ~(UINT_PTR)( granularity * VIRTUAL_PAGE_SIZE - 1 );
+            if ( VIRTUALUnprotectWriteWatchPages( groupStart, granularity, page, 1 ) != 0 )
+            {
+                return TRUE;
+            }
+
+            /* Out of mappings: making the whole run writable merges its mappings. */
+            UINT_PTR runStart;
+            SIZE_T runPages;
+            VIRTUALGetWriteWatchRun( page, &runStart, &runPages );
+            if ( VIRTUALUnprotectWriteWatchPages( runStart, runPages, page, 1 ) != 0 )
+            {
+                return TRUE;
+            }
+
+            /* Another thread may hold the page in a transient state; retry if so. */
+            BYTE currentState = *(volatile BYTE *)state;
+            return currentState == WRITE_WATCH_RESETTING || currentState == WRITE_WATCH_UNPROTECTING;
+        }
+
+    case WRITE_WATCH_RESETTING:
+    case WRITE_WATCH_UNPROTECTING:
+        /* Another thread is changing the protection of the page. Retry
+           the access; it either succeeds or comes back here. */
+        return TRUE;
+
+    default:
+        return FALSE;
+    }
+}
+
+/*++
+Function :
+    VIRTUALUnprotectWriteWatchRange
+
+    Makes the write watch pages of a buffer writable and marks them dirty.
+    The kernel doesn't raise SIGSEGV for a write protected buffer passed to
+    a system call, the call fails with EFAULT instead; callers that write
+    into a buffer from the kernel call this and retry once.
+
+    Returns TRUE if any page of the buffer was made writable.
+--*/
+extern "C"
+BOOL VIRTUALUnprotectWriteWatchRange( IN LPVOID address, IN SIZE_T size )
+{
+    if ( size == 0 )
+    {
+        return FALSE;
+    }
+
+    UINT_PTR startBoundary = (UINT_PTR)address & ~VIRTUAL_PAGE_MASK;
+    UINT_PTR endBoundary = ( (UINT_PTR)address + size + VIRTUAL_PAGE_MASK ) & ~VIRTUAL_PAGE_MASK;
+    SIZE_T unprotectedCount = 0;
+    UINT_PTR page = startBoundary;
+
+    /* Chunk by chunk: the buffer may span state map chunks that don't exist. */
+    while ( page < endBoundary )
+    {
+        UINT64 chunkEnd = ( ( (UINT64)page >> WRITE_WATCH_CHUNK_SHIFT ) + 1 ) << WRITE_WATCH_CHUNK_SHIFT;
+        UINT_PTR runEnd = (UINT64)endBoundary < chunkEnd ? endBoundary : (UINT_PTR)chunkEnd;
+        SIZE_T runPages = ( runEnd - page ) / VIRTUAL_PAGE_SIZE;
+
+        if ( VIRTUALGetWriteWatchState( page, FALSE ) != NULL )
+        {
+            unprotectedCount += VIRTUALUnprotectWriteWatchPages( page, runPages, page, runPages );
+        }
+        page = runEnd;
+    }
+    return unprotectedCount != 0;
+}
+
 
 /****
  *
@@ -938,6 +1499,15 @@ static LPVOID VIRTUALReserveMemory(
         pRetVal = g_executableMemoryAllocator.AllocateMemory(MemSize);
     }
 
+#if VIRTUAL_HUGE_PAGES
+    // Huge pages can only back the parts of the region that cover whole,
+    // aligned huge pages. Start the region on a huge page boundary.
+    if (pRetVal == NULL && ((flAllocationType & MEM_LARGE_PAGES) != 0) && (lpAddress == NULL))
+    {
+        pRetVal = VIRTUALReserveHugePageAlignedMemory(pthrCurrent, MemSize);
+    }
+#endif // VIRTUAL_HUGE_PAGES
+
     if (pRetVal == NULL)
     {
         // Try to reserve memory from the OS
@@ -965,6 +1535,19 @@ static LPVOID VIRTUALReserveMemory(
             munmap( pRetVal, MemSize );
             pRetVal = NULL;
         }
+        else if ( ( flAllocationType & MEM_WRITE_WATCH ) != 0 &&
+                  !VIRTUALInitializeWriteWatchState( StartBoundary, MemSize ) )
+        {
+            ERROR( "Unable to track writes to the region.\n");
+            pthrCurrent->SetLastError( ERROR_NOT_ENOUGH_MEMORY );
+            VIRTUALReleaseMemory( VIRTUALFindRegionInformation( StartBoundary ) );
+            munmap( pRetVal, MemSize );
+            pRetVal = NULL;
+        }
+        else if ( ( flAllocationType & MEM_WRITE_WATCH ) != 0 )
+        {
+            g_writeWatchReservedPages += MemSize / VIRTUAL_PAGE_SIZE;
+        }
     }
 
     InternalLeaveCriticalSection(pthrCurrent, &virtual_critsec);
@@ -1067,6 +1650,48 @@ done:
     return pRetVal;
 }
 
+#if VIRTUAL_HUGE_PAGES
+/******
+ *
+ *  VIRTUALReserveHugePageAlignedMemory() - Helper function that reserves
+ *  virtual memory starting on a huge page boundary.
+ *
+ *  Reserves an extra huge page worth of address space and gives back the
+ *  unaligned head and the unused tail.
+ *
+ */
+static LPVOID VIRTUALReserveHugePageAlignedMemory(
+                IN CPalThread *pthrCurrent, /* Currently executing thread */
+                IN SIZE_T dwSize)           /* Size of Region */
+{
+    SIZE_T PaddedSize = dwSize + VIRTUAL_HUGE_PAGE_SIZE - VIRTUAL_PAGE_SIZE;
+    if (PaddedSize < dwSize)
+    {
+        return NULL;
+    }
+
+    char * pReserved = (char *)ReserveVirtualMemory(pthrCurrent, NULL, PaddedSize);
+    if (pReserved == NULL)
+    {
+        return NULL;
+    }
+
+    char * pAligned = (char *)(((UINT_PTR)pReserved + VIRTUAL_HUGE_PAGE_SIZE - 1) & ~(VIRTUAL_HUGE_PAGE_SIZE - 1));
+    if (pAligned != pReserved)
+    {
+        munmap(pReserved, pAligned - pReserved);
+    }
+
+    SIZE_T TailSize = (pReserved + PaddedSize) - (pAligned + dwSize);
+    if (TailSize != 0)
+    {
+        munmap(pAligned + dwSize, TailSize);
+    }
+
+    return pAligned;
+}
+#endif // VIRTUAL_HUGE_PAGES
+
 /******
  *
  *  VIRTUALCommitMemory() - Helper function that actually commits the memory.
@@ -1180,6 +1805,14 @@ static LPVOID VIRTUALCommitMemory(
         goto error;
     }
 
+    if (VIRTUALIsWriteWatchRegion(pInformation) && vProtect != VIRTUAL_READWRITE)
+    {
+        // Only read-write pages are watched. Stop tracking before the
+        // protection changes so that the fault handler leaves them alone.
+        VIRTUALSetWriteWatchState(pInformation->startBoundary + initialRunStart * VIRTUAL_PAGE_SIZE,
+                                  totalPages, WRITE_WATCH_UNTRACKED);
+    }
+
     while(runStart < initialRunStart + totalPages)
     {
         // Find the next run of pages
@@ -1227,6 +1860,14 @@ static LPVOID VIRTUALCommitMemory(
                     temp += VIRTUAL_PAGE_SIZE;
                 }
 #endif // MMAP_DOESNOT_ALLOW_REMAP
+#if VIRTUAL_HUGE_PAGES
+                if (VIRTUALIsHugePageRegion(pInformation))
+                {
+                    // The new mapping doesn't inherit advice given to the
+                    // reservation. This is only a hint, so failure is fine.
+                    madvise((void *) StartBoundary, MemSize, MADV_HUGEPAGE);
+                }
+#endif // VIRTUAL_HUGE_PAGES
             }
             else
             {
@@ -1270,6 +1911,17 @@ static LPVOID VIRTUALCommitMemory(
     }
     pRetVal = (void *) (pInformation->startBoundary +
                         initialRunStart * VIRTUAL_PAGE_SIZE);
+
+    if (VIRTUALIsWriteWatchRegion(pInformation) && vProtect == VIRTUAL_READWRITE)
+    {
+        // Newly committed pages are reported as written until the next reset.
+        // Pages that were already committed read-write keep their state.
+        for (index = 0; index < totalPages; index++)
+        {
+            BYTE * state = VIRTUALGetWriteWatchState((UINT_PTR)pRetVal + index * VIRTUAL_PAGE_SIZE, FALSE);
+            __sync_bool_compare_and_swap(state, WRITE_WATCH_UNTRACKED, WRITE_WATCH_DIRTY);
+        }
+    }
     goto done;
 
 error:
@@ -1297,6 +1949,97 @@ done:
     return pRetVal;
 }
 
+/******
+ *
+ *  VIRTUALResetMemory() - Helper function for MEM_RESET.
+ *
+ *  Tells the system that the contents of a committed range are no longer
+ *  needed. The range stays committed and its physical pages are released
+ *  with madvise(MADV_DONTNEED). On Linux, private anonymous pages read back
+ *  as zero afterwards; other systems only guarantee that the contents are
+ *  undefined, matching MEM_RESET on Windows.
+ *
+ *  Pages of a write watch region are reported as written after a reset.
+ */
+static LPVOID VIRTUALResetMemory(
+                IN CPalThread *pthrCurrent, /* Currently executing thread */
+                IN LPVOID lpAddress,        /* Region to reset */
+                IN SIZE_T dwSize)           /* Size of Region */
+{
+    UINT_PTR StartBoundary;
+    SIZE_T MemSize;
+    SIZE_T Index;
+    SIZE_T NumberOfPages;
+    PCMI pInformation;
+
+    StartBoundary = (UINT_PTR)lpAddress & ~VIRTUAL_PAGE_MASK;
+    MemSize = ( ((UINT_PTR)lpAddress + dwSize + VIRTUAL_PAGE_MASK) & ~VIRTUAL_PAGE_MASK ) -
+              StartBoundary;
+    NumberOfPages = MemSize / VIRTUAL_PAGE_SIZE;
+
+    pInformation = VIRTUALFindRegionInformation( StartBoundary );
+    if ( !pInformation )
+    {
+        ERROR( "MEM_RESET requires memory reserved with VirtualAlloc.\n" );
+        pthrCurrent->SetLastError( ERROR_INVALID_ADDRESS );
+        return NULL;
+    }
+
+    Index = ( StartBoundary - pInformation->startBoundary ) / VIRTUAL_PAGE_SIZE;
+    if ( NumberOfPages > pInformation->memSize / VIRTUAL_PAGE_SIZE - Index )
+    {
+        ERROR( "Trying to reset beyond the end of the region!\n" );
+        pthrCurrent->SetLastError( ERROR_INVALID_ADDRESS );
+        return NULL;
+    }
+
+    for ( SIZE_T i = Index; i < Index + NumberOfPages; i++ )
+    {
+        if ( !VIRTUALIsPageCommitted( i, pInformation ) )
+        {
+            ERROR( "MEM_RESET can only be applied to committed memory.\n" );
+            pthrCurrent->SetLastError( ERROR_INVALID_ADDRESS );
+            return NULL;
+        }
+
+        if ( VIRTUALIsWriteWatchRegion( pInformation ) &&
+             pInformation->pProtectionState[ i ] != VIRTUAL_READWRITE )
+        {
+            ERROR( "MEM_RESET on a write watch region requires read-write pages.\n" );
+            pthrCurrent->SetLastError( ERROR_INVALID_PARAMETER );
+            return NULL;
+        }
+    }
+
+    if ( VIRTUALIsWriteWatchRegion( pInformation ) )
+    {
+        // Clean pages are write protected. Stop tracking and make them
+        // writable again before their contents go away.
+        VIRTUALSetWriteWatchState( StartBoundary, NumberOfPages, WRITE_WATCH_UNTRACKED );
+        if ( mprotect( (LPVOID)StartBoundary, MemSize, PROT_READ | PROT_WRITE ) != 0 )
+        {
+            ERROR( "mprotect() failed! Error(%d)=%s\n", errno, strerror( errno ) );
+            VIRTUALSetWriteWatchState( StartBoundary, NumberOfPages, WRITE_WATCH_DIRTY );
+            pthrCurrent->SetLastError( ERROR_INVALID_ADDRESS );
+            return NULL;
+        }
+    }
+
+    BOOL success = ( madvise( (LPVOID)StartBoundary, MemSize, MADV_DONTNEED ) == 0 );
+    if ( !success )
+    {
+        ERROR( "madvise() failed! Error(%d)=%s\n", errno, strerror( errno ) );
+        pthrCurrent->SetLastError( ERROR_INVALID_ADDRESS );
+    }
+
+    if ( VIRTUALIsWriteWatchRegion( pInformation ) )
+    {
+        VIRTUALSetWriteWatchState( StartBoundary, NumberOfPages, WRITE_WATCH_DIRTY );
+    }
+
+    return success ? (LPVOID)StartBoundary : NULL;
+}
+
 #if MMAP_IGNORES_HINT
 /*++
 Function:
@@ -1627,7 +2370,12 @@ Function:
   VirtualAlloc
 
 Note:
-  MEM_TOP_DOWN, MEM_PHYSICAL, MEM_WRITE_WATCH are not supported.
+  MEM_TOP_DOWN, MEM_PHYSICAL are not supported. MEM_WRITE_WATCH is
+  emulated by write protecting clean pages, see VIRTUALHandleWriteWatchFault.
+  MEM_RESET releases the physical pages with madvise, see VIRTUALResetMemory.
+  MEM_LARGE_PAGES asks for transparent huge pages and needs no privilege;
+  the region is reserved on a huge page boundary and its committed runs
+  are advised with MADV_HUGEPAGE.
   Unsupported flags are ignored.
 
   Page size on i386 is set to 4k.
@@ -1651,17 +2399,33 @@ VirtualAlloc(
 
     pthrCurrent = InternalGetCurrentThread();
 
-    if ( ( flAllocationType & MEM_WRITE_WATCH )  != 0 )
+    if ( flAllocationType & MEM_RESET )
     {
+        if ( flAllocationType != MEM_RESET )
+        {
+            ERROR( "MEM_RESET cannot be combined with other allocation flags.\n" );
+            pthrCurrent->SetLastError( ERROR_INVALID_PARAMETER );
+            goto done;
+        }
+
+        InternalEnterCriticalSection(pthrCurrent, &virtual_critsec);
+        pRetVal = VIRTUALResetMemory( pthrCurrent, lpAddress, dwSize );
+        InternalLeaveCriticalSection(pthrCurrent, &virtual_critsec);
+        goto done;
+    }
+
+    if ( ( flAllocationType & MEM_WRITE_WATCH ) != 0 && ( flAllocationType & MEM_RESERVE ) == 0 )
+    {
+        ERROR( "MEM_WRITE_WATCH must be specified with MEM_RESERVE.\n" );
         pthrCurrent->SetLastError( ERROR_INVALID_PARAMETER );
         goto done;
     }
 
     /* Test for un-supported flags. */
-    if ( ( flAllocationType & ~( MEM_COMMIT | MEM_RESERVE | MEM_TOP_DOWN | MEM_RESERVE_EXECUTABLE ) ) != 0 )
+    if ( ( flAllocationType & ~( MEM_COMMIT | MEM_RESERVE | MEM_TOP_DOWN | MEM_RESERVE_EXECUTABLE | MEM_WRITE_WATCH | MEM_LARGE_PAGES ) ) != 0 )
     {
         ASSERT( "flAllocationType can be one, or any combination of MEM_COMMIT, \
-               MEM_RESERVE, MEM_TOP_DOWN, or MEM_RESERVE_EXECUTABLE.\n" );
+               MEM_RESERVE, MEM_TOP_DOWN, MEM_RESERVE_EXECUTABLE, MEM_WRITE_WATCH or MEM_LARGE_PAGES.\n" );
         pthrCurrent->SetLastError( ERROR_INVALID_PARAMETER );
         goto done;
     }
@@ -1818,6 +2582,11 @@ VirtualFree(
         TRACE( "Un-committing the following page(s) %d to %d.\n",
                StartBoundary, MemSize );
 
+        if ( VIRTUALIsWriteWatchRegion( pUnCommittedMem ) )
+        {
+            VIRTUALSetWriteWatchState( StartBoundary, MemSize / VIRTUAL_PAGE_SIZE, WRITE_WATCH_UNTRACKED );
+        }
+
 #if MMAP_DOESNOT_ALLOW_REMAP
         // if no double mapping is supported,
         // just mprotect the memory with no access
@@ -1896,6 +2665,14 @@ VirtualFree(
         TRACE( "Releasing the following memory %d to %d.\n",
                pMemoryToBeReleased->startBoundary, pMemoryToBeReleased->memSize );
 
+        if ( VIRTUALIsWriteWatchRegion( pMemoryToBeReleased ) )
+        {
+            VIRTUALSetWriteWatchState( pMemoryToBeReleased->startBoundary,
+                                       pMemoryToBeReleased->memSize / VIRTUAL_PAGE_SIZE,
+                                       WRITE_WATCH_UNTRACKED );
+            g_writeWatchReservedPages -= pMemoryToBeReleased->memSize / VIRTUAL_PAGE_SIZE;
+        }
+
 #if (MMAP_IGNORES_HINT && !MMAP_DOESNOT_ALLOW_REMAP)
         if (mmap((void *) pMemoryToBeReleased->startBoundary,
                  pMemoryToBeReleased->memSize, PROT_NONE,
@@ -2024,9 +2801,21 @@ VirtualProtect(
         }
     }
 
+    if ( VIRTUALIsWriteWatchRegion( pEntry ) )
+    {
+        /* Pages are watched again once they are made read-write. */
+        VIRTUALSetWriteWatchState( StartBoundary, MemSize / VIRTUAL_PAGE_SIZE, WRITE_WATCH_UNTRACKED );
+    }
+
     if ( 0 == mprotect( (LPVOID)StartBoundary, MemSize,
                    W32toUnixAccessControl( flNewProtect ) ) )
     {
+        if ( VIRTUALIsWriteWatchRegion( pEntry ) &&
+             VIRTUALConvertWinFlags( flNewProtect ) == VIRTUAL_READWRITE )
+        {
+            VIRTUALSetWriteWatchState( StartBoundary, MemSize / VIRTUAL_PAGE_SIZE, WRITE_WATCH_DIRTY );
+        }
+
         /* Reset the access protection. */
         TRACE( "Number of pages to change %d, starting page %d \n",
                NumberOfPagesToChange, OffSet );
@@ -2374,11 +3163,64 @@ GetWriteWatch(
   OUT PULONG lpdwGranularity
 )
 {
-    // TODO: implement this method
-    *lpAddresses = NULL;
-    *lpdwCount = 0;
-    // Until it is implemented, return non-zero value as an indicator of failure
-    return 1;
+    UINT uRetVal = (UINT)-1;
+    UINT_PTR StartBoundary;
+    SIZE_T MemSize;
+    SIZE_T count;
+    PCMI pInformation;
+    CPalThread * pthrCurrent;
+
+    PERF_ENTRY(GetWriteWatch);
+    ENTRY("GetWriteWatch(dwFlags=%#x, lpBaseAddress=%p, dwRegionSize=%u, "
+          "lpAddresses=%p, lpdwCount=%p, lpdwGranularity=%p)\n",
+          dwFlags, lpBaseAddress, dwRegionSize, lpAddresses, lpdwCount, lpdwGranularity);
+
+    pthrCurrent = InternalGetCurrentThread();
+
+    if ( ( dwFlags & ~WRITE_WATCH_FLAG_RESET ) != 0 || lpdwCount == NULL ||
+         lpdwGranularity == NULL || ( lpAddresses == NULL && *lpdwCount != 0 ) )
+    {
+        ERROR( "Invalid parameter.\n" );
+        pthrCurrent->SetLastError( ERROR_INVALID_PARAMETER );
+        goto done;
+    }
+
+    StartBoundary = (UINT_PTR)lpBaseAddress & ~VIRTUAL_PAGE_MASK;
+    MemSize = ( ((UINT_PTR)lpBaseAddress + dwRegionSize + VIRTUAL_PAGE_MASK) & ~VIRTUAL_PAGE_MASK ) -
+              StartBoundary;
+
+    InternalEnterCriticalSection(pthrCurrent, &virtual_critsec);
+
+    pInformation = VIRTUALFindRegionInformation( StartBoundary );
+    if ( !VIRTUALIsWriteWatchRegion( pInformation ) ||
+         StartBoundary + MemSize > pInformation->startBoundary + pInformation->memSize )
+    {
+        ERROR( "The range is not part of a write watch region.\n" );
+        pthrCurrent->SetLastError( ERROR_INVALID_PARAMETER );
+    }
+    else
+    {
+        count = VIRTUALGetWriteWatchPages( StartBoundary, MemSize / VIRTUAL_PAGE_SIZE,
+                                           ( dwFlags & WRITE_WATCH_FLAG_RESET ) != 0,
+                                           lpAddresses, *lpdwCount );
+        if ( count != (SIZE_T)-1 )
+        {
+            *lpdwCount = count;
+            *lpdwGranularity = VIRTUAL_PAGE_SIZE;
+            uRetVal = 0;
+        }
+        else
+        {
+            pthrCurrent->SetLastError( ERROR_INTERNAL_ERROR );
+        }
+    }
+
+    InternalLeaveCriticalSection(pthrCurrent, &virtual_critsec);
+
+done:
+    LOGEXIT("GetWriteWatch returning %u\n", uRetVal);
+    PERF_EXIT(GetWriteWatch);
+    return uRetVal;
 }
 
 /*++
@@ -2394,9 +3236,45 @@ ResetWriteWatch(
   IN SIZE_T dwRegionSize
 )
 {
-    // TODO: implement this method
-    // Until it is implemented, return non-zero value as an indicator of failure
-    return 1;
+    UINT uRetVal = (UINT)-1;
+    UINT_PTR StartBoundary;
+    SIZE_T MemSize;
+    PCMI pInformation;
+    CPalThread * pthrCurrent;
+
+    PERF_ENTRY(ResetWriteWatch);
+    ENTRY("ResetWriteWatch(lpBaseAddress=%p, dwRegionSize=%u)\n",
+          lpBaseAddress, dwRegionSize);
+
+    pthrCurrent = InternalGetCurrentThread();
+
+    StartBoundary = (UINT_PTR)lpBaseAddress & ~VIRTUAL_PAGE_MASK;
+    MemSize = ( ((UINT_PTR)lpBaseAddress + dwRegionSize + VIRTUAL_PAGE_MASK) & ~VIRTUAL_PAGE_MASK ) -
+              StartBoundary;
+
+    InternalEnterCriticalSection(pthrCurrent, &virtual_critsec);
+
+    pInformation = VIRTUALFindRegionInformation( StartBoundary );
+    if ( !VIRTUALIsWriteWatchRegion( pInformation ) ||
+         StartBoundary + MemSize > pInformation->startBoundary + pInformation->memSize )
+    {
+        ERROR( "The range is not part of a write watch region.\n" );
+        pthrCurrent->SetLastError( ERROR_INVALID_PARAMETER );
+    }
+    else if ( VIRTUALGetWriteWatchPages( StartBoundary, MemSize / VIRTUAL_PAGE_SIZE, TRUE, NULL, 0 ) != (SIZE_T)-1 )
+    {
+        uRetVal = 0;
+    }
+    else
+    {
+        pthrCurrent->SetLastError( ERROR_INTERNAL_ERROR );
+    }
+
+    InternalLeaveCriticalSection(pthrCurrent, &virtual_critsec);
+
+    LOGEXIT("ResetWriteWatch returning %u\n", uRetVal);
+    PERF_EXIT(ResetWriteWatch);
+    return uRetVal;
 }
 
 /*++
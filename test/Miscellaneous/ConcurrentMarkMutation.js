@@ -0,0 +1,46 @@
+//-------------------------------------------------------------------------------------------------------
+// Copyright (C) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE.txt file in the project root for full license information.
+//-------------------------------------------------------------------------------------------------------
+
+// Mutates an object graph while the recycler marks it concurrently. Pages written
+// during the background mark must be found by write watch and rescanned, otherwise
+// the nodes that are only reachable through the new edges would be collected.
+
+function Node(id)
+{
+    this.id = id;
+    this.next = null;
+    this.payload = [id, id + 1, id + 2];
+}
+
+var nodeCount = 20000;
+var nodes = [];
+for (var i = 0; i < nodeCount; i++)
+{
+    nodes.push(new Node(i));
+}
+
+for (var round = 0; round < 20; round++)
+{
+    // Rewire every node to a freshly allocated successor and drop the old one.
+    for (var i = 0; i < nodeCount; i++)
+    {
+        var replacement = new Node(i);
+        nodes[i].next = replacement;
+        nodes[i] = new Node(i);
+        nodes[i].next = replacement;
+    }
+}
+
+for (var i = 0; i < nodeCount; i++)
+{
+    var node = nodes[i];
+    if (node.id !== i || node.next.id !== i || node.next.payload[2] !== i + 2)
+    {
+        WScript.Echo("FAIL: node " + i);
+        break;
+    }
+}
+
+WScript.Echo("pass");
@@ -0,0 +1,47 @@
+//-------------------------------------------------------------------------------------------------------
+// Copyright (C) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE.txt file in the project root for full license information.
+//-------------------------------------------------------------------------------------------------------
+
+var INT32_MIN = -2147483648;
+
+// Trip counts that aren't a multiple of the unroll factor leave iterations to the remainder loop
+function sumTo(n) {
+    var sum = 0;
+    for (var i = 0; i < n; i++) {
+        sum = (sum + i) | 0;
+    }
+    return sum;
+}
+
+// bound - (factor - 1) would be below INT32_MIN for the smallest bounds, those skip the unrolled loop
+function countFromMin(n) {
+    var count = 0;
+    for (var i = -2147483648; i < n; i++) {
+        count = (count + 1) | 0;
+    }
+    return count;
+}
+
+// A constant bound this close to INT32_MIN is never unrolled
+function countFromMinToConstant() {
+    var count = 0;
+    for (var i = -2147483648; i < -2147483646; i++) {
+        count = (count + 1) | 0;
+    }
+    return count;
+}
+
+// The first call is interpreted
+var tripCounts = [20, 23, 21, 22, 3, 1, 0, -5];
+for (var j = 0; j < tripCounts.length; j++) {
+    WScript.Echo("sumTo(" + tripCounts[j] + "): " + sumTo(tripCounts[j]));
+}
+
+var bounds = [INT32_MIN + 20, INT32_MIN + 10, INT32_MIN + 3, INT32_MIN + 2, INT32_MIN + 1, INT32_MIN];
+for (var j = 0; j < bounds.length; j++) {
+    WScript.Echo("countFromMin(INT32_MIN + " + (bounds[j] - INT32_MIN) + "): " + countFromMin(bounds[j]));
+}
+
+WScript.Echo("countFromMinToConstant: " + countFromMinToConstant());
+WScript.Echo("countFromMinToConstant: " + countFromMinToConstant());
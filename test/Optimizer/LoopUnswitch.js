@@ -0,0 +1,60 @@
+//-------------------------------------------------------------------------------------------------------
+// Copyright (C) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE.txt file in the project root for full license information.
+//-------------------------------------------------------------------------------------------------------
+
+var a = [];
+for (var i = 0; i < 20; i++) {
+    a.push(i * 3 - 10);
+}
+
+// Unswitched on the BrTrue_A of the invariant flag
+function unswitchOnBrTrue(a, negate) {
+    var sum = 0;
+    for (var i = 0; i < a.length; i++) {
+        if (negate) {
+            sum -= a[i];
+        } else {
+            sum += a[i];
+        }
+    }
+    return sum;
+}
+
+// Unswitched on the strict equality of the invariant mode and a constant
+function unswitchOnStrictEquality(a, mode) {
+    var sum = 0;
+    for (var i = 0; i < a.length; i++) {
+        if (mode === "double") {
+            sum += a[i] * 2;
+        } else {
+            sum += a[i];
+        }
+    }
+    return sum;
+}
+
+// The condition changes with each iteration, the loop stays as is
+function notUnswitched(a, n) {
+    var sum = 0;
+    for (var i = 0; i < a.length; i++) {
+        if (i === n) {
+            sum += a[i] * 100;
+        } else {
+            sum += a[i];
+        }
+    }
+    return sum;
+}
+
+// The first call is interpreted, the others run the unswitched loops down both paths
+WScript.Echo("unswitchOnBrTrue: " + unswitchOnBrTrue(a, false));
+WScript.Echo("unswitchOnBrTrue: " + unswitchOnBrTrue(a, true));
+WScript.Echo("unswitchOnBrTrue: " + unswitchOnBrTrue(a, false));
+
+WScript.Echo("unswitchOnStrictEquality: " + unswitchOnStrictEquality(a, "double"));
+WScript.Echo("unswitchOnStrictEquality: " + unswitchOnStrictEquality(a, "single"));
+WScript.Echo("unswitchOnStrictEquality: " + unswitchOnStrictEquality(a, "double"));
+
+WScript.Echo("notUnswitched: " + notUnswitched(a, 5));
+WScript.Echo("notUnswitched: " + notUnswitched(a, 7));
@@ -0,0 +1,38 @@
+//-------------------------------------------------------------------------------------------------------
+// Copyright (C) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE.txt file in the project root for full license information.
+//-------------------------------------------------------------------------------------------------------
+
+// The object doesn't escape and isn't needed by any bailout, so its fields become locals
+function replaced(a, b) {
+    var o = { x: a, y: b };
+    return o.x + o.y;
+}
+
+// The object is live at the bailout of the int add, so it has to stay materialized for the interpreter
+function materializedAtBailout(a, b) {
+    var o = { x: a, y: b };
+    var sum = a + b;
+    return o.x + ":" + o.y + ":" + sum;
+}
+
+// The field loads in the loop are copy propagated and leave a type check on the object behind. The check
+// can't fail, the type comes from the allocation, so it goes away with the object.
+function replacedInLoop(n) {
+    var sum = 0;
+    for (var i = 0; i < n; i++) {
+        var p = { x: i, y: 1 };
+        sum += p.x + p.y;
+    }
+    return sum;
+}
+
+WScript.Echo("replaced: " + replaced(1, 2));
+WScript.Echo("replaced: " + replaced(3, 4));
+
+WScript.Echo("materializedAtBailout: " + materializedAtBailout(1, 2));
+WScript.Echo("materializedAtBailout: " + materializedAtBailout(3, 4));
+WScript.Echo("materializedAtBailout: " + materializedAtBailout("a", 4));
+
+WScript.Echo("replacedInLoop: " + replacedInLoop(5));
+WScript.Echo("replacedInLoop: " + replacedInLoop(10));
@@ -0,0 +1,78 @@
+//-------------------------------------------------------------------------------------------------------
+// Copyright (C) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE.txt file in the project root for full license information.
+//-------------------------------------------------------------------------------------------------------
+
+// 19 elements: four (or eight) wide bodies plus a scalar epilogue
+var n = 19;
+
+function addFloat32(dst, a, b, n) {
+    for (var i = 0; i < n; i++) {
+        dst[i] = a[i] + b[i];
+    }
+}
+
+// 0.1 isn't exact in single precision, each element is rounded from the double result
+function subFloat32Constant(dst, a, n) {
+    for (var i = 0; i < n; i++) {
+        dst[i] = a[i] - 0.1;
+    }
+}
+
+function addInt32(dst, a, b, n) {
+    for (var i = 0; i < n; i++) {
+        dst[i] = a[i] + b[i];
+    }
+}
+
+function subInt32(dst, a, b, n) {
+    for (var i = 0; i < n; i++) {
+        dst[i] = a[i] - b[i];
+    }
+}
+
+function fill(array, value) {
+    for (var i = 0; i < array.length; i++) {
+        array[i] = value(i);
+    }
+    return array;
+}
+
+function echo(name, array) {
+    WScript.Echo(name + ": " + Array.prototype.join.call(array, ","));
+}
+
+var floatA = fill(new Float32Array(n), function (i) { return i + 0.5; });
+var floatB = fill(new Float32Array(n), function (i) { return i * 0.25; });
+var intA = fill(new Int32Array(n), function (i) { return i * 3 - 7; });
+var intB = fill(new Int32Array(n), function (i) { return 100 - i * i; });
+
+// The first call is interpreted and profiles the loop, the second one runs the memvector
+for (var iteration = 0; iteration < 2; iteration++) {
+    var dst = new Float32Array(n);
+    addFloat32(dst, floatA, floatB, n);
+    echo("addFloat32", dst);
+
+    dst = new Float32Array(n);
+    subFloat32Constant(dst, floatA, n);
+    echo("subFloat32Constant", dst);
+
+    dst = new Int32Array(n);
+    addInt32(dst, intA, intB, n);
+    echo("addInt32", dst);
+
+    dst = new Int32Array(n);
+    subInt32(dst, intA, intB, n);
+    echo("subInt32", dst);
+}
+
+// The destination overlaps the source one element further: the runtime rejects it and the loop bails out to the
+// interpreter, which reads the elements it already wrote
+var buffer = fill(new Float32Array(n + 2), function (i) { return i; });
+addFloat32(buffer.subarray(1, n + 1), buffer.subarray(0, n), fill(new Float32Array(n), function () { return 2; }), n);
+echo("addFloat32 overlapping", buffer);
+
+// The same array as destination and source is fine, every element is read before it is written
+var inPlace = fill(new Int32Array(n), function (i) { return i; });
+addInt32(inPlace, inPlace, intB, n);
+echo("addInt32 in place", inPlace);
@@ -0,0 +1,81 @@
+//-------------------------------------------------------------------------------------------------------
+// Copyright (C) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE.txt file in the project root for full license information.
+//-------------------------------------------------------------------------------------------------------
+
+// Run with the default instruction set and with -Sse:4, which turns off the VEX encodings and the AVX2
+// kernels. Both runs have the same baseline.
+
+function mulFloat32(dst, a, b, n) {
+    for (var i = 0; i < n; i++) {
+        dst[i] = a[i] * b[i];
+    }
+}
+
+function divFloat32(dst, a, b, n) {
+    for (var i = 0; i < n; i++) {
+        dst[i] = a[i] / b[i];
+    }
+}
+
+function addInt32(dst, a, b, n) {
+    for (var i = 0; i < n; i++) {
+        dst[i] = a[i] + b[i];
+    }
+}
+
+function subInt32Constant(dst, a, n) {
+    for (var i = 0; i < n; i++) {
+        dst[i] = a[i] - 1000;
+    }
+}
+
+// Float specialized scalar arithmetic, with a destination other than its first source
+function mix(a, n) {
+    var sum = 0;
+    for (var i = 0; i < n; i++) {
+        var x = a[i];
+        var y = x + 0.75;
+        sum += x * y + x / y - (y - x);
+    }
+    return sum;
+}
+
+function fill(array, value) {
+    for (var i = 0; i < array.length; i++) {
+        array[i] = value(i);
+    }
+    return array;
+}
+
+function echo(name, array) {
+    WScript.Echo(name + ": " + Array.prototype.join.call(array, ","));
+}
+
+// Eight wide bodies, four wide bodies and scalar epilogues
+var lengths = [3, 8, 15, 31];
+for (var j = 0; j < lengths.length; j++) {
+    var n = lengths[j];
+    var floatA = fill(new Float32Array(n), function (i) { return (i + 1) * 1.5; });
+    var floatB = fill(new Float32Array(n), function (i) { return i % 5 + 0.25; });
+    var intA = fill(new Int32Array(n), function (i) { return i * 12345 - 50000; });
+    var intB = fill(new Int32Array(n), function (i) { return 7 - i * i; });
+
+    var dst = new Float32Array(n);
+    mulFloat32(dst, floatA, floatB, n);
+    echo("mulFloat32(" + n + ")", dst);
+
+    dst = new Float32Array(n);
+    divFloat32(dst, floatA, floatB, n);
+    echo("divFloat32(" + n + ")", dst);
+
+    dst = new Int32Array(n);
+    addInt32(dst, intA, intB, n);
+    echo("addInt32(" + n + ")", dst);
+
+    dst = new Int32Array(n);
+    subInt32Constant(dst, intA, n);
+    echo("subInt32Constant(" + n + ")", dst);
+
+    WScript.Echo("mix(" + n + "): " + mix(floatB, n));
+}